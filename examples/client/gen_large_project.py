@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Generates large client project to measure project load time and memory per data view item.
+
+Usage: gen_large_project.py [items] [file]   (default: 100000 items, 'large_project.mbc')
+
+Items are spread over 10 devices and data views of 10000 items each with different
+memory types, formats and periods. Open the project with ModbusClient: the builder logs
+'Project ... loaded in N ms (parse P ms, build B ms)'. Save it with binary project suffix
+and open it again to compare XML and binary load. Memory per item is the difference of
+the process resident size with the project loaded and with an empty project divided by
+the item count.
+"""
+import sys
+
+DEVICES = 10
+ITEMS_PER_VIEW = 10000
+FORMATS = ['Dec16', 'UDec16', 'Hex16', 'Float', 'Dec32', 'UDec32', 'Bin16', 'Double']
+MEMORY = [(0, 1), (100000, 1), (300000, 4), (400000, 4)]  # (address base, step)
+PERIODS = [100, 500, 1000, 5000]
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    name = sys.argv[2] if len(sys.argv) > 2 else 'large_project.mbc'
+    out = []
+    w = out.append
+    w('<?xml version="1.0" encoding="UTF-8"?>\n')
+    w('<project version="0.5.0" editnum="1">\n')
+    w('    <name>Large Project</name>\n')
+    w('    <comment>Generated by gen_large_project.py (%d items)</comment>\n' % count)
+    w('    <ports>\n')
+    w('        <port>\n')
+    w('            <name>Port</name>\n')
+    w('            <type>TCP</type>\n')
+    w('            <host>localhost</host>\n')
+    w('            <port>502</port>\n')
+    w('            <timeout>3000</timeout>\n')
+    w('        </port>\n')
+    w('    </ports>\n')
+    w('    <devices>\n')
+    for d in range(DEVICES):
+        w('        <device>\n')
+        w('            <name>Device%d</name>\n' % d)
+        w('            <portName>Port</portName>\n')
+        w('            <unit>%d</unit>\n' % (d + 1))
+        w('        </device>\n')
+    w('    </devices>\n')
+    w('    <dataviews>\n')
+    i = 0
+    view = 0
+    while i < count:
+        w('        <dataview name="dataView%d" period="1000">\n' % view)
+        for _ in range(min(ITEMS_PER_VIEW, count - i)):
+            base, size = MEMORY[i % len(MEMORY)]
+            fmt = FORMATS[i % len(FORMATS)]
+            w('            <item>\n')
+            w('                <device>Device%d</device>\n' % (i % DEVICES))
+            w('                <address>%d</address>\n' % (base + 1 + ((i // len(MEMORY)) * size) % 60000))
+            w('                <format>%s</format>\n' % (fmt if base >= 300000 else 'Bool'))
+            w('                <period>%d</period>\n' % PERIODS[i % len(PERIODS)])
+            w('                <comment>Item %d</comment>\n' % i)
+            w('                <value>0</value>\n')
+            w('            </item>\n')
+            i += 1
+        w('        </dataview>\n')
+        view += 1
+    w('    </dataviews>\n')
+    w('</project>\n')
+    with open(name, 'w', encoding='utf-8') as f:
+        f.write(''.join(out))
+
+
+if __name__ == '__main__':
+    main()
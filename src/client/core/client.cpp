@@ -41,7 +41,14 @@
 mbClient::Strings::Strings() :
     settings_application(QStringLiteral("mbclient")),
     default_client(settings_application),
-    GUID(QStringLiteral("e9da9345-c8b1-47d0-acbd-0a3401fef700")) // generated by https://www.guidgenerator.com/online-guid-generator.aspx
+    GUID(QStringLiteral("e9da9345-c8b1-47d0-acbd-0a3401fef700")), // generated by https://www.guidgenerator.com/online-guid-generator.aspx
+    settings_dataLogFile              (QStringLiteral("DataLog.File")),
+    settings_dataLogMaxFileSize       (QStringLiteral("DataLog.MaxFileSize")),
+    settings_dataLogRotatePeriod      (QStringLiteral("DataLog.RotatePeriod")),
+    settings_runtimeWorkerThreads     (QStringLiteral("Runtime.WorkerThreads")),
+    settings_runtimeBusLoadTarget     (QStringLiteral("Runtime.BusLoadTarget")),
+    settings_runtimeAdaptiveTimeout   (QStringLiteral("Runtime.AdaptiveTimeout")),
+    settings_runtimeAdaptiveTimeoutMin(QStringLiteral("Runtime.AdaptiveTimeoutMin"))
 {
 }
 
@@ -51,16 +58,89 @@ const mbClient::Strings &mbClient::Strings::instance()
     return s;
 }
 
+mbClient::Defaults::Defaults() :
+    settings_dataLogFile              (QString()),
+    settings_dataLogMaxFileSize       (64),
+    settings_dataLogRotatePeriod      (1440),
+    settings_runtimeWorkerThreads     (0),
+    settings_runtimeBusLoadTarget     (80),
+    settings_runtimeAdaptiveTimeout   (false),
+    settings_runtimeAdaptiveTimeoutMin(10)
+{
+}
+
+const mbClient::Defaults &mbClient::Defaults::instance()
+{
+    static const Defaults d;
+    return d;
+}
+
 
 mbClient::mbClient() :
     mbCore (Strings::instance().settings_application)
 {
+    const Defaults &d = Defaults::instance();
+    m_dataLogFile               = d.settings_dataLogFile              ;
+    m_dataLogMaxFileSize        = d.settings_dataLogMaxFileSize       ;
+    m_dataLogRotatePeriod       = d.settings_dataLogRotatePeriod      ;
+    m_runtimeWorkerThreads      = d.settings_runtimeWorkerThreads     ;
+    m_runtimeBusLoadTarget      = d.settings_runtimeBusLoadTarget     ;
+    m_runtimeAdaptiveTimeout    = d.settings_runtimeAdaptiveTimeout   ;
+    m_runtimeAdaptiveTimeoutMin = d.settings_runtimeAdaptiveTimeoutMin;
 }
 
 mbClient::~mbClient()
 {
 }
 
+MBSETTINGS mbClient::cachedSettings() const
+{
+    const Strings &s = Strings::instance();
+    MBSETTINGS r = mbCore::cachedSettings();
+    r[s.settings_dataLogFile              ] = m_dataLogFile               ;
+    r[s.settings_dataLogMaxFileSize       ] = dataLogMaxFileSize       ();
+    r[s.settings_dataLogRotatePeriod      ] = dataLogRotatePeriod      ();
+    r[s.settings_runtimeWorkerThreads     ] = runtimeWorkerThreads     ();
+    r[s.settings_runtimeBusLoadTarget     ] = runtimeBusLoadTarget     ();
+    r[s.settings_runtimeAdaptiveTimeout   ] = runtimeAdaptiveTimeout   ();
+    r[s.settings_runtimeAdaptiveTimeoutMin] = runtimeAdaptiveTimeoutMin();
+    return r;
+}
+
+void mbClient::setCachedSettings(const MBSETTINGS &settings)
+{
+    const Strings &s = Strings::instance();
+    mbCore::setCachedSettings(settings);
+
+    MBSETTINGS::const_iterator it;
+    MBSETTINGS::const_iterator end = settings.end();
+
+    it = settings.find(s.settings_dataLogFile              ); if (it != end) setDataLogFile              (it.value().toString());
+    it = settings.find(s.settings_dataLogMaxFileSize       ); if (it != end) setDataLogMaxFileSize       (it.value().toInt   ());
+    it = settings.find(s.settings_dataLogRotatePeriod      ); if (it != end) setDataLogRotatePeriod      (it.value().toInt   ());
+    it = settings.find(s.settings_runtimeWorkerThreads     ); if (it != end) setRuntimeWorkerThreads     (it.value().toInt   ());
+    it = settings.find(s.settings_runtimeBusLoadTarget     ); if (it != end) setRuntimeBusLoadTarget     (it.value().toInt   ());
+    it = settings.find(s.settings_runtimeAdaptiveTimeout   ); if (it != end) setRuntimeAdaptiveTimeout   (it.value().toBool  ());
+    it = settings.find(s.settings_runtimeAdaptiveTimeoutMin); if (it != end) setRuntimeAdaptiveTimeoutMin(it.value().toInt   ());
+}
+
+QString mbClient::dataLogFile() const
+{
+    // Note: '-datalog' command line argument has priority over cached settings
+    return m_args.value(Arg_DataLog, m_dataLogFile).toString();
+}
+
+int mbClient::parseArg(int argc, char **argv, int &arg)
+{
+    if (!qstrcmp(argv[arg], "-datalog"))
+    {
+        if (++arg < argc)
+            m_args[Arg_DataLog] = QString(argv[arg]);
+        return 0;
+    }
+    return mbCore::parseArg(argc, argv, arg);
+}
+
 int mbClient::columnTypeByName(const QString &name) const
 {
     int res = mbCore::columnTypeByName(name);
@@ -96,6 +176,11 @@ void mbClient::updateItem(mb::Client::ItemHandle_t handle, const QByteArray &dat
     runtime()->updateItem(handle, data, status, timestamp);
 }
 
+void mbClient::updatePollTiming(const QVector<mb::Client::ItemHandle_t> &handles, uint32_t achievedPeriod, uint32_t lateness, uint32_t skippedCycles)
+{
+    runtime()->updatePollTiming(handles, achievedPeriod, lateness, skippedCycles);
+}
+
 void mbClient::writeItemData(mb::Client::ItemHandle_t handle, const QByteArray &data)
 {
     runtime()->writeItemData(handle, data);
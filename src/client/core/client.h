@@ -26,6 +26,7 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#include <QVector>
 
 #include <core.h>
 #include <client_global.h>
@@ -47,10 +48,36 @@ public:
         const QString settings_application;
         const QString default_client;
         const QString GUID;
+
+        const QString settings_dataLogFile              ;
+        const QString settings_dataLogMaxFileSize       ;
+        const QString settings_dataLogRotatePeriod      ;
+        const QString settings_runtimeWorkerThreads     ;
+        const QString settings_runtimeBusLoadTarget     ;
+        const QString settings_runtimeAdaptiveTimeout   ;
+        const QString settings_runtimeAdaptiveTimeoutMin;
         Strings();
         static const Strings &instance();
     };
 
+    struct Defaults
+    {
+        const QString settings_dataLogFile              ;
+        const int     settings_dataLogMaxFileSize       ;
+        const int     settings_dataLogRotatePeriod      ;
+        const int     settings_runtimeWorkerThreads     ;
+        const int     settings_runtimeBusLoadTarget     ;
+        const bool    settings_runtimeAdaptiveTimeout   ;
+        const int     settings_runtimeAdaptiveTimeoutMin;
+        Defaults();
+        static const Defaults &instance();
+    };
+
+    enum ClientArgs
+    {
+        Arg_DataLog = ArgCount
+    };
+
 public:
     static inline mbClient* global() { return static_cast<mbClient*>(globalCore()); }
 
@@ -58,6 +85,10 @@ public:
     mbClient();
     ~mbClient();
 
+public:
+    MBSETTINGS cachedSettings() const override;
+    void setCachedSettings(const MBSETTINGS &settings) override;
+
 public:
     inline mbClientUi* ui() const { return reinterpret_cast<mbClientUi*>(coreUi()); }
     inline mbClientProject* project() const { return reinterpret_cast<mbClientProject*>(projectCore()); }
@@ -72,8 +103,30 @@ public:
     void sendPortMessage(mb::Client::PortHandle_t handle, const mbClientRunMessagePtr &message);
     void sendMessage(mb::Client::DeviceHandle_t handle, const mbClientRunMessagePtr &message);
     void updateItem(mb::Client::ItemHandle_t handle, const QByteArray &data, Modbus::StatusCode status, mb::Timestamp_t timestamp);
+    void updatePollTiming(const QVector<mb::Client::ItemHandle_t> &handles, uint32_t achievedPeriod, uint32_t lateness, uint32_t skippedCycles);
     void writeItemData(mb::Client::ItemHandle_t handle, const QByteArray &data);
 
+public: // data logger
+    QString dataLogFile() const;
+    inline void setDataLogFile(const QString &file) { m_dataLogFile = file; }
+    inline int dataLogMaxFileSize() const { return m_dataLogMaxFileSize; }
+    inline void setDataLogMaxFileSize(int sizeMb) { m_dataLogMaxFileSize = sizeMb; }
+    inline int dataLogRotatePeriod() const { return m_dataLogRotatePeriod; }
+    inline void setDataLogRotatePeriod(int minutes) { m_dataLogRotatePeriod = minutes; }
+
+public: // runtime
+    inline int runtimeWorkerThreads() const { return m_runtimeWorkerThreads; }
+    inline void setRuntimeWorkerThreads(int count) { m_runtimeWorkerThreads = count; }
+    inline int runtimeBusLoadTarget() const { return m_runtimeBusLoadTarget; }
+    inline void setRuntimeBusLoadTarget(int percent) { m_runtimeBusLoadTarget = percent; }
+    inline bool runtimeAdaptiveTimeout() const { return m_runtimeAdaptiveTimeout; }
+    inline void setRuntimeAdaptiveTimeout(bool enable) { m_runtimeAdaptiveTimeout = enable; }
+    inline int runtimeAdaptiveTimeoutMin() const { return m_runtimeAdaptiveTimeoutMin; }
+    inline void setRuntimeAdaptiveTimeoutMin(int msec) { m_runtimeAdaptiveTimeoutMin = msec; }
+
+protected:
+    int parseArg(int argc, char **argv, int &arg) override;
+
 private:
     QString createGUID() override;
     mbCoreUi *createUi() override;
@@ -81,6 +134,15 @@ private:
     mbCoreBuilder *createBuilder() override;
     mbCoreRuntime *createRuntime() override;
     QStringList availableDataViewColumns() const override;
+
+private:
+    QString m_dataLogFile;
+    int m_dataLogMaxFileSize;
+    int m_dataLogRotatePeriod;
+    int m_runtimeWorkerThreads;
+    int m_runtimeBusLoadTarget;
+    bool m_runtimeAdaptiveTimeout;
+    int m_runtimeAdaptiveTimeoutMin;
 };
 
 
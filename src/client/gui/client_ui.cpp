@@ -43,6 +43,7 @@
 
 #include "project/client_projectui.h"
 #include "dataview/client_dataviewmanager.h"
+#include "dataview/client_dataviewui.h"
 #include "statistics/client_statisticsmanager.h"
 
 #include "client_windowmanager.h"
@@ -50,6 +51,7 @@
 #include "sendmessage/client_sendmessageui.h"
 #include "sendbytes/client_sendbytesui.h"
 #include "scanner/client_scannerui.h"
+#include "memoryimage/client_memoryimageui.h"
 
 mbClientUi::mbClientUi(mbClient *core, QWidget *parent) :
     mbCoreUi (core, parent),
@@ -149,6 +151,7 @@ void mbClientUi::initialize()
 
     // DataView Manager
     m_dataViewManager = new mbClientDataViewManager(this);
+    connect(dataViewManager(), &mbClientDataViewManager::dataViewUiActivated, this, &mbClientUi::dataViewUiActivated);
 
     // Statistics Manager
     m_statisticsManager = new mbClientStatisticsManager(this);
@@ -160,15 +163,20 @@ void mbClientUi::initialize()
     m_sendMessageUi = new mbClientSendMessageUi(this);
     m_sendBytesUi   = new mbClientSendBytesUi(this);
     m_scannerUi     = new mbClientScannerUi(this);
+    m_memoryImageUi = new mbClientMemoryImageUi(this);
 
     // Menu Port
     connect(ui->actionPortNewDevice      , &QAction::triggered, this, &mbClientUi::menuSlotPortNewDevice     );
     connect(ui->actionPortClearAllDevices, &QAction::triggered, this, &mbClientUi::menuSlotPortClearAllDevice);
 
+    // Menu DataView
+    connect(ui->actionDataViewTrend, &QAction::triggered, this, &mbClientUi::menuSlotDataViewTrend);
+
     // Menu Tools
     connect(ui->actionToolsSendMessage, &QAction::triggered, this, &mbClientUi::menuSlotToolsSendMessage);
     connect(ui->actionToolsSendBytes  , &QAction::triggered, this, &mbClientUi::menuSlotToolsSendBytes  );
     connect(ui->actionToolsScanner    , &QAction::triggered, this, &mbClientUi::menuSlotToolsScanner    );
+    connect(ui->actionToolsMemoryImage, &QAction::triggered, this, &mbClientUi::menuSlotToolsMemoryImage);
 
     mbCoreUi::initialize();
 }
@@ -179,6 +187,7 @@ MBSETTINGS mbClientUi::cachedSettings() const
     mb::unite(m, m_sendMessageUi->cachedSettings());
     mb::unite(m, m_sendBytesUi->cachedSettings());
     mb::unite(m, m_scannerUi->cachedSettings());
+    mb::unite(m, m_memoryImageUi->cachedSettings());
     return m;
 }
 
@@ -188,6 +197,7 @@ void mbClientUi::setCachedSettings(const MBSETTINGS &settings)
     m_sendMessageUi->setCachedSettings(settings);
     m_sendBytesUi->setCachedSettings(settings);
     m_scannerUi->setCachedSettings(settings);
+    m_memoryImageUi->setCachedSettings(settings);
 }
 
 void mbClientUi::menuSlotEditPaste()
@@ -558,6 +568,13 @@ void mbClientUi::menuSlotDataViewExport()
     mbCoreUi::menuSlotDataViewExport();
 }
 
+void mbClientUi::menuSlotDataViewTrend()
+{
+    if (mbClientDataViewUi *dvui = dataViewManager()->activeDataViewUi())
+        dvui->setTrendVisible(!dvui->isTrendVisible());
+    dataViewUiActivated();
+}
+
 void mbClientUi::menuSlotToolsSendMessage()
 {
     m_sendMessageUi->show();
@@ -573,6 +590,11 @@ void mbClientUi::menuSlotToolsScanner()
     m_scannerUi->show();
 }
 
+void mbClientUi::menuSlotToolsMemoryImage()
+{
+    m_memoryImageUi->show();
+}
+
 void mbClientUi::contextMenuDevice(mbClientDevice */*device*/)
 {
     QMenu mn(m_projectUi);
@@ -581,6 +603,12 @@ void mbClientUi::contextMenuDevice(mbClientDevice */*device*/)
     mn.exec(QCursor::pos());
 }
 
+void mbClientUi::dataViewUiActivated()
+{
+    mbClientDataViewUi *dvui = dataViewManager()->activeDataViewUi();
+    ui->actionDataViewTrend->setChecked(dvui && dvui->isTrendVisible());
+}
+
 void mbClientUi::editPort(mbCorePort *port)
 {
     MBSETTINGS o = port->settings();
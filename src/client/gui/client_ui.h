@@ -44,6 +44,7 @@ class mbClientStatisticsManager;
 class mbClientSendMessageUi;
 class mbClientSendBytesUi;
 class mbClientScannerUi;
+class mbClientMemoryImageUi;
 
 namespace Ui {
 class mbClientUi;
@@ -113,15 +114,18 @@ private Q_SLOTS:
     void menuSlotDataViewDelete     () override;
     void menuSlotDataViewImport     () override;
     void menuSlotDataViewExport     () override;
+    void menuSlotDataViewTrend      ();
     // ----------------------------
     // ------------TOOLS-----------
     // ----------------------------
     void menuSlotToolsSendMessage();
     void menuSlotToolsSendBytes();
     void menuSlotToolsScanner();
+    void menuSlotToolsMemoryImage();
 
 private Q_SLOTS:
     void contextMenuDevice(mbClientDevice *device);
+    void dataViewUiActivated();
 
 private:
     void editPort(mbCorePort *port);
@@ -137,6 +141,7 @@ private:
     mbClientSendMessageUi *m_sendMessageUi;
     mbClientSendBytesUi *m_sendBytesUi;
     mbClientScannerUi *m_scannerUi;
+    mbClientMemoryImageUi *m_memoryImageUi;
 };
 
 
@@ -65,6 +65,24 @@ QVariant mbClientDataViewModel::data(const QModelIndex &index, int role) const
             }
         }
             break;
+        case Qt::ToolTipRole:
+        {
+            int c = dataView()->getColumnTypeByIndex(index.column());
+            if ((c == mbClientDataView::Period) && mbClient::global()->isRunning())
+            {
+                mbClientDataView::Statistics s = dataView()->statistics();
+                return QString("Achieved period: %1 ms\n"
+                               "Lateness: %2 ms\n"
+                               "Data view avg/max period: %3/%4 ms\n"
+                               "Data view skipped cycles: %5")
+                    .arg(d->achievedPeriod())
+                    .arg(d->lateness())
+                    .arg(s.pollAvgPeriod)
+                    .arg(s.pollMaxPeriod)
+                    .arg(s.pollSkippedCycles);
+            }
+        }
+            break;
         case Qt::BackgroundRole:
         {
             int c = dataView()->getColumnTypeByIndex(index.column());
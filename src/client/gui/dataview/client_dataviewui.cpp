@@ -22,16 +22,29 @@
 */
 #include "client_dataviewui.h"
 
+#include <QSplitter>
+#include <QTableView>
+#include <QLayout>
+
 #include <project/client_project.h>
 #include <project/client_device.h>
 #include <project/client_dataview.h>
 
 #include "client_dataviewmodel.h"
 #include "client_dataviewdelegate.h"
+#include "client_trendui.h"
 
 mbClientDataViewUi::mbClientDataViewUi(mbClientDataView *dataView, QWidget *parent) :
     mbCoreDataViewUi(dataView, new mbClientDataViewModel(dataView), new mbClientDataViewDelegate(), parent)
 {
+    // Note: trend is placed next to the table and follows the selected items
+    m_trend = new mbClientTrendUi(this);
+    m_trend->setVisible(false);
+    QSplitter *splitter = new QSplitter(Qt::Horizontal, this);
+    layout()->replaceWidget(m_view, splitter);
+    splitter->addWidget(m_view);
+    splitter->addWidget(m_trend);
+    connect(m_view->selectionModel(), &QItemSelectionModel::selectionChanged, this, &mbClientDataViewUi::selectionChanged);
 }
 
 QList<mbClientDataViewItem*> mbClientDataViewUi::selectedItems() const
@@ -39,3 +52,21 @@ QList<mbClientDataViewItem*> mbClientDataViewUi::selectedItems() const
     QList<mbCoreDataViewItem*> ls = selectedItemsCore();
     return QList<mbClientDataViewItem*>(*(reinterpret_cast<const QList<mbClientDataViewItem*>*>(&ls)));
 }
+
+bool mbClientDataViewUi::isTrendVisible() const
+{
+    return !m_trend->isHidden();
+}
+
+void mbClientDataViewUi::setTrendVisible(bool visible)
+{
+    if (visible)
+        m_trend->setItems(selectedItems());
+    m_trend->setVisible(visible);
+}
+
+void mbClientDataViewUi::selectionChanged()
+{
+    if (!m_trend->isHidden())
+        m_trend->setItems(selectedItems());
+}
@@ -29,6 +29,7 @@ class mbClientDataView;
 class mbClientDataViewItem;
 class mbClientDataViewModel;
 class mbClientDataViewDelegate;
+class mbClientTrendUi;
 
 class mbClientDataViewUi : public mbCoreDataViewUi
 {
@@ -41,6 +42,16 @@ public:
     inline mbClientDataView *dataView() const { return reinterpret_cast<mbClientDataView *>(dataViewCore()); }
     inline mbClientDataViewModel *model() const { return reinterpret_cast<mbClientDataViewModel*>(modelCore()); }
     QList<mbClientDataViewItem*> selectedItems() const;
+
+public:
+    bool isTrendVisible() const;
+    void setTrendVisible(bool visible);
+
+private Q_SLOTS:
+    void selectionChanged();
+
+private:
+    mbClientTrendUi *m_trend;
 };
 
 #endif // CLIENT_DATAVIEWUI_H
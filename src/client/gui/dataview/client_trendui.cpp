@@ -0,0 +1,188 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_trendui.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QWheelEvent>
+
+#include <client.h>
+#include <project/client_device.h>
+#include <project/client_dataview.h>
+#include <runtime/client_runtime.h>
+#include <runtime/client_historian.h>
+
+mbClientTrendUi::mbClientTrendUi(QWidget *parent) : QWidget(parent)
+{
+    m_span = DefaultSpan;
+    m_timerId = 0;
+    setMinimumWidth(200);
+    setAutoFillBackground(true);
+    setBackgroundRole(QPalette::Base);
+}
+
+void mbClientTrendUi::setSpan(mb::Timestamp_t span)
+{
+    m_span = qBound<mb::Timestamp_t>(MinSpan, span, MaxSpan);
+    update();
+}
+
+void mbClientTrendUi::setItems(const QList<mbClientDataViewItem *> &items)
+{
+    m_items.clear();
+    Q_FOREACH (mbClientDataViewItem *item, items)
+        m_items.append(item);
+    update();
+}
+
+QSize mbClientTrendUi::sizeHint() const
+{
+    return QSize(400, 200);
+}
+
+void mbClientTrendUi::showEvent(QShowEvent *event)
+{
+    if (!m_timerId)
+        m_timerId = startTimer(RefreshPeriod);
+    QWidget::showEvent(event);
+}
+
+void mbClientTrendUi::hideEvent(QHideEvent *event)
+{
+    if (m_timerId)
+    {
+        killTimer(m_timerId);
+        m_timerId = 0;
+    }
+    QWidget::hideEvent(event);
+}
+
+void mbClientTrendUi::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == m_timerId)
+    {
+        if (mbClient::global()->isRunning())
+            update();
+        return;
+    }
+    QWidget::timerEvent(event);
+}
+
+void mbClientTrendUi::wheelEvent(QWheelEvent *event)
+{
+    // Note: wheel up zooms in, wheel down zooms out
+    if (event->angleDelta().y() > 0)
+        setSpan(m_span / 2);
+    else if (event->angleDelta().y() < 0)
+        setSpan(m_span * 2);
+    event->accept();
+}
+
+void mbClientTrendUi::paintEvent(QPaintEvent * /*event*/)
+{
+    static const QColor colors[] = { Qt::blue, Qt::red, Qt::darkGreen, Qt::magenta, Qt::darkCyan, Qt::darkYellow, Qt::black };
+    const int colorCount = sizeof(colors) / sizeof(colors[0]);
+
+    QPainter p(this);
+    const QFontMetrics fm = p.fontMetrics();
+    const int lineHeight = fm.height();
+    const QRect area = rect().adjusted(4, lineHeight + 4, -4, -(lineHeight + 4));
+    if (area.width() <= 0 || area.height() <= 0)
+        return;
+
+    const mb::Timestamp_t end = mb::currentTimestamp();
+    const mb::Timestamp_t begin = end - m_span;
+    p.setPen(palette().color(QPalette::Mid));
+    p.drawRect(area);
+    p.drawText(area.left(), height() - 4, mb::toString(begin));
+    QString spanText = QString("%1 s").arg(m_span / 1000);
+    p.drawText(area.right() - fm.horizontalAdvance(spanText), height() - 4, spanText);
+
+    mbClientHistorian *historian = mbClient::global()->runtime()->historian();
+    QList<mbClientHistorian::Samples_t> series;
+    double vMin = 0, vMax = 0;
+    bool first = true;
+    Q_FOREACH (const QPointer<mbClientDataViewItem> &item, m_items)
+    {
+        mbClientHistorian::Samples_t s;
+        if (item)
+            s = historian->samples(item->handle(), begin, end, area.width());
+        for (const mbClientHistorian::Sample &v : s)
+        {
+            if (first || v.min < vMin) vMin = v.min;
+            if (first || v.max > vMax) vMax = v.max;
+            first = false;
+        }
+        series.append(s);
+    }
+    if (first)
+        return;
+    if (vMax == vMin)
+    {
+        vMax += 1;
+        vMin -= 1;
+    }
+    p.drawText(area.left() + 2, area.top() + lineHeight, QString::number(vMax));
+    p.drawText(area.left() + 2, area.bottom() - 2, QString::number(vMin));
+
+    const double kx = static_cast<double>(area.width()) / m_span;
+    const double ky = area.height() / (vMax - vMin);
+    int legendX = area.left();
+    p.setRenderHint(QPainter::Antialiasing);
+    for (int i = 0; i < series.count(); i++)
+    {
+        const mbClientHistorian::Samples_t &s = series.at(i);
+        QColor color = colors[i % colorCount];
+        if (s.count())
+        {
+            QPainterPath path;
+            for (int j = 0; j < s.count(); j++)
+            {
+                const mbClientHistorian::Sample &v = s.at(j);
+                double x = area.left() + (v.timestamp - begin) * kx;
+                double y = area.bottom() - (v.avg - vMin) * ky;
+                if (v.count > 1) // rollup: show min/max range of the bucket
+                {
+                    QColor band = color;
+                    band.setAlpha(64);
+                    p.setPen(band);
+                    p.drawLine(QPointF(x, area.bottom() - (v.min - vMin) * ky), QPointF(x, area.bottom() - (v.max - vMin) * ky));
+                }
+                if (j == 0)
+                    path.moveTo(x, y);
+                else
+                    path.lineTo(x, y);
+            }
+            p.setPen(QPen(color, 1.5));
+            p.drawPath(path);
+        }
+        // legend
+        mbClientDataViewItem *item = m_items.at(i);
+        if (!item)
+            continue;
+        QString name = item->device() ? QString("%1:%2").arg(item->device()->name(), item->addressStr()) : item->addressStr();
+        p.setPen(color);
+        p.drawText(legendX, lineHeight, name);
+        legendX += fm.horizontalAdvance(name) + 10;
+    }
+}
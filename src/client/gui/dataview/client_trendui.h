@@ -0,0 +1,70 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_TRENDUI_H
+#define CLIENT_TRENDUI_H
+
+#include <QPointer>
+#include <QWidget>
+
+#include <client_global.h>
+
+class mbClientDataViewItem;
+
+class mbClientTrendUi : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum Constants
+    {
+        RefreshPeriod = 500,       // ms
+        MinSpan       = 10000,     // 10 sec
+        MaxSpan       = 86400000,  // 24 hours
+        DefaultSpan   = 60000      // 1 min
+    };
+
+public:
+    explicit mbClientTrendUi(QWidget *parent = nullptr);
+
+public:
+    inline mb::Timestamp_t span() const { return m_span; }
+    void setSpan(mb::Timestamp_t span);
+    void setItems(const QList<mbClientDataViewItem*> &items);
+
+public:
+    QSize sizeHint() const override;
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void timerEvent(QTimerEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    QList<QPointer<mbClientDataViewItem> > m_items;
+    mb::Timestamp_t m_span;
+    int m_timerId;
+};
+
+#endif // CLIENT_TRENDUI_H
@@ -3,9 +3,11 @@ HEADERS += \
     $$PWD/client_dataviewmanager.h \
     $$PWD/client_dataviewmodel.h \
     $$PWD/client_dataviewui.h \
+    $$PWD/client_trendui.h \
 
 SOURCES += \
     $$PWD/client_dataviewdelegate.cpp \
     $$PWD/client_dataviewmanager.cpp \
     $$PWD/client_dataviewmodel.cpp \
     $$PWD/client_dataviewui.cpp \
+    $$PWD/client_trendui.cpp \
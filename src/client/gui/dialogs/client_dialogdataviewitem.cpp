@@ -109,6 +109,7 @@ void mbClientDialogDataViewItem::fillFormEditInner(const MBSETTINGS &settings)
     const mbClientDataViewItem::Strings &sItem = mbClientDataViewItem::Strings::instance();
     int period = settings.value(sItem.period).toInt();
     ui->spPeriod->setValue(period);
+    ui->lnExpression->setText(settings.value(sItem.expression).toString());
 }
 
 void mbClientDialogDataViewItem::fillFormNewInner(const MBSETTINGS &settings)
@@ -118,10 +119,12 @@ void mbClientDialogDataViewItem::fillFormNewInner(const MBSETTINGS &settings)
     MBSETTINGS::const_iterator end = settings.end();
 
     it = settings.find(sItem.period); if (it != end) ui->spPeriod->setValue(settings.value(sItem.period).toInt());
+    ui->lnExpression->clear();
 }
 
 void mbClientDialogDataViewItem::fillDataInner(MBSETTINGS &settings) const
 {
     const mbClientDataViewItem::Strings &sItem = mbClientDataViewItem::Strings::instance();
     settings[sItem.period] = ui->spPeriod->value();
+    settings[sItem.expression] = ui->lnExpression->text();
 }
@@ -35,7 +35,7 @@
 mbClientDialogs::mbClientDialogs(QWidget *parent) :
     mbCoreDialogs (parent)
 {
-    m_projectFilter = QStringLiteral("Client Project (*.mbc)");
+    m_projectFilter = QStringLiteral("Client Project (*.mbc *.mbcb)");
     m_settings = new mbClientDialogSettings(parent);
     m_port = new mbClientDialogPort(parent);
     m_device = new mbClientDialogDevice(parent);
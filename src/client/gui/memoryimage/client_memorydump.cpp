@@ -0,0 +1,382 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_memorydump.h"
+
+#include <QFile>
+#include <QtEndian>
+#include <QTextStream>
+
+#include <client.h>
+
+#include <project/client_device.h>
+
+#include <runtime/client_runmessage.h>
+
+mbClientMemoryDump::mbClientMemoryDump(QObject *parent) : QObject(parent)
+{
+    m_device = nullptr;
+    m_memoryType = Modbus::Memory_4x;
+    m_offset = 0;
+    m_count = 0;
+    m_window = DefaultWindow;
+    m_retries = DefaultRetries;
+    m_running = false;
+    m_probing = false;
+    m_blockSize = 0;
+    m_done = 0;
+    m_failedBlocks = 0;
+}
+
+mbClientMemoryDump::~mbClientMemoryDump()
+{
+    stop();
+}
+
+uint16_t mbClientMemoryDump::value(uint32_t index) const
+{
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+        return (static_cast<uint8_t>(m_data.at(static_cast<int>(index / MB_BYTE_SZ_BITES))) >> (index % MB_BYTE_SZ_BITES)) & 1;
+    default:
+        return reinterpret_cast<const uint16_t*>(m_data.constData())[index];
+    }
+}
+
+void mbClientMemoryDump::setValue(uint32_t index, uint16_t value)
+{
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+        if (value)
+            m_data[static_cast<int>(index / MB_BYTE_SZ_BITES)] = static_cast<char>(m_data.at(static_cast<int>(index / MB_BYTE_SZ_BITES)) |  (1 << (index % MB_BYTE_SZ_BITES)));
+        else
+            m_data[static_cast<int>(index / MB_BYTE_SZ_BITES)] = static_cast<char>(m_data.at(static_cast<int>(index / MB_BYTE_SZ_BITES)) & ~(1 << (index % MB_BYTE_SZ_BITES)));
+        break;
+    default:
+        reinterpret_cast<uint16_t*>(m_data.data())[index] = value;
+        break;
+    }
+}
+
+bool mbClientMemoryDump::start(mbClientDevice *device, const mb::Address &address, uint32_t count)
+{
+    if (m_running || !device || !init(address, count))
+        return false;
+    m_device = device;
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+        m_blockSize = qMin<uint16_t>(device->maxReadCoils(), MaxReadBits);
+        break;
+    case Modbus::Memory_1x:
+        m_blockSize = qMin<uint16_t>(device->maxReadDiscreteInputs(), MaxReadBits);
+        break;
+    case Modbus::Memory_3x:
+        m_blockSize = qMin<uint16_t>(device->maxReadInputRegisters(), MaxReadRegs);
+        break;
+    default:
+        m_blockSize = qMin<uint16_t>(device->maxReadHoldingRegisters(), MaxReadRegs);
+        break;
+    }
+    if (m_blockSize == 0)
+        m_blockSize = 1;
+    m_pending.clear();
+    m_inflight.clear();
+    m_done = 0;
+    m_failedBlocks = 0;
+    m_running = true;
+    m_probing = true;
+    Block b;
+    b.index = 0;
+    b.count = static_cast<uint16_t>(qMin<uint32_t>(m_blockSize, m_count));
+    b.retries = 0;
+    sendBlock(b);
+    return true;
+}
+
+void mbClientMemoryDump::stop()
+{
+    if (!m_running)
+        return;
+    Q_FOREACH (const Request &r, m_inflight)
+        r.message->disconnect(this);
+    m_inflight.clear();
+    m_pending.clear();
+    m_running = false;
+    Q_EMIT finished(false);
+}
+
+bool mbClientMemoryDump::save(const QString &fileName, Format format) const
+{
+    QFile file(fileName);
+    if (format == Format_Csv)
+    {
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+            return false;
+        QTextStream out(&file);
+        mb::AddressNotation notation = mbClient::global()->addressNotation();
+        mb::Address adr = m_address;
+        out << "Address,Value\n";
+        for (uint32_t i = 0; i < m_count; i++)
+        {
+            adr.setOffset(static_cast<uint16_t>(m_offset + i));
+            out << mb::toString(adr, notation) << ',';
+            if (isValid(i))
+                out << value(i);
+            out << '\n';
+        }
+        return true;
+    }
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+        // Note: bits are packed as in Modbus PDU (LSB of the first byte is the first bit)
+        file.write(m_data);
+        break;
+    default:
+    {
+        // Note: registers are stored as in Modbus PDU (big-endian)
+        QByteArray buff(m_data.size(), '\0');
+        const uint16_t *src = reinterpret_cast<const uint16_t*>(m_data.constData());
+        for (uint32_t i = 0; i < m_count; i++)
+            qToBigEndian(src[i], reinterpret_cast<uchar*>(buff.data()) + i * 2);
+        file.write(buff);
+    }
+        break;
+    }
+    return true;
+}
+
+bool mbClientMemoryDump::load(const QString &fileName, Format format, const mb::Address &address, uint32_t count)
+{
+    if (m_running || !init(address, count))
+        return false;
+    QFile file(fileName);
+    if (format == Format_Csv)
+    {
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return false;
+        QTextStream in(&file);
+        while (!in.atEnd())
+        {
+            // Note: lines with unknown or out of range address (e.g. header) are skipped
+            QStringList ls = in.readLine().split(',');
+            if (ls.count() < 2)
+                continue;
+            mb::Address adr = mb::toAddress(ls.at(0).trimmed());
+            if ((adr.type() != m_memoryType) || (adr.offset() < m_offset) || (adr.offset() - m_offset >= m_count))
+                continue;
+            bool ok;
+            uint16_t v = static_cast<uint16_t>(ls.at(1).trimmed().toUShort(&ok));
+            if (!ok)
+                continue;
+            uint32_t index = adr.offset() - m_offset;
+            setValue(index, v);
+            m_valid.setBit(static_cast<int>(index));
+        }
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QByteArray buff = file.read(m_data.size());
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+        memcpy(m_data.data(), buff.constData(), static_cast<size_t>(buff.size()));
+        m_valid.fill(true, 0, static_cast<int>(qMin<uint32_t>(static_cast<uint32_t>(buff.size()) * MB_BYTE_SZ_BITES, m_count)));
+        break;
+    default:
+    {
+        uint32_t c = static_cast<uint32_t>(buff.size()) / 2;
+        uint16_t *dst = reinterpret_cast<uint16_t*>(m_data.data());
+        for (uint32_t i = 0; i < c; i++)
+            dst[i] = qFromBigEndian<uint16_t>(reinterpret_cast<const uchar*>(buff.constData()) + i * 2);
+        m_valid.fill(true, 0, static_cast<int>(c));
+    }
+        break;
+    }
+    return true;
+}
+
+void mbClientMemoryDump::messageCompleted()
+{
+    mbClientRunMessage *message = qobject_cast<mbClientRunMessage*>(sender());
+    if (!message || !m_running)
+        return;
+    int i;
+    for (i = 0; i < m_inflight.count(); i++)
+    {
+        if (m_inflight.at(i).message.data() == message)
+            break;
+    }
+    if (i == m_inflight.count())
+        return;
+    Request r = m_inflight.takeAt(i);
+    message->disconnect(this);
+    Modbus::StatusCode status = message->status();
+    if (Modbus::StatusIsGood(status))
+    {
+        storeData(message, r.block);
+        m_done += r.block.count;
+        Q_EMIT progress(m_done, m_count);
+        if (m_probing)
+        {
+            m_probing = false;
+            splitRange(r.block.index + r.block.count);
+        }
+    }
+    else if (m_probing && (r.block.count > 1) &&
+             ((status == Modbus::Status_BadIllegalDataValue) || (status == Modbus::Status_BadIllegalDataAddress)))
+    {
+        // Note: device doesn't accept such count, try half of it
+        m_blockSize = r.block.count / 2;
+        r.block.count = m_blockSize;
+        sendBlock(r.block);
+        return;
+    }
+    else if (r.block.retries < m_retries)
+    {
+        r.block.retries++;
+        m_pending.prepend(r.block);
+    }
+    else
+    {
+        m_failedBlocks++;
+        m_done += r.block.count;
+        Q_EMIT progress(m_done, m_count);
+        if (m_probing)
+        {
+            m_probing = false;
+            splitRange(r.block.index + r.block.count);
+        }
+    }
+    fillWindow();
+}
+
+bool mbClientMemoryDump::init(const mb::Address &address, uint32_t count)
+{
+    if (count == 0)
+        return false;
+    switch (address.type())
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+        m_count = qMin<uint32_t>(count, 0x10000 - address.offset());
+        m_data = QByteArray(static_cast<int>((m_count + 7) / 8), '\0');
+        break;
+    case Modbus::Memory_3x:
+    case Modbus::Memory_4x:
+        m_count = qMin<uint32_t>(count, 0x10000 - address.offset());
+        m_data = QByteArray(static_cast<int>(m_count * 2), '\0');
+        break;
+    default:
+        return false;
+    }
+    m_address = address;
+    m_memoryType = address.type();
+    m_offset = address.offset();
+    m_valid = QBitArray(static_cast<int>(m_count));
+    return true;
+}
+
+mbClientRunMessage *mbClientMemoryDump::createMessage(const Block &block) const
+{
+    uint16_t offset = static_cast<uint16_t>(m_offset + block.index);
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+        return new mbClientRunMessageReadCoils(offset, block.count, block.count);
+    case Modbus::Memory_1x:
+        return new mbClientRunMessageReadDiscreteInputs(offset, block.count, block.count);
+    case Modbus::Memory_3x:
+        return new mbClientRunMessageReadInputRegisters(offset, block.count, block.count);
+    default:
+        return new mbClientRunMessageReadHoldingRegisters(offset, block.count, block.count);
+    }
+}
+
+void mbClientMemoryDump::sendBlock(const Block &block)
+{
+    Request r;
+    r.message = createMessage(block);
+    r.block = block;
+    connect(r.message.data(), &mbClientRunMessage::completed, this, &mbClientMemoryDump::messageCompleted);
+    m_inflight.append(r);
+    mbClient::global()->sendMessage(m_device->handle(), r.message);
+}
+
+void mbClientMemoryDump::splitRange(uint32_t index)
+{
+    while (index < m_count)
+    {
+        Block b;
+        b.index = index;
+        b.count = static_cast<uint16_t>(qMin<uint32_t>(m_blockSize, m_count - index));
+        b.retries = 0;
+        m_pending.append(b);
+        index += b.count;
+    }
+}
+
+void mbClientMemoryDump::fillWindow()
+{
+    // Note: while probing only one request is in flight
+    int window = m_probing ? 1 : m_window;
+    while (m_pending.count() && (m_inflight.count() < window))
+        sendBlock(m_pending.takeFirst());
+    if (m_inflight.isEmpty() && m_pending.isEmpty())
+        finish();
+}
+
+void mbClientMemoryDump::storeData(const mbClientRunMessage *message, const Block &block)
+{
+    switch (m_memoryType)
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_1x:
+    {
+        uint32_t c;
+        QByteArray bits(static_cast<int>((block.count + 7) / 8), '\0');
+        message->getData(0, block.count, bits.data());
+        Modbus::writeMemBits(block.index, block.count, bits.constData(), m_data.data(), m_count, &c);
+    }
+        break;
+    default:
+        message->getData(0, block.count, reinterpret_cast<uint16_t*>(m_data.data()) + block.index);
+        break;
+    }
+    m_valid.fill(true, static_cast<int>(block.index), static_cast<int>(block.index + block.count));
+}
+
+void mbClientMemoryDump::finish()
+{
+    m_running = false;
+    Q_EMIT finished(m_failedBlocks == 0);
+}
@@ -0,0 +1,140 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_MEMORYDUMP_H
+#define CLIENT_MEMORYDUMP_H
+
+#include <QObject>
+#include <QBitArray>
+
+#include <client_global.h>
+
+class mbClientDevice;
+
+/*
+   Reads whole memory range of the device as fast as possible:
+   1. Probes the largest count accepted by the device for the read function
+      (starting from device 'maxRead*' setting and halving the count
+      while device responds with 'Illegal data value/address').
+   2. Splits the range into blocks of probed size and keeps up to 'window'
+      requests queued for the device, so the port never waits for GUI.
+   3. Failed blocks are retried up to 'retries' times, other blocks are not reread.
+*/
+class mbClientMemoryDump : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format
+    {
+        Format_Binary,
+        Format_Csv
+    };
+    Q_ENUM(Format)
+
+    enum Constants
+    {
+        DefaultWindow  = 4,
+        DefaultRetries = 3,
+        MaxReadBits    = 2000,
+        MaxReadRegs    = 125
+    };
+
+public:
+    explicit mbClientMemoryDump(QObject *parent = nullptr);
+    ~mbClientMemoryDump();
+
+public:
+    inline bool isRunning() const { return m_running; }
+    inline int window() const { return m_window; }
+    inline void setWindow(int window) { m_window = qMax(window, 1); }
+    inline int retries() const { return m_retries; }
+    inline void setRetries(int retries) { m_retries = qMax(retries, 0); }
+
+public:
+    inline const mb::Address &address() const { return m_address; }
+    inline Modbus::MemoryType memoryType() const { return m_memoryType; }
+    inline uint16_t offset() const { return m_offset; }
+    inline uint32_t count() const { return m_count; }
+    inline uint16_t blockSize() const { return m_blockSize; }
+    inline int failedBlocks() const { return m_failedBlocks; }
+    inline bool isValid(uint32_t index) const { return m_valid.testBit(static_cast<int>(index)); }
+    uint16_t value(uint32_t index) const;
+    void setValue(uint32_t index, uint16_t value);
+    inline const QByteArray &data() const { return m_data; }
+
+public:
+    bool start(mbClientDevice *device, const mb::Address &address, uint32_t count);
+    void stop();
+    bool save(const QString &fileName, Format format) const;
+    bool load(const QString &fileName, Format format, const mb::Address &address, uint32_t count);
+
+Q_SIGNALS:
+    void progress(uint32_t done, uint32_t total);
+    void finished(bool success);
+
+private Q_SLOTS:
+    void messageCompleted();
+
+private:
+    struct Block
+    {
+        uint32_t index; // index of the first value of the block in the dump
+        uint16_t count;
+        int retries;
+    };
+
+    struct Request
+    {
+        mbClientRunMessagePtr message;
+        Block block;
+    };
+
+private:
+    bool init(const mb::Address &address, uint32_t count);
+    mbClientRunMessage *createMessage(const Block &block) const;
+    void sendBlock(const Block &block);
+    void splitRange(uint32_t index);
+    void fillWindow();
+    void storeData(const mbClientRunMessage *message, const Block &block);
+    void finish();
+
+private:
+    mbClientDevice *m_device;
+    mb::Address m_address;
+    Modbus::MemoryType m_memoryType;
+    uint16_t m_offset;
+    uint32_t m_count;
+    int m_window;
+    int m_retries;
+    bool m_running;
+    bool m_probing;
+    uint16_t m_blockSize;
+    QList<Block> m_pending;
+    QList<Request> m_inflight;
+    uint32_t m_done;
+    int m_failedBlocks;
+    QByteArray m_data; // registers in host byte order, bits are packed
+    QBitArray m_valid;
+};
+
+#endif // CLIENT_MEMORYDUMP_H
@@ -0,0 +1,317 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_memoryimageui.h"
+#include "ui_client_memoryimageui.h"
+
+#include <QMetaEnum>
+
+#include <client.h>
+
+#include <project/client_project.h>
+#include <project/client_device.h>
+
+#include <gui/widgets/core_addresswidget.h>
+
+#include <gui/client_ui.h>
+#include <gui/dialogs/client_dialogs.h>
+
+#include "client_memorydump.h"
+#include "client_memoryupload.h"
+
+mbClientMemoryImageUi::Strings::Strings() :
+    prefix (QStringLiteral("Ui.MemoryImage.")),
+    address(prefix+QStringLiteral("address")),
+    count  (prefix+QStringLiteral("count")),
+    window (prefix+QStringLiteral("window")),
+    retries(prefix+QStringLiteral("retries")),
+    format (prefix+QStringLiteral("format")),
+    file   (prefix+QStringLiteral("file")),
+    verify (prefix+QStringLiteral("verify"))
+{
+}
+
+const mbClientMemoryImageUi::Strings &mbClientMemoryImageUi::Strings::instance()
+{
+    static const Strings s;
+    return s;
+}
+
+mbClientMemoryImageUi::mbClientMemoryImageUi(QWidget *parent) : mbCoreDialogBase(Strings::instance().prefix, parent),
+                                                                ui(new Ui::mbClientMemoryImageUi)
+{
+    ui->setupUi(this);
+    m_project = nullptr;
+    m_dump = new mbClientMemoryDump(this);
+    m_image = new mbClientMemoryDump(this);
+    m_upload = new mbClientMemoryUpload(this);
+
+    mbClient *core = mbClient::global();
+
+    m_address = new mbCoreAddressWidget(this);
+    m_address->setAddressNotation(core->addressNotation());
+    connect(core, &mbClient::addressNotationChanged, m_address, &mbCoreAddressWidget::setAddressNotation);
+    ui->formLayout->setWidget(1, QFormLayout::FieldRole, m_address);
+
+    QMetaEnum e = QMetaEnum::fromType<mbClientMemoryDump::Format>();
+    for (int i = 0; i < e.keyCount(); i++)
+        ui->cmbFormat->addItem(QString(e.key(i)).mid(7)); // remove 'Format_' prefix
+
+    connect(ui->btnBrowse, &QPushButton::clicked, this, &mbClientMemoryImageUi::slotBrowse);
+    connect(ui->btnDump  , &QPushButton::clicked, this, &mbClientMemoryImageUi::slotDump  );
+    connect(ui->btnUpload, &QPushButton::clicked, this, &mbClientMemoryImageUi::slotUpload);
+    connect(ui->btnStop  , &QPushButton::clicked, this, &mbClientMemoryImageUi::slotStop  );
+    connect(ui->btnClose , &QPushButton::clicked, this, &QDialog::close);
+
+    connect(m_dump, &mbClientMemoryDump::progress, this, &mbClientMemoryImageUi::dumpProgress);
+    connect(m_dump, &mbClientMemoryDump::finished, this, &mbClientMemoryImageUi::dumpFinished);
+
+    connect(m_upload, &mbClientMemoryUpload::stateChanged, this, &mbClientMemoryImageUi::uploadStateChanged);
+    connect(m_upload, &mbClientMemoryUpload::progress    , this, &mbClientMemoryImageUi::dumpProgress      );
+    connect(m_upload, &mbClientMemoryUpload::finished    , this, &mbClientMemoryImageUi::uploadFinished    );
+
+    connect(core, &mbClient::projectChanged, this, &mbClientMemoryImageUi::setProject);
+    connect(core, &mbClient::statusChanged , this, &mbClientMemoryImageUi::setRunStatus);
+    setProject(core->project());
+    ui->btnStop->setEnabled(false);
+}
+
+mbClientMemoryImageUi::~mbClientMemoryImageUi()
+{
+    delete ui;
+}
+
+MBSETTINGS mbClientMemoryImageUi::cachedSettings() const
+{
+    const Strings &s = Strings::instance();
+
+    MBSETTINGS m = mbCoreDialogBase::cachedSettings();
+    m[s.address  ] = mb::toInt(m_address->getAddress());
+    m[s.count    ] = ui->spCount  ->value();
+    m[s.window   ] = ui->spWindow ->value();
+    m[s.retries  ] = ui->spRetries->value();
+    m[s.format   ] = ui->cmbFormat->currentIndex();
+    m[s.file     ] = ui->lnFile   ->text();
+    m[s.verify   ] = ui->chkVerify->isChecked();
+    m[s.wGeometry] = this->saveGeometry();
+    return m;
+}
+
+void mbClientMemoryImageUi::setCachedSettings(const MBSETTINGS &m)
+{
+    mbCoreDialogBase::setCachedSettings(m);
+
+    const Strings &s = Strings::instance();
+
+    MBSETTINGS::const_iterator it;
+    MBSETTINGS::const_iterator end = m.end();
+
+    it = m.find(s.address  ); if (it != end) m_address   ->setAddress     (mb::toAddress(it.value().toInt()));
+    it = m.find(s.count    ); if (it != end) ui->spCount  ->setValue       (it.value().toInt       ());
+    it = m.find(s.window   ); if (it != end) ui->spWindow ->setValue       (it.value().toInt       ());
+    it = m.find(s.retries  ); if (it != end) ui->spRetries->setValue       (it.value().toInt       ());
+    it = m.find(s.format   ); if (it != end) ui->cmbFormat->setCurrentIndex(it.value().toInt       ());
+    it = m.find(s.file     ); if (it != end) ui->lnFile   ->setText        (it.value().toString    ());
+    it = m.find(s.verify   ); if (it != end) ui->chkVerify->setChecked     (it.value().toBool      ());
+    it = m.find(s.wGeometry); if (it != end) this         ->restoreGeometry(it.value().toByteArray ());
+}
+
+void mbClientMemoryImageUi::setProject(mbCoreProject *p)
+{
+    mbClientProject *project = static_cast<mbClientProject*>(p);
+    if (m_project != project)
+    {
+        if (m_project)
+        {
+            m_project->disconnect(this);
+            ui->cmbDevice->clear();
+        }
+        m_project = project;
+        if (m_project)
+        {
+            QList<mbClientDevice*> devices = m_project->devices();
+            connect(m_project, &mbClientProject::deviceAdded   , this, &mbClientMemoryImageUi::addDevice   );
+            connect(m_project, &mbClientProject::deviceRemoving, this, &mbClientMemoryImageUi::removeDevice);
+            connect(m_project, &mbClientProject::deviceRenaming, this, &mbClientMemoryImageUi::renameDevice);
+            Q_FOREACH (mbClientDevice *d, devices)
+                addDevice(d);
+        }
+    }
+}
+
+void mbClientMemoryImageUi::addDevice(mbCoreDevice *device)
+{
+    int i = m_project->deviceIndex(device);
+    ui->cmbDevice->insertItem(i, device->name());
+}
+
+void mbClientMemoryImageUi::removeDevice(mbCoreDevice *device)
+{
+    int i = m_project->deviceIndex(device);
+    ui->cmbDevice->removeItem(i);
+}
+
+void mbClientMemoryImageUi::renameDevice(mbCoreDevice *device, const QString newName)
+{
+    int i = m_project->deviceIndex(device);
+    ui->cmbDevice->setItemText(i, newName);
+}
+
+void mbClientMemoryImageUi::setRunStatus(int status)
+{
+    if (status == mbClient::Stopped)
+        slotStop();
+}
+
+void mbClientMemoryImageUi::slotBrowse()
+{
+    mbClientDialogs *dialogs = mbClient::global()->ui()->dialogs();
+    QString file = dialogs->getSaveFileName(this,
+                                            QString("Memory Image File"),
+                                            ui->lnFile->text(),
+                                            dialogs->getFilterString(mbCoreDialogs::Filter_AllFiles));
+    if (!file.isEmpty())
+        ui->lnFile->setText(file);
+}
+
+void mbClientMemoryImageUi::slotDump()
+{
+    mbClientDevice *device = currentDevice();
+    if (!device)
+        return;
+    mbClient *core = mbClient::global();
+    if (!core->isRunning())
+        core->start();
+    m_dump->setWindow(ui->spWindow->value());
+    m_dump->setRetries(ui->spRetries->value());
+    ui->progressBar->setValue(0);
+    ui->lnStatus->setText(QStringLiteral("Reading..."));
+    if (m_dump->start(device, m_address->getAddress(), static_cast<uint32_t>(ui->spCount->value())))
+        setEnableParams(false);
+    else
+        ui->lnStatus->setText(QStringLiteral("Unable to start reading"));
+}
+
+void mbClientMemoryImageUi::slotUpload()
+{
+    mbClientDevice *device = currentDevice();
+    if (!device)
+        return;
+    mbClientMemoryDump::Format format = static_cast<mbClientMemoryDump::Format>(ui->cmbFormat->currentIndex());
+    QString file = ui->lnFile->text();
+    if (!m_image->load(file, format, m_address->getAddress(), static_cast<uint32_t>(ui->spCount->value())))
+    {
+        ui->lnStatus->setText(QString("Unable to read image file '%1'").arg(file));
+        return;
+    }
+    mbClient *core = mbClient::global();
+    if (!core->isRunning())
+        core->start();
+    m_upload->setWindow(ui->spWindow->value());
+    m_upload->setRetries(ui->spRetries->value());
+    ui->progressBar->setValue(0);
+    if (m_upload->start(device, m_image, ui->chkVerify->isChecked()))
+        setEnableParams(false);
+    else
+        ui->lnStatus->setText(QStringLiteral("Unable to start upload (only coils and holding registers are writable)"));
+}
+
+void mbClientMemoryImageUi::slotStop()
+{
+    m_dump->stop();
+    m_upload->stop();
+}
+
+void mbClientMemoryImageUi::dumpProgress(uint32_t done, uint32_t total)
+{
+    ui->progressBar->setValue(total ? static_cast<int>(static_cast<quint64>(done) * 100 / total) : 100);
+}
+
+void mbClientMemoryImageUi::dumpFinished(bool success)
+{
+    setEnableParams(true);
+    QString status;
+    if (m_dump->failedBlocks())
+        status = QString("%1 block(s) failed (block size %2)").arg(m_dump->failedBlocks()).arg(m_dump->blockSize());
+    else if (success)
+        status = QString("Done (block size %1)").arg(m_dump->blockSize());
+    else
+        status = QStringLiteral("Stopped");
+    QString file = ui->lnFile->text();
+    if (!file.isEmpty() && (success || m_dump->failedBlocks()))
+    {
+        mbClientMemoryDump::Format format = static_cast<mbClientMemoryDump::Format>(ui->cmbFormat->currentIndex());
+        if (!m_dump->save(file, format))
+            status += QString(". Unable to write file '%1'").arg(file);
+    }
+    ui->lnStatus->setText(status);
+}
+
+void mbClientMemoryImageUi::uploadStateChanged(int state)
+{
+    switch (state)
+    {
+    case mbClientMemoryUpload::Reading:
+        ui->lnStatus->setText(QStringLiteral("Reading..."));
+        break;
+    case mbClientMemoryUpload::Writing:
+        ui->lnStatus->setText(QString("Writing %1 changed value(s)...").arg(m_upload->changedCount()));
+        break;
+    case mbClientMemoryUpload::Verifying:
+        ui->lnStatus->setText(QStringLiteral("Verifying..."));
+        break;
+    default:
+        break;
+    }
+    ui->progressBar->setValue(0);
+}
+
+void mbClientMemoryImageUi::uploadFinished(bool success)
+{
+    setEnableParams(true);
+    QString status = QString("%1 changed value(s) written with %2 request(s)").arg(m_upload->changedCount()).arg(m_upload->writeRequests());
+    if (m_upload->failedWrites())
+        status += QString(", %1 request(s) failed").arg(m_upload->failedWrites());
+    if (ui->chkVerify->isChecked() && m_upload->writeRequests())
+        status += QString(", %1 mismatch(es)").arg(m_upload->mismatches());
+    if (!success && !m_upload->failedWrites() && !m_upload->mismatches())
+        status = QStringLiteral("Stopped");
+    ui->lnStatus->setText(status);
+}
+
+mbClientDevice *mbClientMemoryImageUi::currentDevice() const
+{
+    if (m_project)
+    {
+        int i = ui->cmbDevice->currentIndex();
+        return m_project->device(i);
+    }
+    return nullptr;
+}
+
+void mbClientMemoryImageUi::setEnableParams(bool enable)
+{
+    ui->grParams ->setEnabled(enable);
+    ui->btnDump  ->setEnabled(enable);
+    ui->btnUpload->setEnabled(enable);
+    ui->btnStop  ->setEnabled(!enable);
+}
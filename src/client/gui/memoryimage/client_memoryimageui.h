@@ -0,0 +1,103 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_MEMORYIMAGEUI_H
+#define CLIENT_MEMORYIMAGEUI_H
+
+#include <gui/dialogs/core_dialogbase.h>
+#include <client_global.h>
+
+class mbCoreProject;
+class mbCoreDevice;
+class mbCoreAddressWidget;
+
+class mbClientProject;
+class mbClientDevice;
+class mbClientMemoryDump;
+class mbClientMemoryUpload;
+
+namespace Ui {
+class mbClientMemoryImageUi;
+}
+
+class mbClientMemoryImageUi : public mbCoreDialogBase
+{
+    Q_OBJECT
+
+public:
+    struct Strings : public mbCoreDialogBase::Strings
+    {
+        const QString prefix ;
+        const QString address;
+        const QString count  ;
+        const QString window ;
+        const QString retries;
+        const QString format ;
+        const QString file   ;
+        const QString verify ;
+        Strings();
+        static const Strings &instance();
+    };
+
+public:
+    explicit mbClientMemoryImageUi(QWidget *parent = nullptr);
+    ~mbClientMemoryImageUi();
+
+public:
+    MBSETTINGS cachedSettings() const override;
+    void setCachedSettings(const MBSETTINGS &settings) override;
+
+private Q_SLOTS:
+    void setProject(mbCoreProject *p);
+    void addDevice(mbCoreDevice *device);
+    void removeDevice(mbCoreDevice *device);
+    void renameDevice(mbCoreDevice *device, const QString newName);
+    void setRunStatus(int status);
+
+private Q_SLOTS:
+    void slotBrowse();
+    void slotDump();
+    void slotUpload();
+    void slotStop();
+
+private Q_SLOTS:
+    void dumpProgress(uint32_t done, uint32_t total);
+    void dumpFinished(bool success);
+    void uploadStateChanged(int state);
+    void uploadFinished(bool success);
+
+private:
+    mbClientDevice *currentDevice() const;
+    void setEnableParams(bool enable);
+
+private:
+    Ui::mbClientMemoryImageUi *ui;
+    mbCoreAddressWidget *m_address;
+
+private:
+    mbClientProject *m_project;
+    mbClientMemoryDump *m_dump;
+    mbClientMemoryDump *m_image;
+    mbClientMemoryUpload *m_upload;
+};
+
+#endif // CLIENT_MEMORYIMAGEUI_H
@@ -0,0 +1,297 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_memoryupload.h"
+
+#include <client.h>
+
+#include <project/client_device.h>
+
+#include <runtime/client_runmessage.h>
+
+mbClientMemoryUpload::mbClientMemoryUpload(QObject *parent) : QObject(parent)
+{
+    m_device = nullptr;
+    m_image = nullptr;
+    m_reader = new mbClientMemoryDump(this);
+    m_state = Idle;
+    m_verify = false;
+    m_window = mbClientMemoryDump::DefaultWindow;
+    m_retries = mbClientMemoryDump::DefaultRetries;
+    m_mergeGap = DefaultMergeGap;
+    m_changedCount = 0;
+    m_total = 0;
+    m_done = 0;
+    m_writeRequests = 0;
+    m_failedWrites = 0;
+    m_mismatches = 0;
+
+    connect(m_reader, &mbClientMemoryDump::progress, this, &mbClientMemoryUpload::progress    );
+    connect(m_reader, &mbClientMemoryDump::finished, this, &mbClientMemoryUpload::readFinished);
+}
+
+mbClientMemoryUpload::~mbClientMemoryUpload()
+{
+    stop();
+}
+
+bool mbClientMemoryUpload::start(mbClientDevice *device, const mbClientMemoryDump *image, bool verify)
+{
+    if (isRunning() || !device || !image || !image->count())
+        return false;
+    switch (image->memoryType())
+    {
+    case Modbus::Memory_0x:
+    case Modbus::Memory_4x:
+        break;
+    default:
+        return false;
+    }
+    m_device = device;
+    m_image = image;
+    m_verify = verify;
+    m_spans.clear();
+    m_pending.clear();
+    m_inflight.clear();
+    m_changedCount = 0;
+    m_writeRequests = 0;
+    m_failedWrites = 0;
+    m_mismatches = 0;
+    m_reader->setWindow(m_window);
+    m_reader->setRetries(m_retries);
+    setState(Reading);
+    if (!m_reader->start(device, image->address(), image->count()))
+    {
+        setState(Idle);
+        return false;
+    }
+    return true;
+}
+
+void mbClientMemoryUpload::stop()
+{
+    if (!isRunning())
+        return;
+    Q_FOREACH (const Request &r, m_inflight)
+        r.message->disconnect(this);
+    m_inflight.clear();
+    m_pending.clear();
+    setState(Idle);
+    m_reader->stop();
+    Q_EMIT finished(false);
+}
+
+void mbClientMemoryUpload::readFinished(bool /*success*/)
+{
+    // Note: values not read from device are considered changed (while reading)
+    //       or mismatched (while verifying), so failed read blocks are not fatal
+    switch (m_state)
+    {
+    case Reading:
+        diff();
+        if (m_pending.isEmpty())
+        {
+            finish(true);
+            return;
+        }
+        setState(Writing);
+        fillWindow();
+        break;
+    case Verifying:
+        Q_FOREACH (const Span &s, m_spans)
+        {
+            for (uint32_t i = s.index; i < s.index + s.count; i++)
+            {
+                uint32_t ri = i - m_spans.first().index;
+                if (!m_reader->isValid(ri) || (m_reader->value(ri) != m_image->value(i)))
+                    m_mismatches++;
+            }
+        }
+        finish((m_failedWrites == 0) && (m_mismatches == 0));
+        break;
+    default:
+        break;
+    }
+}
+
+void mbClientMemoryUpload::messageCompleted()
+{
+    mbClientRunMessage *message = qobject_cast<mbClientRunMessage*>(sender());
+    if (!message || (m_state != Writing))
+        return;
+    int i;
+    for (i = 0; i < m_inflight.count(); i++)
+    {
+        if (m_inflight.at(i).message.data() == message)
+            break;
+    }
+    if (i == m_inflight.count())
+        return;
+    Request r = m_inflight.takeAt(i);
+    message->disconnect(this);
+    if (Modbus::StatusIsGood(message->status()))
+    {
+        m_done += r.span.count;
+        Q_EMIT progress(m_done, m_total);
+    }
+    else if (r.span.retries < m_retries)
+    {
+        r.span.retries++;
+        m_pending.prepend(r.span);
+    }
+    else
+    {
+        m_failedWrites++;
+        m_done += r.span.count;
+        Q_EMIT progress(m_done, m_total);
+    }
+    fillWindow();
+}
+
+void mbClientMemoryUpload::setState(State state)
+{
+    if (m_state != state)
+    {
+        m_state = state;
+        Q_EMIT stateChanged(state);
+    }
+}
+
+void mbClientMemoryUpload::diff()
+{
+    uint16_t maxCount;
+    if (m_image->memoryType() == Modbus::Memory_0x)
+        maxCount = qMin<uint16_t>(m_device->maxWriteMultipleCoils(), MB_MAX_DISCRETS);
+    else
+        maxCount = qMin<uint16_t>(m_device->maxWriteMultipleRegisters(), MB_MAX_REGISTERS);
+    if (maxCount == 0)
+        maxCount = 1;
+
+    uint32_t count = m_image->count();
+    bool open = false;
+    uint32_t begin = 0;
+    uint32_t end = 0; // index after last changed value of the current span
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!m_image->isValid(i))
+            continue;
+        if (m_reader->isValid(i) && (m_reader->value(i) == m_image->value(i)))
+            continue;
+        m_changedCount++;
+        if (open)
+        {
+            // Note: gap values are rewritten with the same value, so it's allowed
+            //       to merge spans only when whole gap is defined in the image
+            bool merge = (i - end <= m_mergeGap) && (i + 1 - begin <= maxCount);
+            for (uint32_t j = end; merge && (j < i); j++)
+                merge = m_image->isValid(j);
+            if (merge)
+            {
+                end = i + 1;
+                continue;
+            }
+            Span s;
+            s.index = begin;
+            s.count = static_cast<uint16_t>(end - begin);
+            s.retries = 0;
+            m_spans.append(s);
+        }
+        open = true;
+        begin = i;
+        end = i + 1;
+    }
+    if (open)
+    {
+        Span s;
+        s.index = begin;
+        s.count = static_cast<uint16_t>(end - begin);
+        s.retries = 0;
+        m_spans.append(s);
+    }
+    m_pending = m_spans;
+    m_total = 0;
+    Q_FOREACH (const Span &s, m_spans)
+        m_total += s.count;
+    m_done = 0;
+}
+
+mbClientRunMessage *mbClientMemoryUpload::createMessage(const Span &span) const
+{
+    uint16_t offset = static_cast<uint16_t>(m_image->offset() + span.index);
+    mbClientRunMessage *message;
+    if (m_image->memoryType() == Modbus::Memory_0x)
+    {
+        uint32_t c;
+        QByteArray bits(static_cast<int>((span.count + 7) / 8), '\0');
+        Modbus::readMemBits(span.index, span.count, bits.data(), m_image->data().constData(), m_image->count(), &c);
+        message = new mbClientRunMessageWriteMultipleCoils(offset, span.count, span.count);
+        message->setData(0, span.count, bits.constData());
+    }
+    else
+    {
+        message = new mbClientRunMessageWriteMultipleRegisters(offset, span.count, span.count);
+        message->setData(0, span.count, reinterpret_cast<const uint16_t*>(m_image->data().constData()) + span.index);
+    }
+    return message;
+}
+
+void mbClientMemoryUpload::sendSpan(const Span &span)
+{
+    Request r;
+    r.message = createMessage(span);
+    r.span = span;
+    connect(r.message.data(), &mbClientRunMessage::completed, this, &mbClientMemoryUpload::messageCompleted);
+    m_inflight.append(r);
+    m_writeRequests++;
+    mbClient::global()->sendMessage(m_device->handle(), r.message);
+}
+
+void mbClientMemoryUpload::fillWindow()
+{
+    while (m_pending.count() && (m_inflight.count() < m_window))
+        sendSpan(m_pending.takeFirst());
+    if ((m_state == Writing) && m_inflight.isEmpty() && m_pending.isEmpty())
+    {
+        if (m_verify)
+            verify();
+        else
+            finish(m_failedWrites == 0);
+    }
+}
+
+void mbClientMemoryUpload::verify()
+{
+    // Note: only the range between first and last written values is read back
+    const Span &first = m_spans.first();
+    const Span &last = m_spans.last();
+    mb::Address adr = m_image->address();
+    adr.setOffset(static_cast<uint16_t>(m_image->offset() + first.index));
+    setState(Verifying);
+    if (!m_reader->start(m_device, adr, last.index + last.count - first.index))
+        finish(false);
+}
+
+void mbClientMemoryUpload::finish(bool success)
+{
+    setState(Idle);
+    Q_EMIT finished(success);
+}
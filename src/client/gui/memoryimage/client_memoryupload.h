@@ -0,0 +1,131 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_MEMORYUPLOAD_H
+#define CLIENT_MEMORYUPLOAD_H
+
+#include "client_memorydump.h"
+
+/*
+   Writes memory image into the device changing as few values as possible:
+   1. Reads current device memory of the image range (using mbClientMemoryDump).
+   2. Compares it with the image and writes only changed spans. Spans separated
+      by short gap of unchanged values are merged, so the whole range is written
+      with the least number of FC15/FC16 requests within device 'maxWriteMultiple*'.
+   3. Optionally reads written range back and counts mismatched values.
+*/
+class mbClientMemoryUpload : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum State
+    {
+        Idle,
+        Reading,
+        Writing,
+        Verifying
+    };
+    Q_ENUM(State)
+
+    enum Constants
+    {
+        DefaultMergeGap = 8
+    };
+
+public:
+    explicit mbClientMemoryUpload(QObject *parent = nullptr);
+    ~mbClientMemoryUpload();
+
+public:
+    inline State state() const { return m_state; }
+    inline bool isRunning() const { return m_state != Idle; }
+    inline int window() const { return m_window; }
+    inline void setWindow(int window) { m_window = qMax(window, 1); }
+    inline int retries() const { return m_retries; }
+    inline void setRetries(int retries) { m_retries = qMax(retries, 0); }
+    inline uint16_t mergeGap() const { return m_mergeGap; }
+    inline void setMergeGap(uint16_t gap) { m_mergeGap = gap; }
+
+public:
+    inline uint32_t changedCount() const { return m_changedCount; }
+    inline int writeRequests() const { return m_writeRequests; }
+    inline int failedWrites() const { return m_failedWrites; }
+    inline uint32_t mismatches() const { return m_mismatches; }
+
+public:
+    bool start(mbClientDevice *device, const mbClientMemoryDump *image, bool verify);
+    void stop();
+
+Q_SIGNALS:
+    void stateChanged(int state);
+    void progress(uint32_t done, uint32_t total);
+    void finished(bool success);
+
+private Q_SLOTS:
+    void readFinished(bool success);
+    void messageCompleted();
+
+private:
+    struct Span
+    {
+        uint32_t index; // index of the first value of the span in the image
+        uint16_t count;
+        int retries;
+    };
+
+    struct Request
+    {
+        mbClientRunMessagePtr message;
+        Span span;
+    };
+
+private:
+    void setState(State state);
+    void diff();
+    mbClientRunMessage *createMessage(const Span &span) const;
+    void sendSpan(const Span &span);
+    void fillWindow();
+    void verify();
+    void finish(bool success);
+
+private:
+    mbClientDevice *m_device;
+    const mbClientMemoryDump *m_image;
+    mbClientMemoryDump *m_reader;
+    State m_state;
+    bool m_verify;
+    int m_window;
+    int m_retries;
+    uint16_t m_mergeGap;
+    QList<Span> m_spans;
+    QList<Span> m_pending;
+    QList<Request> m_inflight;
+    uint32_t m_changedCount;
+    uint32_t m_total;
+    uint32_t m_done;
+    int m_writeRequests;
+    int m_failedWrites;
+    uint32_t m_mismatches;
+};
+
+#endif // CLIENT_MEMORYUPLOAD_H
@@ -0,0 +1,12 @@
+FORMS += \
+    $$PWD/client_memoryimageui.ui
+
+HEADERS += \
+    $$PWD/client_memorydump.h \
+    $$PWD/client_memoryimageui.h \
+    $$PWD/client_memoryupload.h
+
+SOURCES += \
+    $$PWD/client_memorydump.cpp \
+    $$PWD/client_memoryimageui.cpp \
+    $$PWD/client_memoryupload.cpp
@@ -1,6 +1,8 @@
 #include "client_dialogscannerhost.h"
 #include "ui_client_dialogscannerhost.h"
 
+#include "client_scannerhosts.h"
+
 mbClientDialogScannerHost::Strings::Strings() :
     title(QStringLiteral("Edit hosts")),
     cachePrefix(QStringLiteral("Ui.Dialogs.Scanner.Hosts")),
@@ -27,6 +29,7 @@ mbClientDialogScannerHost::mbClientDialogScannerHost(QWidget *parent) :
     ui->lnIPAddrStart->setText("192.168.1.1");
     ui->lnIPAddrEnd  ->setText("192.168.1.2");
     ui->lnSingleHost ->setText(md.host);
+    ui->lnSingleHost ->setToolTip(QStringLiteral("Host name, IP address, CIDR block (e.g. 192.168.1.0/24) or IP range (e.g. 192.168.1.1-50)"));
 
     connect(ui->btnAddRange , &QPushButton::clicked, this, &mbClientDialogScannerHost::slotAddRange );
     connect(ui->btnAddSingle, &QPushButton::clicked, this, &mbClientDialogScannerHost::slotAddSingle);
@@ -129,49 +132,19 @@ void mbClientDialogScannerHost::fillData(QStringList &hosts)
 
 void mbClientDialogScannerHost::slotAddRange()
 {
-    auto parseIPv4 = [](const QString &s, quint32 &out) -> bool
-    {
-        const QString trimmed = s.trimmed();
-        const QStringList parts = trimmed.split('.');
-        if (parts.size() != 4)
-            return false;
-        quint32 ip = 0;
-        for (int i = 0; i < 4; ++i) 
-        {
-            bool ok = false;
-            const int val = parts[i].toInt(&ok);
-            if (!ok || val < 0 || val > 255)
-                return false;
-            ip = (ip << 8) | static_cast<quint32>(val);
-        }
-        out = ip;
-        return true;
-    };
-
-    auto ipv4ToString = [](quint32 ip) -> QString
-    {
-        return QString("%1.%2.%3.%4")
-               .arg((ip >> 24) & 0xFF)
-               .arg((ip >> 16) & 0xFF)
-               .arg((ip >> 8) & 0xFF)
-               .arg(ip & 0xFF);
-    };
-
-    QString ipstart = ui->lnIPAddrStart->text();
-    QString ipend = ui->lnIPAddrEnd->text();
+    QString ipstart = ui->lnIPAddrStart->text().trimmed();
+    QString ipend = ui->lnIPAddrEnd->text().trimmed();
 
     quint32 start = 0, end = 0;
-    if (!parseIPv4(ipstart, start))
+    if (!mbClientScannerHosts::parseIPv4(ipstart, start))
         return;
-    if (!parseIPv4(ipend, end))
+    if (!mbClientScannerHosts::parseIPv4(ipend, end))
         return;
-    quint32 inc = (start > end) ? static_cast<quint32>(-1) : 1;
-    for (quint32 ip = start;; ip += inc)
-    {
-        ui->lsCurrent->addItem(ipv4ToString(ip));
-        if (ip == end)
-            break;
-    }
+    // Note: range is kept as single entry and expanded by scanner on demand
+    if (start == end)
+        ui->lsCurrent->addItem(ipstart);
+    else
+        ui->lsCurrent->addItem(QString("%1-%2").arg(ipstart, ipend));
 }
 
 void mbClientDialogScannerHost::slotAddSingle()
@@ -5,6 +5,8 @@
 #include <project/client_port.h>
 #include <project/client_device.h>
 
+#include <QCryptographicHash>
+
 #include "client_scannerthread.h"
 
 #define MBCLIENTSCANNER_GET_SETTING_MACRO(type, name, assign)                                \
@@ -27,6 +29,16 @@ uint32_t mbClientScanner::getSettingPeriod(const Modbus::Settings &s, bool *ok)
     MBCLIENTSCANNER_GET_SETTING_MACRO(uint32_t, period, v = static_cast<uint32_t>(var.toUInt(&okInner)))
 }
 
+int mbClientScanner::getSettingConcurrency(const Modbus::Settings &s, bool *ok)
+{
+    MBCLIENTSCANNER_GET_SETTING_MACRO(int, concurrency, v = var.toInt(&okInner))
+}
+
+bool mbClientScanner::getSettingConnectProbe(const Modbus::Settings &s, bool *ok)
+{
+    MBCLIENTSCANNER_GET_SETTING_MACRO(bool, connectProbe, v = var.toBool(); okInner = true)
+}
+
 uint8_t mbClientScanner::getSettingUnitStart(const Modbus::Settings &s, bool *ok)
 {
     MBCLIENTSCANNER_GET_SETTING_MACRO(uint8_t, unitStart, v = static_cast<uint8_t>(var.toUInt(&okInner)))
@@ -77,6 +89,16 @@ void mbClientScanner::setSettingPeriod(Modbus::Settings &s, uint32_t v)
     s[mbClientScanner::Strings::instance().period] = v;
 }
 
+void mbClientScanner::setSettingConcurrency(Modbus::Settings &s, int v)
+{
+    s[mbClientScanner::Strings::instance().concurrency] = v;
+}
+
+void mbClientScanner::setSettingConnectProbe(Modbus::Settings &s, bool v)
+{
+    s[mbClientScanner::Strings::instance().connectProbe] = v;
+}
+
 void mbClientScanner::setSettingUnitStart(Modbus::Settings &s, uint8_t v)
 {
     s[mbClientScanner::Strings::instance().unitStart] = v;
@@ -122,6 +144,31 @@ void mbClientScanner::setSettingRequest(Modbus::Settings &s, const Request_t &re
     s[mbClientScanner::Strings::instance().request] = toString(req);
 }
 
+QString mbClientScanner::scanKey(const Modbus::Settings &s)
+{
+    // Note: settings that don't change the set and the order of scanned combinations
+    //       (e.g. timeouts or concurrency) are not part of the key, so they can be changed before resume
+    const Strings &ss = Strings::instance();
+    QStringList names = s.keys();
+    names.removeAll(ss.period);
+    names.removeAll(ss.concurrency);
+    names.removeAll(ss.connectProbe);
+    names.removeAll(ss.timeout);
+    names.removeAll(ss.tries);
+    names.sort();
+    QByteArray data;
+    Q_FOREACH (const QString &name, names)
+    {
+        const QVariant &v = s.value(name);
+        QString value = (v.type() == QVariant::List) ? v.toStringList().join(',') : v.toString();
+        data.append(name.toUtf8());
+        data.append('=');
+        data.append(value.toUtf8());
+        data.append('\n');
+    }
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex());
+}
+
 QString mbClientScanner::toShortParityStr(Modbus::Parity v)
 {
     switch (v)
@@ -200,6 +247,8 @@ mbClientScanner::Strings::Strings() :
     name          (QStringLiteral("Scanner")),
     type          (Modbus::Strings::instance().type),
     period        (QStringLiteral("period")),
+    concurrency   (QStringLiteral("concurrency")),
+    connectProbe  (QStringLiteral("connectProbe")),
     timeout       (Modbus::Strings::instance().timeout),
     tries         (QStringLiteral("tries")),
     unitStart     (QStringLiteral("unitStart")),
@@ -219,6 +268,8 @@ const mbClientScanner::Strings &mbClientScanner::Strings::instance()
 mbClientScanner::Defaults::Defaults() :
     type            (Modbus::Defaults::instance().type),
     period          (200),
+    concurrency     (32),
+    connectProbe    (true),
     timeout         (1000),
     timeoutInterByte(Modbus::Defaults::instance().timeoutInterByte),
     tries           (Modbus::Defaults::instance().tries),
@@ -256,6 +307,7 @@ mbClientScanner::DeviceInfo::DeviceInfo()
 mbClientScanner::mbClientScanner(QObject *parent)
     : QObject{parent}
 {
+    m_checkpoint = 0;
     m_thread = new mbClientScannerThread(this);
     connect(m_thread, &QThread::started, this, &mbClientScanner::threadStarted);
     connect(m_thread, &QThread::finished, this, &mbClientScanner::threadFinished);
@@ -363,15 +415,58 @@ void mbClientScanner::clear()
     Q_EMIT cleared();
 }
 
-void mbClientScanner::startScanning(const Modbus::Settings &settings)
+void mbClientScanner::startScanning(const Modbus::Settings &settings, bool resume)
 {
     if (!m_thread->isRunning())
     {
+        QString key = scanKey(settings);
+        m_lock.lockForWrite();
+        if (!resume || (m_checkpointKey != key))
+            m_checkpoint = 0;
+        m_checkpointKey = key;
+        quint32 checkpoint = m_checkpoint;
+        m_lock.unlock();
         m_thread->setSettings(settings);
+        m_thread->setCheckpoint(checkpoint);
         m_thread->start();
     }
 }
 
+quint32 mbClientScanner::checkpoint() const
+{
+    QReadLocker _(&m_lock);
+    return m_checkpoint;
+}
+
+QString mbClientScanner::checkpointKey() const
+{
+    QReadLocker _(&m_lock);
+    return m_checkpointKey;
+}
+
+bool mbClientScanner::canResume(const Modbus::Settings &settings) const
+{
+    QReadLocker _(&m_lock);
+    return m_checkpoint && (m_checkpointKey == scanKey(settings));
+}
+
+void mbClientScanner::restoreCheckpoint(const QString &key, quint32 checkpoint)
+{
+    m_lock.lockForWrite();
+    m_checkpointKey = key;
+    m_checkpoint = checkpoint;
+    m_lock.unlock();
+    Q_EMIT checkpointChanged(checkpoint);
+}
+
+void mbClientScanner::setCheckpoint(quint32 checkpoint)
+{
+    m_lock.lockForWrite();
+    m_checkpoint = checkpoint;
+    m_lock.unlock();
+    Q_EMIT checkpointChanged(checkpoint);
+}
+
 void mbClientScanner::stopScanning()
 {
     m_thread->stop();
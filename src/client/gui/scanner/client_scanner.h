@@ -36,6 +36,8 @@ public:
 
 public:
     static uint32_t     getSettingPeriod   (const Modbus::Settings &s, bool *ok = nullptr);
+    static int          getSettingConcurrency(const Modbus::Settings &s, bool *ok = nullptr);
+    static bool         getSettingConnectProbe(const Modbus::Settings &s, bool *ok = nullptr);
     static uint8_t      getSettingUnitStart(const Modbus::Settings &s, bool *ok = nullptr);
     static uint8_t      getSettingUnitEnd  (const Modbus::Settings &s, bool *ok = nullptr);
     static QVariantList getSettingHost     (const Modbus::Settings &s, bool *ok = nullptr);
@@ -47,6 +49,8 @@ public:
     static Request_t    getSettingRequest  (const Modbus::Settings &s, bool *ok = nullptr);
 
     static void setSettingPeriod   (Modbus::Settings &s, uint32_t v           );
+    static void setSettingConcurrency(Modbus::Settings &s, int v              );
+    static void setSettingConnectProbe(Modbus::Settings &s, bool v            );
     static void setSettingUnitStart(Modbus::Settings &s, uint8_t v            );
     static void setSettingUnitEnd  (Modbus::Settings &s, uint8_t v            );
     static void setSettingHost     (Modbus::Settings &s, const QVariantList &v);
@@ -57,6 +61,7 @@ public:
     static void setSettingStopBits (Modbus::Settings &s, const QVariantList &v);
     static void setSettingRequest  (Modbus::Settings &s, const Request_t &req );
 
+    static QString scanKey(const Modbus::Settings &s);
     static QString toShortParityStr(Modbus::Parity v);
     static QString toShortStopBitsStr(Modbus::StopBits v);
 
@@ -66,6 +71,8 @@ public:
         const QString name          ;
         const QString type          ;
         const QString period        ;
+        const QString concurrency   ;
+        const QString connectProbe  ;
         const QString timeout       ;
         const QString tries         ;
         const QString unitStart     ;
@@ -82,6 +89,8 @@ public:
     {
         const Modbus::ProtocolType type     ;
         const uint32_t             period   ;
+        const int                  concurrency;
+        const bool                 connectProbe;
         const uint32_t             timeout  ;
         const uint32_t             timeoutInterByte;
         const uint32_t             tries    ;
@@ -145,8 +154,13 @@ public:
 public:
     void addToProject(const QList<int> &indexes = QList<int>());
     void clear();
-    void startScanning(const Modbus::Settings &settings);
+    void startScanning(const Modbus::Settings &settings, bool resume = false);
     void stopScanning();
+    quint32 checkpoint() const;
+    QString checkpointKey() const;
+    bool canResume(const Modbus::Settings &settings) const;
+    void restoreCheckpoint(const QString &key, quint32 checkpoint);
+    void setCheckpoint(quint32 checkpoint);
     void setStatDevice(const QString &device);
     void setStatFound    (quint32 count);
     void setStatFunc     (const QString &func);
@@ -169,6 +183,7 @@ Q_SIGNALS:
     void statCountTxChanged(quint32 count);
     void statCountRxChanged(quint32 count);
     void statPercentChanged(quint32 percent);
+    void checkpointChanged(quint32 checkpoint);
 
 private Q_SLOTS:
     void threadStarted();
@@ -186,6 +201,8 @@ private:
     mutable QReadWriteLock m_lock;
     QList<DeviceInfo> m_deviceInfoList;
     mbClientScannerThread *m_thread;
+    QString m_checkpointKey;
+    quint32 m_checkpoint;
 
 private:
     struct Statistics
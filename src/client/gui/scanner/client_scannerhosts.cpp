@@ -0,0 +1,158 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_scannerhosts.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <climits>
+
+bool mbClientScannerHosts::parseIPv4(const QString &s, quint32 &out)
+{
+    const QStringList parts = s.trimmed().split('.');
+    if (parts.size() != 4)
+        return false;
+    quint32 ip = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        bool ok = false;
+        const int val = parts.at(i).toInt(&ok);
+        if (!ok || val < 0 || val > 255)
+            return false;
+        ip = (ip << 8) | static_cast<quint32>(val);
+    }
+    out = ip;
+    return true;
+}
+
+QString mbClientScannerHosts::toIPv4String(quint32 ip)
+{
+    return QString("%1.%2.%3.%4")
+           .arg((ip >> 24) & 0xFF)
+           .arg((ip >> 16) & 0xFF)
+           .arg((ip >> 8) & 0xFF)
+           .arg(ip & 0xFF);
+}
+
+mbClientScannerHosts::mbClientScannerHosts()
+{
+    m_count = 0;
+}
+
+mbClientScannerHosts::mbClientScannerHosts(const QVariantList &specs)
+{
+    setSpecs(specs);
+}
+
+void mbClientScannerHosts::setSpecs(const QVariantList &specs)
+{
+    m_ranges.clear();
+    m_count = 0;
+    m_ignored.clear();
+    Q_FOREACH (const QVariant &v, specs)
+    {
+        Range r;
+        QString spec = v.toString().trimmed();
+        if (spec.isEmpty())
+            continue;
+        // Note: total count is limited by 32-bit combination number
+        if (!parseSpec(spec, r) || (r.count > UINT_MAX - m_count))
+        {
+            m_ignored.append(spec);
+            continue;
+        }
+        r.offset = m_count;
+        m_ranges.append(r);
+        m_count += r.count;
+    }
+}
+
+QString mbClientScannerHosts::host(quint32 index) const
+{
+    if (index >= m_count)
+        return QString();
+    auto it = std::upper_bound(m_ranges.constBegin(), m_ranges.constEnd(), index,
+                               [](quint32 i, const Range &r) { return i < r.offset; });
+    const Range &r = *(it - 1);
+    if (!r.host.isEmpty())
+        return r.host;
+    quint32 i = index - r.offset;
+    return toIPv4String(r.desc ? r.first - i : r.first + i);
+}
+
+bool mbClientScannerHosts::parseSpec(const QString &spec, Range &r) const
+{
+    if (spec.isEmpty())
+        return false;
+    r.first = 0;
+    r.count = 1;
+    r.desc  = false;
+    int i = spec.indexOf('/');
+    if (i > 0)
+    {
+        quint32 ip;
+        bool ok;
+        int prefix = spec.mid(i+1).toInt(&ok);
+        if (ok && (prefix >= MinPrefix) && (prefix <= 32) && parseIPv4(spec.left(i), ip))
+        {
+            quint32 size = static_cast<quint32>(1) << (32 - prefix);
+            r.first = ip & ~(size - 1);
+            r.count = size;
+            // Note: network and broadcast addresses are skipped if there is any host address between them
+            if (size > 2)
+            {
+                r.first += 1;
+                r.count -= 2;
+            }
+            return true;
+        }
+    }
+    i = spec.indexOf('-');
+    if (i > 0)
+    {
+        quint32 start, end;
+        if (parseIPv4(spec.left(i), start))
+        {
+            QString sEnd = spec.mid(i+1).trimmed();
+            bool ok = parseIPv4(sEnd, end);
+            if (!ok)
+            {
+                // Note: short form, e.g. '192.168.1.1-50' where only last byte is specified
+                int last = sEnd.toInt(&ok);
+                ok = ok && (last >= 0) && (last <= 255);
+                end = (start & 0xFFFFFF00) | static_cast<quint32>(last);
+            }
+            if (ok)
+            {
+                r.first = start;
+                r.desc  = start > end;
+                r.count = (r.desc ? start - end : end - start) + 1;
+                if (r.count == 0) // whole IPv4 space
+                    r.count = UINT_MAX;
+                return true;
+            }
+        }
+    }
+    r.host = spec;
+    return true;
+}
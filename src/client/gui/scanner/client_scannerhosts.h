@@ -0,0 +1,75 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_SCANNERHOSTS_H
+#define CLIENT_SCANNERHOSTS_H
+
+#include <QVariantList>
+#include <QStringList>
+#include <QVector>
+
+/*
+   Lazy list of scanned hosts. Every entry of the host list can be a single host name,
+   CIDR block ('192.168.1.0/24') or IPv4 range ('192.168.1.1-192.168.1.50' or '192.168.1.1-50').
+   Ranges are never expanded in memory: host with specified index is calculated on demand.
+*/
+class mbClientScannerHosts
+{
+public:
+    // Note: smallest CIDR prefix accepted, wider networks are treated as single host name
+    enum { MinPrefix = 8 };
+
+public:
+    static bool parseIPv4(const QString &s, quint32 &out);
+    static QString toIPv4String(quint32 ip);
+
+public:
+    mbClientScannerHosts();
+    explicit mbClientScannerHosts(const QVariantList &specs);
+
+public:
+    void setSpecs(const QVariantList &specs);
+    inline quint32 count() const { return m_count; }
+    // Note: specs that can't be parsed or don't fit into 32-bit host count
+    inline QStringList ignoredSpecs() const { return m_ignored; }
+    QString host(quint32 index) const;
+
+private:
+    struct Range
+    {
+        quint32 offset; // index of the first host of this range within whole list
+        quint32 first ;
+        quint32 count ;
+        bool    desc  ;
+        QString host  ; // not empty for single host name
+    };
+
+private:
+    bool parseSpec(const QString &spec, Range &r) const;
+
+private:
+    QVector<Range> m_ranges;
+    quint32 m_count;
+    QStringList m_ignored;
+};
+
+#endif // CLIENT_SCANNERHOSTS_H
@@ -36,6 +36,17 @@ mbClientScannerThread::mbClientScannerThread(mbClientScanner *scanner, QObject *
 {
     m_scanner = scanner;
     m_ctrlRun = true;
+    m_concurrency = 1;
+    m_connectProbe = false;
+    m_timeout = 0;
+    m_hostIndex = -1;
+    m_filtered = false;
+    m_checkpoint = 0;
+    m_checkpointStart = 0;
+    m_combinationCount = 0;
+    m_combinationCountAll = 0;
+    m_funcCount = 0;
+    m_deviceFound = 0;
     m_unitStart = Modbus::VALID_MODBUS_ADDRESS_BEGIN;
     m_unitEnd = Modbus::VALID_MODBUS_ADDRESS_END;
     moveToThread(this);
@@ -51,6 +62,9 @@ void mbClientScannerThread::setSettings(const Modbus::Settings &settings)
 
     m_settings = settings;
     m_period    = mbClientScanner::getSettingPeriod   (settings);
+    m_concurrency = mbClientScanner::getSettingConcurrency(settings);
+    m_connectProbe = mbClientScanner::getSettingConnectProbe(settings);
+    m_timeout   = Modbus::getSettingTimeout(settings);
     m_unitStart = mbClientScanner::getSettingUnitStart(settings);
     m_unitEnd   = mbClientScanner::getSettingUnitEnd  (settings);
     m_request   = mbClientScanner::getSettingRequest  (settings);
@@ -60,17 +74,25 @@ void mbClientScannerThread::setSettings(const Modbus::Settings &settings)
     m_divMods   .clear();
     m_names     .clear();
     m_valuesList.clear();
+    m_hostIndex = -1;
+    // Note: combination number is 32-bit, so product of all value counts must fit into it
+    bool overflow = false;
 
-#define DEFINE_COMBINATION_ELEMENT(elem)            \
-        if (elem.count())                           \
-        {                                           \
-                DivMod dm;                          \
-                dm.div = m_combinationCount;        \
-                dm.mod = elem.count();              \
-                m_divMods.append(dm);               \
-                m_names.append(s.elem);             \
-                m_valuesList.append(elem);          \
-                m_combinationCount *= elem.count(); \
+#define DEFINE_COMBINATION_ELEMENT(elem)                                            \
+        if (elem.count())                                                           \
+        {                                                                           \
+            if (m_combinationCount > UINT_MAX / static_cast<quint32>(elem.count())) \
+                overflow = true;                                                    \
+            else                                                                    \
+            {                                                                       \
+                DivMod dm;                                                          \
+                dm.div = m_combinationCount;                                        \
+                dm.mod = elem.count();                                              \
+                m_divMods.append(dm);                                               \
+                m_names.append(s.elem);                                             \
+                m_valuesList.append(elem);                                          \
+                m_combinationCount *= elem.count();                                 \
+            }                                                                       \
         }
 
     Modbus::ProtocolType type = Modbus::getSettingType(settings);
@@ -91,15 +113,38 @@ void mbClientScannerThread::setSettings(const Modbus::Settings &settings)
     }
         break;
     default:
-        QVariantList host = mbClientScanner::getSettingHost(settings);
         QVariantList port = mbClientScanner::getSettingPort(settings);
-        
-        DEFINE_COMBINATION_ELEMENT(host)
+
+        // Note: host list may contain CIDR blocks and ranges, so hosts are calculated
+        //       on demand in 'setCombination' instead of keeping value list
+        m_hosts.setSpecs(mbClientScanner::getSettingHost(settings));
+        Q_FOREACH (const QString &spec, m_hosts.ignoredSpecs())
+            mbClient::LogWarning(mbClientScanner::Strings::instance().name, QString("Host '%1' is ignored: invalid or too many hosts to scan").arg(spec));
+        if (m_hosts.count())
+        {
+            DivMod dm;
+            dm.div = m_combinationCount;
+            dm.mod = m_hosts.count();
+            m_hostIndex = m_divMods.count();
+            m_divMods.append(dm);
+            m_names.append(s.host);
+            m_valuesList.append(QVariantList());
+            m_combinationCount *= m_hosts.count();
+        }
         DEFINE_COMBINATION_ELEMENT(port)
 
         break;
     }
-    m_combinationCountAll = m_combinationCount * (qAbs(m_unitEnd - m_unitStart) + 1) * m_request.count();
+    if (overflow)
+    {
+        mbClient::LogError(mbClientScanner::Strings::instance().name, QStringLiteral("Too many combinations to scan, reduce the number of hosts or other parameter values"));
+        m_combinationCount = 0;
+        m_divMods   .clear();
+        m_names     .clear();
+        m_valuesList.clear();
+        m_hostIndex = -1;
+    }
+    m_combinationCountAll = static_cast<quint64>(m_combinationCount) * (qAbs(m_unitEnd - m_unitStart) + 1) * m_request.count();
     m_statTx = 0;
     m_statRx = 0;
 }
@@ -108,70 +153,120 @@ void mbClientScannerThread::run()
 {
     const mbClientScanner::Strings &s = mbClientScanner::Strings::instance();
     m_ctrlRun = true;
+    if (m_checkpoint > m_combinationCount)
+        m_checkpoint = m_combinationCount;
+    m_checkpointStart = m_checkpoint;
+    quint64 funcPerCombination = static_cast<quint64>(qAbs(m_unitEnd - m_unitStart) + 1) * m_request.count();
+    // Note: combinations before checkpoint were completed by previous (stopped) scan
+    m_funcCount = m_checkpoint * funcPerCombination;
+    m_deviceFound = 0;
+    m_done.clear();
+    m_live.clear();
+    m_liveTimeouts.clear();
+    m_filtered = false;
     mbClient::LogInfo(s.name, QStringLiteral("Start scanning"));
-
-
-    Modbus::Settings settings = m_settings;
-    uint8_t dummy[MB_MAX_BYTES+1];
-    uint16_t *regdummy = reinterpret_cast<uint16_t*>(dummy);
-    memset(dummy, 0, sizeof(dummy));
-
-    quint32 deviceFound = 0;
-    quint32 funcCount = 0;
-    for (uint c = 0; m_ctrlRun && (c < m_combinationCount); c++)
+    if (m_checkpoint)
+        mbClient::LogInfo(s.name, QString("Resume scanning from combination %1 of %2").arg(QString::number(m_checkpoint), QString::number(m_combinationCount)));
+    Modbus::ProtocolType type = Modbus::getSettingType(m_settings);
+    if ((type == Modbus::TCP) && m_connectProbe)
     {
-        // Get comibation number for each setting
-        for (quint16 si = 0; si < m_names.count(); si++)
-        {
-            const QString &name = m_names.at(si);
-            const DivMod &dm = m_divMods.at(si);
-            // Calc value of each setting corresponding to current combination number
-            int sc = (c / dm.div) % dm.mod;
-            const QVariant &v = m_valuesList.at(si).at(sc);
-            settings[name] = v;
-        }
-        ModbusClientPort *clientPort = Modbus::createClientPort(settings, false);
-        QString sPort;
-        switch (clientPort->type())
-        {
-        case Modbus::ASC:
+        runConnectProbe();
+        m_combinationCountAll = (m_checkpointStart + static_cast<quint64>(m_live.count())) * funcPerCombination;
+        if (m_funcCount >= m_combinationCountAll)
+            m_scanner->setStatPercent(100);
+    }
+    switch (type)
+    {
+    case Modbus::TCP:
+    case Modbus::UDP:
+        if (m_concurrency > 1)
         {
-            ModbusAscPort *port = static_cast<ModbusAscPort*>(clientPort->port());
-            clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotAsciiTx);
-            clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotAsciiRx);
-            sPort = QString("ASC:%1:%2:%3%4%5")
-                        .arg(port->portName(),
-                             QString::number(port->baudRate()),
-                             QString::number(port->dataBits()),
-                             mbClientScanner::toShortParityStr(port->parity()),
-                             mbClientScanner::toShortStopBitsStr(port->stopBits()));
-        }
+            runConcurrent();
             break;
-        case Modbus::RTU:
-        {
-            ModbusRtuPort *port = static_cast<ModbusRtuPort*>(clientPort->port());
-            clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotBytesTx);
-            clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotBytesRx);
-            sPort = QString("RTU:%1:%2:%3%4%5")
-                        .arg(port->portName(),
-                             QString::number(port->baudRate()),
-                             QString::number(port->dataBits()),
-                             mbClientScanner::toShortParityStr(port->parity()),
-                             mbClientScanner::toShortStopBitsStr(port->stopBits()));
         }
-            break;
-        default:
+        runSequential();
+        break;
+    default:
+        // Note: serial port can't be shared, so serial combinations are always scanned one by one
+        runSequential();
+        break;
+    }
+    // Note: checkpoint is reset when scan is completed, so next scan starts from the beginning
+    if (m_ctrlRun)
+        m_scanner->setCheckpoint(0);
+    mbClient::LogInfo(s.name, QStringLiteral("Finish scanning"));
+}
+
+void mbClientScannerThread::runConnectProbe()
+{
+    const mbClientScanner::Strings &s = mbClientScanner::Strings::instance();
+    QVector<uint> live;
+    QVector<uint32_t> timeouts;
+    QList<ConnectProbe*> probes;
+    quint32 c = 0;
+    while (m_ctrlRun)
+    {
+        while ((probes.count() < m_concurrency) && (c < combinationCount()))
         {
-            ModbusNetPort *port = static_cast<ModbusNetPort*>(clientPort->port());
-            clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotBytesTx);
-            clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotBytesRx);
-            sPort = QString("%1:%2:%3")
-                        .arg(Modbus::sprotocolType(clientPort->type()),
-                             port->host(),
-                             QString::number(port->port()));
+            ConnectProbe *p = new ConnectProbe;
+            Modbus::Settings settings = m_settings;
+            p->combination = setCombination(c++, settings);
+            p->port = createPort(settings, p->sPort);
+            p->tmStart = mb::currentTimestamp();
+            probes.append(p);
         }
+        if (probes.isEmpty())
             break;
+        for (int i = 0; m_ctrlRun && (i < probes.count()); )
+        {
+            ConnectProbe *p = probes.at(i);
+            Modbus::StatusCode status = p->port->port()->open();
+            mb::Timestamp_t rtt = mb::currentTimestamp() - p->tmStart;
+            if (Modbus::StatusIsProcessing(status) && (rtt < static_cast<mb::Timestamp_t>(m_timeout)))
+            {
+                i++;
+                continue;
+            }
+            if (Modbus::StatusIsGood(status))
+            {
+                // Note: adapted timeout is never greater than the configured one
+                uint32_t timeout = static_cast<uint32_t>(qMax<mb::Timestamp_t>(rtt * RttFactor, MinAdaptiveTimeout));
+                live.append(p->combination);
+                timeouts.append(qMin(timeout, m_timeout));
+                mbClient::LogInfo(s.name, QString("'%1' is reachable (RTT=%2 ms)").arg(p->sPort, QString::number(rtt)));
+            }
+            else
+                combinationDone(p->combination);
+            probes.removeAt(i);
+            p->port->close();
+            delete p->port;
+            delete p;
         }
+        Modbus::msleep(1);
+    }
+    Q_FOREACH (ConnectProbe *p, probes)
+    {
+        p->port->close();
+        delete p->port;
+        delete p;
+    }
+    mbClient::LogInfo(s.name, QString("Connect probe: %1 of %2 endpoints are reachable").arg(QString::number(live.count()), QString::number(c)));
+    m_live = live;
+    m_liveTimeouts = timeouts;
+    m_filtered = true;
+}
+
+void mbClientScannerThread::runSequential()
+{
+    const mbClientScanner::Strings &s = mbClientScanner::Strings::instance();
+    Modbus::Settings settings = m_settings;
+    uint8_t dummy[MB_MAX_BYTES+1];
+
+    for (quint32 c = 0; m_ctrlRun && (c < combinationCount()); c++)
+    {
+        uint combination = setCombination(c, settings);
+        QString sPort;
+        ModbusClientPort *clientPort = createPort(settings, sPort);
         mbClient::LogInfo(s.name, QString("Begin scanning '%1'").arg(sPort));
         for (int unit = m_unitStart;; unit+=m_unitInc)
         {
@@ -180,147 +275,22 @@ void mbClientScannerThread::run()
             QString sPortUnit = QString("%1,Unit=%2").arg(sPort, QString::number(unit));
             clientPort->setObjectName(sPortUnit.toLatin1().constData());
             m_scanner->setStatDevice(sPortUnit);
-            Modbus::StatusCode status = Modbus::Status_Bad;
             bool deviceIsFound = false;
             Q_FOREACH (auto &f, m_request)
             {
+                Modbus::StatusCode status = Modbus::Status_Bad;
                 memset(dummy, 0, sizeof(dummy));
                 m_scanner->setFunctionBegin(sPort, static_cast<uint8_t>(unit), f);
                 auto tmend = mb::currentTimestamp() + m_period;
                 while (m_ctrlRun)
                 {
-                    switch (f.function())
-                    {
-                    case MBF_READ_COILS:
-                        status = clientPort->readCoils(static_cast<uint8_t>(unit), f.offset(), f.count(), dummy);
-                        break;
-                    case MBF_READ_DISCRETE_INPUTS:
-                        status = clientPort->readDiscreteInputs(static_cast<uint8_t>(unit), f.offset(), f.count(), dummy);
-                        break;
-                    case MBF_READ_HOLDING_REGISTERS:
-                        status = clientPort->readHoldingRegisters(static_cast<uint8_t>(unit), f.offset(), f.count(), regdummy);
-                        break;
-                    case MBF_READ_INPUT_REGISTERS:
-                        status = clientPort->readInputRegisters(static_cast<uint8_t>(unit), f.offset(), f.count(), regdummy);
-                        break;
-                    case MBF_WRITE_SINGLE_COIL:
-                        status = clientPort->writeSingleCoil(static_cast<uint8_t>(unit), f.offset(), 0);
-                        break;
-                    case MBF_WRITE_SINGLE_REGISTER:
-                        status = clientPort->writeSingleRegister(static_cast<uint8_t>(unit), f.offset(), 0);
-                        break;
-                    case MBF_READ_EXCEPTION_STATUS:
-                        status = clientPort->readExceptionStatus(static_cast<uint8_t>(unit), dummy);
-                        break;
-                    case MBF_DIAGNOSTICS:
-                        switch (f.subfunction())
-                        {
-                        case MBF_DIAGNOSTICS_RETURN_QUERY_DATA:
-                            status = clientPort->diagnosticsReturnQueryData(static_cast<uint8_t>(unit), dummy, 2, &dummy[1], dummy);
-                            break;
-                        case MBF_DIAGNOSTICS_RESTART_COMMUNICATIONS_OPTION:
-                            status = clientPort->diagnosticsRestartCommunicationsOption(static_cast<uint8_t>(unit), dummy[0]);
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_DIAGNOSTIC_REGISTER:
-                            status = clientPort->diagnosticsReturnDiagnosticRegister(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_CHANGE_ASCII_INPUT_DELIMITER:
-                            status = clientPort->diagnosticsChangeAsciiInputDelimiter(static_cast<uint8_t>(unit), dummy[0]);
-                            break;
-                        case MBF_DIAGNOSTICS_FORCE_LISTEN_ONLY_MODE:
-                            status = clientPort->diagnosticsForceListenOnlyMode(static_cast<uint8_t>(unit));
-                            break;
-                        case MBF_DIAGNOSTICS_CLEAR_COUNTERS_AND_DIAGNOSTIC_REGISTER:
-                            status = clientPort->diagnosticsClearCountersAndDiagnosticRegister(static_cast<uint8_t>(unit));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_BUS_MESSAGE_COUNT:
-                            status = clientPort->diagnosticsReturnBusMessageCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_BUS_COMMUNICATION_ERROR_COUNT:
-                            status = clientPort->diagnosticsReturnBusCommunicationErrorCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_BUS_EXCEPTION_ERROR_COUNT:
-                            status = clientPort->diagnosticsReturnBusExceptionErrorCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_SERVER_MESSAGE_COUNT:
-                            status = clientPort->diagnosticsReturnServerMessageCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_SERVER_NO_RESPONSE_COUNT:
-                            status = clientPort->diagnosticsReturnServerNoResponseCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_SERVER_NAK_COUNT:
-                            status = clientPort->diagnosticsReturnServerNAKCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_SERVER_BUSY_COUNT:
-                            status = clientPort->diagnosticsReturnServerBusyCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_RETURN_BUS_CHARACTER_OVERRUN_COUNT:
-                            status = clientPort->diagnosticsReturnBusCharacterOverrunCount(static_cast<uint8_t>(unit), reinterpret_cast<uint16_t*>(dummy));
-                            break;
-                        case MBF_DIAGNOSTICS_CLEAR_OVERRUN_COUNTER_AND_FLAG:
-                            status = clientPort->diagnosticsClearOverrunCounterAndFlag(static_cast<uint8_t>(unit));
-                            break;
-                        default:
-                            status = Modbus::Status_BadIllegalFunction;
-                            break;
-                        }
-                        break;
-                    case MBF_GET_COMM_EVENT_COUNTER:
-                        status = clientPort->getCommEventCounter(static_cast<uint8_t>(unit), &regdummy[0], &regdummy[1]);
-                        break;
-                    case MBF_GET_COMM_EVENT_LOG:
-                        status = clientPort->getCommEventLog(static_cast<uint8_t>(unit), &regdummy[0], &regdummy[1], &regdummy[2], &dummy[7], &dummy[6]);
-                        break;
-                    case MBF_WRITE_MULTIPLE_COILS:
-                        status = clientPort->writeMultipleCoils(static_cast<uint8_t>(unit), f.offset(), f.count(), dummy);
-                        break;
-                    case MBF_WRITE_MULTIPLE_REGISTERS:
-                        status = clientPort->writeMultipleRegisters(static_cast<uint8_t>(unit), f.offset(), f.count(), regdummy);
-                        break;
-                    case MBF_REPORT_SERVER_ID:
-                        status = clientPort->reportServerID(static_cast<uint8_t>(unit), &dummy[1], &dummy[0]);
-                        break;
-                    case MBF_READ_FILE_RECORD:
-                        status = clientPort->readFileRecord(static_cast<uint8_t>(unit), f.fileRecords().data(), f.fileRecords().count(), &dummy[1], &dummy[0]);
-                        break;
-                    case MBF_MASK_WRITE_REGISTER:
-                        status = clientPort->maskWriteRegister(static_cast<uint8_t>(unit), f.offset(), 0, 0);
-                        break;
-                    case MBF_READ_WRITE_MULTIPLE_REGISTERS:
-                        status = clientPort->readWriteMultipleRegisters(static_cast<uint8_t>(unit), f.offset(), f.count(), regdummy, f.offset(), f.count(), regdummy);
-                        break;
-                    case MBF_READ_FIFO_QUEUE:
-                        status = clientPort->readFIFOQueue(static_cast<uint8_t>(unit), f.offset(), &regdummy[1], &regdummy[0]);
-                        break;
-                    case MBF_ENCAPSULATED_INTERFACE_TRANSPORT:
-                        status = clientPort->readDeviceIdentification(static_cast<uint8_t>(unit), f.deviceId(), f.objectId(), &dummy[1], &dummy[0]);
-                        break;
-                    }
-
+                    status = request(clientPort, static_cast<uint8_t>(unit), f, dummy);
                     if (Modbus::StatusIsProcessing(status))
                         Modbus::msleep(1);
                     else
                         break;
                 }
-                if (Modbus::StatusIsGood(status))
-                {
-                    if (!deviceIsFound)
-                    {
-                        deviceIsFound = true;
-                        Modbus::setSettingUnit(settings, unit);
-                        m_scanner->deviceAdd(settings);
-                        m_scanner->setStatFound(++deviceFound);
-                    }
-                    m_scanner->setFunctionCompleted(sPort, unit, f, status);
-                }
-                else if (Modbus::StatusIsBad(status))
-                {
-                    mbClient::LogError(s.name, QString("%1 Error (%2): %3").arg(sPortUnit, QString::number(status, 16), clientPort->lastErrorText()));
-                    m_scanner->setFunctionCompleted(sPort, unit, f, status);
-                }
-                auto percent = ++funcCount*100/m_combinationCountAll;
-                m_scanner->setStatPercent(percent);
-                if (percent >= 100)
+                if (functionCompleted(clientPort, settings, sPort, static_cast<uint8_t>(unit), f, status, deviceIsFound))
                     break;
                 while (m_ctrlRun)
                 {
@@ -336,8 +306,294 @@ void mbClientScannerThread::run()
         clientPort->close();
         mbClient::LogInfo(s.name, QString("End scanning '%1'").arg(sPort));
         delete clientPort;
+        if (m_ctrlRun)
+            combinationDone(combination);
     }
-    mbClient::LogInfo(s.name, QStringLiteral("Finish scanning"));
+}
+
+void mbClientScannerThread::runConcurrent()
+{
+    const mbClientScanner::Strings &s = mbClientScanner::Strings::instance();
+    QList<Probe*> probes;
+    quint32 c = 0;
+    while (m_ctrlRun)
+    {
+        // Note: every probe owns its own connection, so up to 'm_concurrency' hosts are polled at once
+        while ((probes.count() < m_concurrency) && (c < combinationCount()))
+        {
+            Probe *p = new Probe;
+            p->settings = m_settings;
+            p->combination = setCombination(c++, p->settings);
+            p->port = createPort(p->settings, p->sPort);
+            p->unit = m_unitStart;
+            p->funcIndex = 0;
+            p->deviceIsFound = false;
+            p->begun = false;
+            p->tmNext = 0;
+            p->buff.fill('\0', MB_MAX_BYTES+1);
+            probes.append(p);
+            mbClient::LogInfo(s.name, QString("Begin scanning '%1'").arg(p->sPort));
+        }
+        if (probes.isEmpty())
+            break;
+        for (int i = 0; m_ctrlRun && (i < probes.count()); )
+        {
+            Probe *p = probes.at(i);
+            if (stepProbe(p))
+            {
+                i++;
+                continue;
+            }
+            probes.removeAt(i);
+            p->port->close();
+            mbClient::LogInfo(s.name, QString("End scanning '%1'").arg(p->sPort));
+            combinationDone(p->combination);
+            delete p->port;
+            delete p;
+        }
+        Modbus::msleep(1);
+    }
+    Q_FOREACH (Probe *p, probes)
+    {
+        p->port->close();
+        delete p->port;
+        delete p;
+    }
+}
+
+bool mbClientScannerThread::stepProbe(Probe *p)
+{
+    mb::Timestamp_t tm = mb::currentTimestamp();
+    if (tm < p->tmNext)
+        return true;
+    const mbClientMessageParams &f = m_request.at(p->funcIndex);
+    uint8_t unit = static_cast<uint8_t>(p->unit);
+    if (!p->begun)
+    {
+        QString sPortUnit = QString("%1,Unit=%2").arg(p->sPort, QString::number(unit));
+        p->port->setObjectName(sPortUnit.toLatin1().constData());
+        m_scanner->setStatDevice(sPortUnit);
+        m_scanner->setFunctionBegin(p->sPort, unit, f);
+        memset(p->buff.data(), 0, static_cast<size_t>(p->buff.size()));
+        p->begun = true;
+    }
+    Modbus::StatusCode status = request(p->port, unit, f, reinterpret_cast<uint8_t*>(p->buff.data()));
+    if (Modbus::StatusIsProcessing(status))
+        return true;
+    p->begun = false;
+    p->tmNext = tm + m_period;
+    if (functionCompleted(p->port, p->settings, p->sPort, unit, f, status, p->deviceIsFound))
+        return false;
+    if (++p->funcIndex < m_request.count())
+        return true;
+    p->funcIndex = 0;
+    p->deviceIsFound = false;
+    if (p->unit == m_unitEnd)
+        return false;
+    p->unit += m_unitInc;
+    return true;
+}
+
+bool mbClientScannerThread::functionCompleted(ModbusClientPort *clientPort, Modbus::Settings &settings, const QString &sPort, uint8_t unit, const mbClientMessageParams &f, Modbus::StatusCode status, bool &deviceIsFound)
+{
+    const mbClientScanner::Strings &s = mbClientScanner::Strings::instance();
+    if (Modbus::StatusIsGood(status))
+    {
+        if (!deviceIsFound)
+        {
+            deviceIsFound = true;
+            Modbus::setSettingUnit(settings, unit);
+            m_scanner->deviceAdd(settings);
+            m_scanner->setStatFound(++m_deviceFound);
+        }
+        m_scanner->setFunctionCompleted(sPort, unit, f, status);
+    }
+    else if (Modbus::StatusIsBad(status))
+    {
+        QString sPortUnit = QString("%1,Unit=%2").arg(sPort, QString::number(unit));
+        mbClient::LogError(s.name, QString("%1 Error (%2): %3").arg(sPortUnit, QString::number(status, 16), clientPort->lastErrorText()));
+        m_scanner->setFunctionCompleted(sPort, unit, f, status);
+    }
+    auto percent = ++m_funcCount*100/m_combinationCountAll;
+    m_scanner->setStatPercent(static_cast<quint32>(percent));
+    return percent >= 100;
+}
+
+void mbClientScannerThread::combinationDone(uint c)
+{
+    if (c < m_checkpoint)
+        return;
+    m_done.insert(c);
+    // Note: checkpoint moves only over continuous block of completed combinations,
+    //       because concurrent probes can complete out of order
+    bool changed = false;
+    while (m_done.remove(m_checkpoint))
+    {
+        ++m_checkpoint;
+        changed = true;
+    }
+    if (changed)
+        m_scanner->setCheckpoint(m_checkpoint);
+}
+
+quint32 mbClientScannerThread::combinationCount() const
+{
+    if (m_filtered)
+        return static_cast<quint32>(m_live.count());
+    return m_combinationCount - m_checkpointStart;
+}
+
+uint mbClientScannerThread::setCombination(quint32 i, Modbus::Settings &settings) const
+{
+    uint c;
+    if (m_filtered)
+    {
+        c = m_live.at(static_cast<int>(i));
+        Modbus::setSettingTimeout(settings, m_liveTimeouts.at(static_cast<int>(i)));
+    }
+    else
+    {
+        c = m_checkpointStart + i;
+        Modbus::setSettingTimeout(settings, m_timeout);
+    }
+    // Get comibation number for each setting
+    for (quint16 si = 0; si < m_names.count(); si++)
+    {
+        const QString &name = m_names.at(si);
+        const DivMod &dm = m_divMods.at(si);
+        // Calc value of each setting corresponding to current combination number
+        uint sc = (c / dm.div) % dm.mod;
+        if (si == m_hostIndex)
+            settings[name] = m_hosts.host(sc);
+        else
+            settings[name] = m_valuesList.at(si).at(static_cast<int>(sc));
+    }
+    return c;
+}
+
+ModbusClientPort *mbClientScannerThread::createPort(const Modbus::Settings &settings, QString &sPort)
+{
+    ModbusClientPort *clientPort = Modbus::createClientPort(settings, false);
+    switch (clientPort->type())
+    {
+    case Modbus::ASC:
+    {
+        ModbusAscPort *port = static_cast<ModbusAscPort*>(clientPort->port());
+        clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotAsciiTx);
+        clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotAsciiRx);
+        sPort = QString("ASC:%1:%2:%3%4%5")
+                    .arg(port->portName(),
+                         QString::number(port->baudRate()),
+                         QString::number(port->dataBits()),
+                         mbClientScanner::toShortParityStr(port->parity()),
+                         mbClientScanner::toShortStopBitsStr(port->stopBits()));
+    }
+        break;
+    case Modbus::RTU:
+    {
+        ModbusRtuPort *port = static_cast<ModbusRtuPort*>(clientPort->port());
+        clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotBytesTx);
+        clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotBytesRx);
+        sPort = QString("RTU:%1:%2:%3%4%5")
+                    .arg(port->portName(),
+                         QString::number(port->baudRate()),
+                         QString::number(port->dataBits()),
+                         mbClientScanner::toShortParityStr(port->parity()),
+                         mbClientScanner::toShortStopBitsStr(port->stopBits()));
+    }
+        break;
+    default:
+    {
+        ModbusNetPort *port = static_cast<ModbusNetPort*>(clientPort->port());
+        clientPort->connect(&ModbusClientPort::signalTx, this, &mbClientScannerThread::slotBytesTx);
+        clientPort->connect(&ModbusClientPort::signalRx, this, &mbClientScannerThread::slotBytesRx);
+        sPort = QString("%1:%2:%3")
+                    .arg(Modbus::sprotocolType(clientPort->type()),
+                         port->host(),
+                         QString::number(port->port()));
+    }
+        break;
+    }
+    return clientPort;
+}
+
+Modbus::StatusCode mbClientScannerThread::request(ModbusClientPort *clientPort, uint8_t unit, const mbClientMessageParams &f, uint8_t *dummy)
+{
+    uint16_t *regdummy = reinterpret_cast<uint16_t*>(dummy);
+    switch (f.function())
+    {
+    case MBF_READ_COILS:
+        return clientPort->readCoils(unit, f.offset(), f.count(), dummy);
+    case MBF_READ_DISCRETE_INPUTS:
+        return clientPort->readDiscreteInputs(unit, f.offset(), f.count(), dummy);
+    case MBF_READ_HOLDING_REGISTERS:
+        return clientPort->readHoldingRegisters(unit, f.offset(), f.count(), regdummy);
+    case MBF_READ_INPUT_REGISTERS:
+        return clientPort->readInputRegisters(unit, f.offset(), f.count(), regdummy);
+    case MBF_WRITE_SINGLE_COIL:
+        return clientPort->writeSingleCoil(unit, f.offset(), 0);
+    case MBF_WRITE_SINGLE_REGISTER:
+        return clientPort->writeSingleRegister(unit, f.offset(), 0);
+    case MBF_READ_EXCEPTION_STATUS:
+        return clientPort->readExceptionStatus(unit, dummy);
+    case MBF_DIAGNOSTICS:
+        switch (f.subfunction())
+        {
+        case MBF_DIAGNOSTICS_RETURN_QUERY_DATA:
+            return clientPort->diagnosticsReturnQueryData(unit, dummy, 2, &dummy[1], dummy);
+        case MBF_DIAGNOSTICS_RESTART_COMMUNICATIONS_OPTION:
+            return clientPort->diagnosticsRestartCommunicationsOption(unit, dummy[0]);
+        case MBF_DIAGNOSTICS_RETURN_DIAGNOSTIC_REGISTER:
+            return clientPort->diagnosticsReturnDiagnosticRegister(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_CHANGE_ASCII_INPUT_DELIMITER:
+            return clientPort->diagnosticsChangeAsciiInputDelimiter(unit, dummy[0]);
+        case MBF_DIAGNOSTICS_FORCE_LISTEN_ONLY_MODE:
+            return clientPort->diagnosticsForceListenOnlyMode(unit);
+        case MBF_DIAGNOSTICS_CLEAR_COUNTERS_AND_DIAGNOSTIC_REGISTER:
+            return clientPort->diagnosticsClearCountersAndDiagnosticRegister(unit);
+        case MBF_DIAGNOSTICS_RETURN_BUS_MESSAGE_COUNT:
+            return clientPort->diagnosticsReturnBusMessageCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_BUS_COMMUNICATION_ERROR_COUNT:
+            return clientPort->diagnosticsReturnBusCommunicationErrorCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_BUS_EXCEPTION_ERROR_COUNT:
+            return clientPort->diagnosticsReturnBusExceptionErrorCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_SERVER_MESSAGE_COUNT:
+            return clientPort->diagnosticsReturnServerMessageCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_SERVER_NO_RESPONSE_COUNT:
+            return clientPort->diagnosticsReturnServerNoResponseCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_SERVER_NAK_COUNT:
+            return clientPort->diagnosticsReturnServerNAKCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_SERVER_BUSY_COUNT:
+            return clientPort->diagnosticsReturnServerBusyCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_RETURN_BUS_CHARACTER_OVERRUN_COUNT:
+            return clientPort->diagnosticsReturnBusCharacterOverrunCount(unit, reinterpret_cast<uint16_t*>(dummy));
+        case MBF_DIAGNOSTICS_CLEAR_OVERRUN_COUNTER_AND_FLAG:
+            return clientPort->diagnosticsClearOverrunCounterAndFlag(unit);
+        default:
+            return Modbus::Status_BadIllegalFunction;
+        }
+    case MBF_GET_COMM_EVENT_COUNTER:
+        return clientPort->getCommEventCounter(unit, &regdummy[0], &regdummy[1]);
+    case MBF_GET_COMM_EVENT_LOG:
+        return clientPort->getCommEventLog(unit, &regdummy[0], &regdummy[1], &regdummy[2], &dummy[7], &dummy[6]);
+    case MBF_WRITE_MULTIPLE_COILS:
+        return clientPort->writeMultipleCoils(unit, f.offset(), f.count(), dummy);
+    case MBF_WRITE_MULTIPLE_REGISTERS:
+        return clientPort->writeMultipleRegisters(unit, f.offset(), f.count(), regdummy);
+    case MBF_REPORT_SERVER_ID:
+        return clientPort->reportServerID(unit, &dummy[1], &dummy[0]);
+    case MBF_READ_FILE_RECORD:
+        return clientPort->readFileRecord(unit, f.fileRecords().data(), f.fileRecords().count(), &dummy[1], &dummy[0]);
+    case MBF_MASK_WRITE_REGISTER:
+        return clientPort->maskWriteRegister(unit, f.offset(), 0, 0);
+    case MBF_READ_WRITE_MULTIPLE_REGISTERS:
+        return clientPort->readWriteMultipleRegisters(unit, f.offset(), f.count(), regdummy, f.offset(), f.count(), regdummy);
+    case MBF_READ_FIFO_QUEUE:
+        return clientPort->readFIFOQueue(unit, f.offset(), &regdummy[1], &regdummy[0]);
+    case MBF_ENCAPSULATED_INTERFACE_TRANSPORT:
+        return clientPort->readDeviceIdentification(unit, f.deviceId(), f.objectId(), &dummy[1], &dummy[0]);
+    }
+    return Modbus::Status_BadIllegalFunction;
 }
 
 void mbClientScannerThread::slotBytesTx(const Modbus::Char *source, const uint8_t *buff, uint16_t size)
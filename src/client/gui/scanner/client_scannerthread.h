@@ -23,11 +23,15 @@
 #ifndef CLIENT_SCANNERTHREAD_H
 #define CLIENT_SCANNERTHREAD_H
 
+#include <QSet>
 #include <QThread>
 
 #include <client_global.h>
 
 #include "client_scanner.h"
+#include "client_scannerhosts.h"
+
+class ModbusClientPort;
 
 class mbClientScannerThread : public QThread
 {
@@ -38,6 +42,8 @@ public:
 public:
     inline void stop() { m_ctrlRun = false; }
     void setSettings(const Modbus::Settings &settings);
+    // Note: must be called before thread is started
+    inline void setCheckpoint(quint32 checkpoint) { m_checkpoint = checkpoint; }
 
 protected:
     void run() override;
@@ -49,6 +55,48 @@ private Q_SLOTS:
     void slotAsciiRx(const Modbus::Char *source, const uint8_t* buff, uint16_t size);
 
 private:
+    // Note: one probe scans all units of one host/port combination
+    struct Probe
+    {
+        ModbusClientPort *port;
+        QString sPort;
+        Modbus::Settings settings;
+        uint combination;
+        int unit;
+        int funcIndex;
+        bool deviceIsFound;
+        bool begun;
+        mb::Timestamp_t tmNext;
+        QByteArray buff;
+    };
+
+    // Note: phase one of TCP scan, checks if host/port combination accepts connection at all
+    struct ConnectProbe
+    {
+        ModbusClientPort *port;
+        QString sPort;
+        uint combination;
+        mb::Timestamp_t tmStart;
+    };
+
+    // Note: adaptive unit timeout is 'RttFactor' times connect RTT but not less than 'MinAdaptiveTimeout'
+    enum
+    {
+        RttFactor = 10,
+        MinAdaptiveTimeout = 100
+    };
+
+private:
+    void runConnectProbe();
+    void runSequential();
+    void runConcurrent();
+    bool stepProbe(Probe *p);
+    bool functionCompleted(ModbusClientPort *clientPort, Modbus::Settings &settings, const QString &sPort, uint8_t unit, const mbClientMessageParams &f, Modbus::StatusCode status, bool &deviceIsFound);
+    void combinationDone(uint c);
+    quint32 combinationCount() const;
+    uint setCombination(quint32 i, Modbus::Settings &settings) const;
+    ModbusClientPort *createPort(const Modbus::Settings &settings, QString &sPort);
+    Modbus::StatusCode request(ModbusClientPort *clientPort, uint8_t unit, const mbClientMessageParams &f, uint8_t *dummy);
     void incStatTx();
     void incStatRx();
 
@@ -58,6 +106,9 @@ private:
 private:
     mbClientScanner *m_scanner;
     uint32_t m_period;
+    int m_concurrency;
+    bool m_connectProbe;
+    uint32_t m_timeout;
     int m_unitStart;
     int m_unitEnd;
     int m_unitInc;
@@ -67,8 +118,8 @@ private:
 private: // settings combination
     struct DivMod
     {
-        quint16 div;
-        quint16 mod;
+        quint32 div;
+        quint32 mod;
     };
 
     typedef QList<DivMod> DivMods_t;
@@ -78,10 +129,22 @@ private: // settings combination
     DivMods_t    m_divMods   ;
     Names_t      m_names     ;
     ValuesList_t m_valuesList;
+    int          m_hostIndex ;
+    mbClientScannerHosts m_hosts;
     quint32 m_combinationCount;
-    quint32 m_combinationCountAll;
+    quint64 m_combinationCountAll;
     quint32 m_statTx;
     quint32 m_statRx;
+    // Note: combinations that accepted connection with adapted timeouts (when 'm_filtered' is set)
+    QVector<uint> m_live;
+    QVector<uint32_t> m_liveTimeouts;
+    bool m_filtered;
+    // Note: all combinations before 'm_checkpoint' are completed
+    quint32 m_checkpoint;
+    quint32 m_checkpointStart;
+    QSet<uint> m_done;
+    quint64 m_funcCount;
+    quint32 m_deviceFound;
 };
 
 #endif // CLIENT_SCANNERTHREAD_H
@@ -20,6 +20,8 @@ mbClientScannerUi::Strings::Strings() : mbCoreDialogBase::Strings(),
     prefix          (QStringLiteral("Ui.Scanner.")),
     type            (prefix+Modbus::Strings::instance().type),
     period          (prefix+mbClientScanner::Strings::instance().period   ),
+    concurrency     (prefix+mbClientScanner::Strings::instance().concurrency),
+    connectProbe    (prefix+mbClientScanner::Strings::instance().connectProbe),
     timeout         (prefix+Modbus::Strings::instance().timeout),
     tries           (prefix+mbClientScanner::Strings::instance().tries    ),
     unitStart       (prefix+mbClientScanner::Strings::instance().unitStart),
@@ -35,6 +37,8 @@ mbClientScannerUi::Strings::Strings() : mbCoreDialogBase::Strings(),
     dataBitsList    (QStringLiteral("dataBitsList")),
     parityList      (QStringLiteral("parityList")),
     stopBitsList    (QStringLiteral("stopBitsList")),
+    checkpoint      (QStringLiteral("checkpoint")),
+    checkpointKey   (QStringLiteral("checkpointKey")),
     wSplitterState  (QStringLiteral("splitterState"))
 {
 
@@ -112,6 +116,15 @@ mbClientScannerUi::mbClientScannerUi(QWidget *parent) :
     sp->setMaximum(UCHAR_MAX);
     sp->setValue(d.unitEnd);
 
+    // Concurrency
+    sp = ui->spConcurrency;
+    sp->setMinimum(1);
+    sp->setMaximum(1024);
+    sp->setValue(d.concurrency);
+
+    // Connect Probe
+    ui->chkConnectProbe->setChecked(d.connectProbe);
+
     //--------------------- TCP ---------------------
     // Host
     vls.clear();
@@ -195,6 +208,7 @@ mbClientScannerUi::mbClientScannerUi(QWidget *parent) :
     connect(ui->btnAddAll, &QPushButton::clicked, this, &mbClientScannerUi::slotAddAll);
     connect(ui->btnClear , &QPushButton::clicked, this, &mbClientScannerUi::slotClear );
     connect(ui->btnStart , &QPushButton::clicked, this, &mbClientScannerUi::slotStart );
+    connect(ui->btnResume, &QPushButton::clicked, this, &mbClientScannerUi::slotResume);
     connect(ui->btnStop  , &QPushButton::clicked, this, &mbClientScannerUi::slotStop  );
     connect(ui->btnClose , &QPushButton::clicked, this, &mbClientScannerUi::slotClose );
 
@@ -217,6 +231,8 @@ MBSETTINGS mbClientScannerUi::cachedSettings() const
 
     m[s.type            ] = ui->cmbType          ->currentText();
     m[s.period          ] = ui->spPeriod         ->value      ();
+    m[s.concurrency     ] = ui->spConcurrency    ->value      ();
+    m[s.connectProbe    ] = ui->chkConnectProbe  ->isChecked  ();
     m[s.timeout         ] = ui->spTimeout        ->value      ();
     m[s.tries           ] = ui->spTries          ->value      ();
     m[s.unitStart       ] = ui->spUnitStart      ->value      ();
@@ -230,6 +246,8 @@ MBSETTINGS mbClientScannerUi::cachedSettings() const
     m[s.dataBitsList    ] = getValues(ui->lsDataBits);
     m[s.parityList      ] = getValues(ui->lsParity  );
     m[s.stopBitsList    ] = getValues(ui->lsStopBits);
+    m[s.checkpoint      ] = m_scanner->checkpoint();
+    m[s.checkpointKey   ] = m_scanner->checkpointKey();
     m[s.wSplitterState  ] = ui->splitter->saveState();
 
     return m;
@@ -249,6 +267,8 @@ void mbClientScannerUi::setCachedSettings(const MBSETTINGS &m)
 
     it = m.find(s.type            ); if (it != end) ui->cmbType          ->setCurrentText(it.value().toString());
     it = m.find(s.period          ); if (it != end) ui->spPeriod         ->setValue      (it.value().toInt()   );
+    it = m.find(s.concurrency     ); if (it != end) ui->spConcurrency    ->setValue      (it.value().toInt()   );
+    it = m.find(s.connectProbe    ); if (it != end) ui->chkConnectProbe  ->setChecked    (it.value().toBool()  );
     it = m.find(s.timeout         ); if (it != end) ui->spTimeout        ->setValue      (it.value().toInt()   );
     it = m.find(s.tries           ); if (it != end) ui->spTries          ->setValue      (it.value().toInt()   );
     it = m.find(s.unitStart       ); if (it != end) ui->spUnitStart      ->setValue      (it.value().toInt()   );
@@ -262,6 +282,12 @@ void mbClientScannerUi::setCachedSettings(const MBSETTINGS &m)
     it = m.find(s.dataBitsList    ); if (it != end) setValues(ui->lsDataBits, it.value().toList());
     it = m.find(s.parityList      ); if (it != end) setValues(ui->lsParity  , it.value().toList());
     it = m.find(s.stopBitsList    ); if (it != end) setValues(ui->lsStopBits, it.value().toList());
+    it = m.find(s.checkpoint      );
+    if (it != end)
+    {
+        m_scanner->restoreCheckpoint(m.value(s.checkpointKey).toString(), it.value().toUInt());
+        ui->btnResume->setEnabled(m_scanner->checkpoint() > 0);
+    }
     it = m.find(s.wSplitterState  ); if (it != end) ui->splitter         ->restoreState   (it.value().toByteArray());
 }
 
@@ -362,10 +388,29 @@ void mbClientScannerUi::slotClear()
 void mbClientScannerUi::slotStart()
 {
     m_scanner->clear();
+    m_scanner->startScanning(scanSettings());
+}
+
+void mbClientScannerUi::slotResume()
+{
+    Modbus::Settings s = scanSettings();
+    if (!m_scanner->canResume(s))
+    {
+        QMessageBox::warning(this,
+                             QStringLiteral("Resume scanning"),
+                             QStringLiteral("Scan settings were changed since the scan was stopped. Scanning can't be resumed."));
+        return;
+    }
+    m_scanner->startScanning(s, true);
+}
 
+Modbus::Settings mbClientScannerUi::scanSettings() const
+{
     Modbus::Settings s;
     Modbus::ProtocolType type = static_cast<Modbus::ProtocolType>(ui->cmbType->currentIndex());
     mbClientScanner::setSettingPeriod(s, ui->spPeriod->value());
+    mbClientScanner::setSettingConcurrency(s, ui->spConcurrency->value());
+    mbClientScanner::setSettingConnectProbe(s, ui->chkConnectProbe->isChecked());
     mbClientScanner::setSettingUnitStart(s, ui->spUnitStart->value());
     mbClientScanner::setSettingUnitEnd(s, ui->spUnitEnd->value());
     Modbus::setSettingType(s, type);
@@ -381,8 +426,7 @@ void mbClientScannerUi::slotStart()
     mbClientScanner::setSettingStopBits(s, getValues(ui->lsStopBits));
     Modbus::setSettingFlowControl(s, Modbus::NoFlowControl);
     mbClientScanner::setSettingRequest(s, m_request);
-
-    m_scanner->startScanning(s);
+    return s;
 }
 
 void mbClientScannerUi::slotStop()
@@ -407,6 +451,10 @@ void mbClientScannerUi::setType(int type)
         ui->stackedWidget->setCurrentWidget(ui->pgTcpPort);
         break;
     }
+    // Note: serial combinations share one device and are always scanned sequentially
+    ui->spConcurrency->setEnabled(ui->stackedWidget->currentWidget() == ui->pgTcpPort);
+    // Note: UDP is connectionless, so there is nothing to probe before sending requests
+    ui->chkConnectProbe->setEnabled(ui->cmbType->currentText() == Modbus::toString(Modbus::TCP));
 }
 
 void mbClientScannerUi::stateChange(bool run)
@@ -428,6 +476,7 @@ void mbClientScannerUi::stateChange(bool run)
     ui->btnAddAll->setEnabled(enable);
     ui->btnClear ->setEnabled(enable);
     ui->btnStart ->setEnabled(enable);
+    ui->btnResume->setEnabled(enable && (m_scanner->checkpoint() > 0));
     ui->grCommon ->setEnabled(enable);
     ui->grPort   ->setEnabled(enable);
 }
@@ -27,6 +27,8 @@ public:
         const QString prefix          ;
         const QString type            ;
         const QString period          ;
+        const QString concurrency     ;
+        const QString connectProbe    ;
         const QString timeout         ;
         const QString tries           ;
         const QString unitStart       ;
@@ -42,6 +44,8 @@ public:
         const QString dataBitsList    ;
         const QString parityList      ;
         const QString stopBitsList    ;
+        const QString checkpoint      ;
+        const QString checkpointKey   ;
         const QString wSplitterState  ;
 
         Strings();
@@ -74,6 +78,7 @@ private Q_SLOTS:
     void slotAddAll();
     void slotClear();
     void slotStart();
+    void slotResume();
     void slotStop();
     void slotClose();
 
@@ -95,6 +100,7 @@ private:
 private:
     QVariantList getValues(const QListWidget *w) const;
     void setValues(QListWidget *w, const QVariantList &v);
+    Modbus::Settings scanSettings() const;
     void setRequest(const mbClientScanner::Request_t &req);
     inline void setRequest(const QString &sReq) { setRequest(mbClientScanner::toRequest(sReq)); }
     void refreshElapsedTime();
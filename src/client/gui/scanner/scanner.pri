@@ -4,6 +4,7 @@ HEADERS += \
     $$PWD/client_dialogscannerport.h \
     $$PWD/client_scanner.h          \
     $$PWD/client_scannerthread.h    \
+    $$PWD/client_scannerhosts.h     \
     $$PWD/client_scannerui.h \
     $$PWD/client_scannerunitmodel.h \
     $$PWD/client_scannerfuncmodel.h
@@ -14,6 +15,7 @@ SOURCES += \
     $$PWD/client_dialogscannerport.cpp \
     $$PWD/client_scanner.cpp        \
     $$PWD/client_scannerthread.cpp  \
+    $$PWD/client_scannerhosts.cpp   \
     $$PWD/client_scannerui.cpp \
     $$PWD/client_scannerunitmodel.cpp \
     $$PWD/client_scannerfuncmodel.cpp
@@ -38,4 +38,18 @@ void mbClientDeviceStatisticsUi::syncStatistics()
     ui->lnCountBadConnection->setText(QString::number(s.countBadConnection));
     ui->lnCountBadTimeout   ->setText(QString::number(s.countBadTimeout   ));
     ui->lnCountBadCRC       ->setText(QString::number(s.countBadCRC       ));
+
+    ui->lnPollCount         ->setText(QString::number(s.pollCount         ));
+    ui->lnPollLastPeriod    ->setText(QString::number(s.pollLastPeriod    ));
+    ui->lnPollMinPeriod     ->setText(QString::number(s.pollCount ? s.pollMinPeriod : 0));
+    ui->lnPollMaxPeriod     ->setText(QString::number(s.pollMaxPeriod     ));
+    ui->lnPollAvgPeriod     ->setText(QString::number(s.pollAvgPeriod     ));
+    ui->lnPollLastLateness  ->setText(QString::number(s.pollLastLateness  ));
+    ui->lnPollMaxLateness   ->setText(QString::number(s.pollMaxLateness   ));
+    ui->lnPollSkippedCycles ->setText(QString::number(s.pollSkippedCycles ));
+
+    ui->lnRttLast           ->setText(QString::number(s.rttLast           ));
+    ui->lnRttSmoothed       ->setText(QString::number(s.rttSmoothed       ));
+    ui->lnRttVariance       ->setText(QString::number(s.rttVariance       ));
+    ui->lnRttTimeout        ->setText(QString::number(s.rttTimeout        ));
 }
@@ -2,6 +2,7 @@
 #include "ui_client_portstatisticsui.h"
 
 #include <project/client_port.h>
+#include <runtime/client_busplanner.h>
 
 mbClientPortStatisticsUi::mbClientPortStatisticsUi(mbClientPort *port, QWidget *parent) :
     mbCorePortStatisticsUi(port, parent),
@@ -44,4 +45,7 @@ void mbClientPortStatisticsUi::syncStatistics()
     auto s = port()->statistics();
 
     ui->lnCountBadConnection->setText(QString::number(s.countBadConnection));
+    ui->grBus->setVisible(mbClientBusPlanner::isSerial(port()->type()));
+    ui->lnBusProjectedLoad->setText(QString::number(s.busProjectedLoad, 'f', 1));
+    ui->lnBusMeasuredLoad->setText(QString::number(s.busMeasuredLoad, 'f', 1));
 }
@@ -52,9 +52,15 @@ QStringList mbClientBuilder::csvDataViewItemAttributes() const
     const mbClientDataViewItem::Strings &s = mbClientDataViewItem::Strings::instance();
     QStringList ls = mbCoreBuilder::csvDataViewItemAttributes();
     ls.insert(3, s.period);
+    ls.append(s.expression);
     return ls;
 }
 
+QString mbClientBuilder::binaryProjectSuffix() const
+{
+    return QStringLiteral("mbcb");
+}
+
 mbCoreProject *mbClientBuilder::newProject() const
 {
     return new mbClientProject;
@@ -122,6 +128,8 @@ void mbClientBuilder::fillProject(mbCoreProject *obj, const mbCoreDomProject *do
 void mbClientBuilder::fillDataViewItem (mbCoreDataViewItem *obj, const mbCoreDomDataViewItem *dom)
 {
     mbCoreBuilder::fillDataViewItem(obj, dom);
+    if (!dom->record().isEmpty()) // value is a part of typed record
+        return;
     QVariant v = dom->settings().value(mbClientDataViewItem::Strings::instance().value);
     obj->setValue(v);
 }
@@ -129,6 +137,8 @@ void mbClientBuilder::fillDataViewItem (mbCoreDataViewItem *obj, const mbCoreDom
 void mbClientBuilder::fillDomDataViewItem(mbCoreDomDataViewItem *dom, const mbCoreDataViewItem *obj)
 {
     mbCoreBuilder::fillDomDataViewItem(dom, obj);
+    if (!dom->record().isEmpty()) // value is a part of typed record
+        return;
     MBSETTINGS s = dom->settings();
     s[mbClientDataViewItem::Strings::instance().value] = obj->value();
     dom->setSettings(s);
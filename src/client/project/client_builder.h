@@ -58,6 +58,7 @@ public:
 
 public:
     QStringList csvDataViewItemAttributes() const override;
+    QString binaryProjectSuffix() const override;
 
     mbCoreProject         *newProject        () const override;
     mbCorePort            *newPort           () const override;
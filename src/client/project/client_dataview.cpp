@@ -22,11 +22,15 @@
 */
 #include "client_dataview.h"
 
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
+
 #include "client.h"
 
 mbClientDataViewItem::Strings::Strings() :
     mbCoreDataViewItem::Strings(),
-    period(QStringLiteral("period"))
+    period(QStringLiteral("period")),
+    expression(QStringLiteral("expression"))
 {
 }
 
@@ -38,7 +42,8 @@ const mbClientDataViewItem::Strings &mbClientDataViewItem::Strings::instance()
 
 mbClientDataViewItem::Defaults::Defaults() :
     mbCoreDataViewItem::Defaults(),
-    period(1000)
+    period(1000),
+    expression()
 {
 }
 
@@ -52,22 +57,22 @@ mbClientDataViewItem::mbClientDataViewItem(QObject *parent) :
     mbCoreDataViewItem(parent)
 {
     m_period = Defaults::instance().period;
+    m_expression = Defaults::instance().expression;
     m_status = mb::Status_MbStopped;
     m_timestamp = mb::currentTimestamp();
-    m_cache = toVariant(m_value);
 }
 
 void mbClientDataViewItem::setFormat(mb::Format format)
 {
-    QWriteLocker _(&m_lock);
-    if (!mbClient::global()->isRunning() || isFormatEqualSize((format)))
     {
+        QWriteLocker _(valueLock());
+        if (mbClient::global()->isRunning() && !isFormatEqualSize(format))
+            return;
         this->blockSignals(true);
         mbCoreDataViewItem::setFormat(format);
-        m_cache = toVariant(m_value);
         this->blockSignals(false);
-        Q_EMIT changed();
     }
+    Q_EMIT changed();
 }
 
 bool mbClientDataViewItem::isFormatEqualSize(mb::Format format) const
@@ -137,6 +142,7 @@ MBSETTINGS mbClientDataViewItem::settings() const
 
     MBSETTINGS r = mbCoreDataViewItem::settings();
     r.insert(s.period, period());
+    r.insert(s.expression, expression());
     return r;
 }
 
@@ -157,21 +163,51 @@ bool mbClientDataViewItem::setSettings(const MBSETTINGS &settings)
             setPeriod(v);
     }
 
+    it = settings.find(s.expression);
+    if (it != end)
+        setExpression(it.value().toString());
+
     mbCoreDataViewItem::setSettings(settings); // Q_EMIT changed() within
     return true;
 }
 
+void mbClientDataViewItem::writeRecord(mbCoreBinaryWriter &writer) const
+{
+    mbCoreDataViewItem::writeRecord(writer);
+    writer.write(period());
+    writer.write(expression());
+    QReadLocker _(valueLock());
+    writer.write(m_value);
+}
+
+bool mbClientDataViewItem::readRecord(mbCoreBinaryReader &reader)
+{
+    int period;
+    QString expression;
+    QByteArray value;
+    if (!(mbCoreDataViewItem::readRecord(reader) && // Q_EMIT changed() within
+          reader.read(period)                    &&
+          reader.read(expression)                &&
+          reader.read(value)))
+        return false;
+    setPeriod(period);
+    setExpression(expression);
+    if (value.count())
+        update(value, mb::Status_MbStopped, mb::currentTimestamp());
+    return true;
+}
+
 QVariant mbClientDataViewItem::value() const
 {
-    QReadLocker _(&m_lock);
-    return m_cache;
+    QReadLocker _(valueLock());
+    return toVariant(m_value);
 }
 
 void mbClientDataViewItem::setValue(const QVariant &value)
 {
-    m_lock.lockForRead();
+    valueLock()->lockForRead();
     QByteArray data = toByteArray(value); // Note: m_format may change
-    m_lock.unlock();
+    valueLock()->unlock();
     if (data.length() > 0)
     {
         if (mbClient::global()->isRunning())
@@ -186,27 +222,56 @@ void mbClientDataViewItem::setValue(const QVariant &value)
 
 void mbClientDataViewItem::update(const QByteArray &value, mb::StatusCode status, mb::Timestamp_t timestamp)
 {
-    QWriteLocker _(&m_lock);
-    if (value.count())
     {
-        m_value = value;
-        QVariant newCacheValue = toVariant(m_value);
-        if (m_cache != newCacheValue)
+        QWriteLocker _(valueLock());
+        if ((value.count() && (m_value != value)) || (m_status != status))
         {
-            m_cache = newCacheValue;
+            if (value.count())
+                m_value = value;
             m_status = status;
             m_timestamp = timestamp;
-            Q_EMIT valueChanged();
-            return;
         }
+        else
+            return;
     }
-    if (m_status != status)
-    {
-        m_status = status;
-        m_timestamp = timestamp;
-        Q_EMIT valueChanged();
-        return;
-    }
+    Q_EMIT valueChanged();
+}
+
+uint32_t mbClientDataViewItem::achievedPeriod() const
+{
+    if (mbClientDataView *dataView = static_cast<mbClientDataView*>(m_dataView))
+        return dataView->itemPollTiming(this).achievedPeriod;
+    return 0;
+}
+
+uint32_t mbClientDataViewItem::lateness() const
+{
+    if (mbClientDataView *dataView = static_cast<mbClientDataView*>(m_dataView))
+        return dataView->itemPollTiming(this).lateness;
+    return 0;
+}
+
+void mbClientDataViewItem::setPollTiming(uint32_t achievedPeriod, uint32_t lateness)
+{
+    if (mbClientDataView *dataView = static_cast<mbClientDataView*>(m_dataView))
+        dataView->setItemPollTiming(this, achievedPeriod, lateness);
+}
+
+QReadWriteLock *mbClientDataViewItem::valueLock() const
+{
+    static QReadWriteLock locks[ValueLockCount];
+    return &locks[qHash(this) % ValueLockCount];
+}
+
+mbClientDataView::Statistics::Statistics()
+{
+    pollCount         = 0;
+    pollSumPeriod     = 0;
+    pollMinPeriod     = UINT32_MAX;
+    pollMaxPeriod     = 0;
+    pollAvgPeriod     = 0;
+    pollMaxLateness   = 0;
+    pollSkippedCycles = 0;
 }
 
 QStringList mbClientDataView::availableColumnNames()
@@ -223,6 +288,7 @@ mbClientDataView::mbClientDataView(QObject *parent)
 {
     for (int i = mbCoreDataView::ColumnCount; i < ColumnCount; i++)
         m_columns.append(i);
+    connect(this, &mbCoreDataView::itemRemoved, this, &mbClientDataView::removeItemPollTiming);
 }
 
 int mbClientDataView::columnTypeByName(const QString &name) const
@@ -245,3 +311,44 @@ QString mbClientDataView::columnNameByIndex(int i) const
         return QMetaEnum::fromType<ClientColumns>().valueToKey(type);;
 }
 
+void mbClientDataView::resetStatistics()
+{
+    QWriteLocker locker(&m_statLock);
+    m_stat = Statistics();
+    m_itemPollTiming.clear();
+}
+
+void mbClientDataView::setStatPolling(quint32 period, quint32 lateness, quint32 skippedCycles)
+{
+    QWriteLocker locker(&m_statLock);
+    m_stat.pollCount++;
+    m_stat.pollSumPeriod += period;
+    m_stat.pollAvgPeriod = static_cast<quint32>(m_stat.pollSumPeriod / m_stat.pollCount);
+    if (period < m_stat.pollMinPeriod)
+        m_stat.pollMinPeriod = period;
+    if (period > m_stat.pollMaxPeriod)
+        m_stat.pollMaxPeriod = period;
+    if (lateness > m_stat.pollMaxLateness)
+        m_stat.pollMaxLateness = lateness;
+    m_stat.pollSkippedCycles += skippedCycles;
+}
+
+mbClientDataView::ItemPollTiming mbClientDataView::itemPollTiming(const mbClientDataViewItem *item) const
+{
+    QReadLocker locker(&m_statLock);
+    return m_itemPollTiming.value(item, ItemPollTiming{0, 0});
+}
+
+void mbClientDataView::setItemPollTiming(const mbClientDataViewItem *item, uint32_t achievedPeriod, uint32_t lateness)
+{
+    QWriteLocker locker(&m_statLock);
+    ItemPollTiming &t = m_itemPollTiming[item];
+    t.achievedPeriod = achievedPeriod;
+    t.lateness = lateness;
+}
+
+void mbClientDataView::removeItemPollTiming(mbCoreDataViewItem *item)
+{
+    QWriteLocker locker(&m_statLock);
+    m_itemPollTiming.remove(static_cast<mbClientDataViewItem*>(item));
+}
@@ -40,6 +40,7 @@ public:
     struct Strings : public mbCoreDataViewItem::Strings
     {
         const QString period;
+        const QString expression;
 
         Strings();
         static const Strings &instance();
@@ -48,6 +49,7 @@ public:
     struct Defaults : public mbCoreDataViewItem::Defaults
     {
         const uint32_t period;
+        const QString expression;
 
         Defaults();
         static const Defaults &instance();
@@ -58,7 +60,8 @@ public:
 
 public:
     inline mb::Client::ItemHandle_t handle() const { return const_cast<mb::Client::ItemHandle_t>(this); }
-    inline bool isReadOnly() const { return m_address.type() == Modbus::Memory_1x || m_address.type() == Modbus::Memory_3x; }
+    inline bool isReadOnly() const { return isComputed() || m_address.type() == Modbus::Memory_1x || m_address.type() == Modbus::Memory_3x; }
+    inline bool isComputed() const { return !m_expression.isEmpty(); }
 
 public: // settings
     inline mbClientDevice *device() const { return reinterpret_cast<mbClientDevice*>(deviceCore()); }
@@ -67,12 +70,19 @@ public: // settings
     inline int period() const { return m_period; }
     inline void setPeriod(int period) { m_period = period; }
 
+    inline QString expression() const { return m_expression; }
+    inline void setExpression(const QString &expression) { m_expression = expression.trimmed(); }
+
     void setFormat(mb::Format format) override;
     bool isFormatEqualSize(mb::Format format) const;
 
     MBSETTINGS settings() const override;
     bool setSettings(const MBSETTINGS &settings) override;
 
+    // Note: record contains current raw value of the item as well
+    void writeRecord(mbCoreBinaryWriter &writer) const override;
+    bool readRecord(mbCoreBinaryReader &reader) override;
+
 public:
     QVariant value() const override;
     void setValue(const QVariant& value) override;
@@ -83,15 +93,23 @@ public:
     void update(const QByteArray &data, mb::StatusCode status, mb::Timestamp_t timestamp);
     inline void update(mb::StatusCode status, mb::Timestamp_t timestamp) { update(QByteArray(), status, timestamp); }
 
+public: // polling timing, it's kept by data view of the item (zero if item doesn't belong to data view)
+    uint32_t achievedPeriod() const;
+    uint32_t lateness() const;
+    void setPollTiming(uint32_t achievedPeriod, uint32_t lateness);
+
+private:
+    // Note: value of the item is guarded by one of a small pool of locks shared by all items,
+    // so the item doesn't pay for the lock of its own. Signals are emitted when the lock is released
+    enum { ValueLockCount = 64 };
+    QReadWriteLock *valueLock() const;
+
 private:
     uint32_t m_period;
+    QString m_expression;
     mb::StatusCode m_status;
     mb::Timestamp_t m_timestamp;
-    QByteArray m_value;
-    QVariant m_cache;
-
-private:
-    mutable QReadWriteLock m_lock;
+    QByteArray m_value; // Note: value is not cached as QVariant, 'value()' converts it on demand
 };
 
 class mbClientDataView : public mbCoreDataView
@@ -110,6 +128,20 @@ public:
 
     static QStringList availableColumnNames();
 
+public: // statistics
+    struct Statistics
+    {
+        quint32 pollCount        ;
+        quint64 pollSumPeriod    ;
+        quint32 pollMinPeriod    ;
+        quint32 pollMaxPeriod    ;
+        quint32 pollAvgPeriod    ;
+        quint32 pollMaxLateness  ;
+        quint32 pollSkippedCycles;
+
+        Statistics();
+    };
+
 public:
     explicit mbClientDataView(QObject *parent = nullptr);
 
@@ -130,6 +162,29 @@ public: // items
     inline int itemInsert(mbClientDataViewItem* item, int index = -1) { return mbCoreDataView::itemInsert(reinterpret_cast<mbCoreDataViewItem*>(item), index); }
     inline int itemAdd(mbClientDataViewItem* item) { return mbCoreDataView::itemAdd(reinterpret_cast<mbCoreDataViewItem*>(item)); }
     inline int itemRemove(mbClientDataViewItem* item) { return mbCoreDataView::itemRemove(reinterpret_cast<mbCoreDataViewItem*>(item)); }
+
+public: // statistics
+    inline Statistics statistics() const { QReadLocker locker(&m_statLock); return m_stat; }
+    void resetStatistics();
+    void setStatPolling(quint32 period, quint32 lateness, quint32 skippedCycles);
+
+public: // polling timing of the items
+    struct ItemPollTiming
+    {
+        uint32_t achievedPeriod;
+        uint32_t lateness;
+    };
+    ItemPollTiming itemPollTiming(const mbClientDataViewItem *item) const;
+    void setItemPollTiming(const mbClientDataViewItem *item, uint32_t achievedPeriod, uint32_t lateness);
+
+private Q_SLOTS:
+    void removeItemPollTiming(mbCoreDataViewItem *item);
+
+private:
+    mutable QReadWriteLock m_statLock;
+    Statistics m_stat;
+    // Note: only polled items have timing, so it's not kept within every item
+    QHash<const mbClientDataViewItem*, ItemPollTiming> m_itemPollTiming;
 };
 
 #endif // CLIENT_DATAVIEW_H
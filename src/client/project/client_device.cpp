@@ -22,6 +22,9 @@
 */
 #include "client_device.h"
 
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
+
 #include "client_port.h"
 #include "client_project.h"
 
@@ -58,6 +61,19 @@ mbClientDevice::Statistics::Statistics() :
     countBadConnection = 0;
     countBadTimeout    = 0;
     countBadCRC        = 0;
+    pollCount          = 0;
+    pollSumPeriod      = 0;
+    pollLastPeriod     = 0;
+    pollMinPeriod      = UINT32_MAX;
+    pollMaxPeriod      = 0;
+    pollAvgPeriod      = 0;
+    pollLastLateness   = 0;
+    pollMaxLateness    = 0;
+    pollSkippedCycles  = 0;
+    rttLast            = 0;
+    rttSmoothed        = 0;
+    rttVariance        = 0;
+    rttTimeout         = 0;
 }
 
 mbClientDevice::mbClientDevice(QObject *parent) :
@@ -139,6 +155,56 @@ bool mbClientDevice::setSettings(const MBSETTINGS &settings)
     return true;
 }
 
+void mbClientDevice::writeRecord(mbCoreBinaryWriter &writer) const
+{
+    mbCoreDevice::writeRecord(writer);
+    writer.write(unit());
+    writer.write(portName());
+}
+
+bool mbClientDevice::readRecord(mbCoreBinaryReader &reader)
+{
+    int unit;
+    QString portName;
+    if (!(mbCoreDevice::readRecord(reader) && // Q_EMIT changed() within
+          reader.read(unit)                &&
+          reader.read(portName)))
+        return false;
+    setUnit(static_cast<uint8_t>(unit));
+    setPortName(portName);
+    return true;
+}
+
+void mbClientDevice::setStatPolling(quint32 period, quint32 lateness, quint32 skippedCycles)
+{
+    QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
+    Statistics *s = static_cast<Statistics*>(m_stat);
+    s->pollCount++;
+    s->pollSumPeriod += period;
+    s->pollAvgPeriod = static_cast<quint32>(s->pollSumPeriod / s->pollCount);
+    s->pollLastPeriod = period;
+    if (period < s->pollMinPeriod)
+        s->pollMinPeriod = period;
+    if (period > s->pollMaxPeriod)
+        s->pollMaxPeriod = period;
+    s->pollLastLateness = lateness;
+    if (lateness > s->pollMaxLateness)
+        s->pollMaxLateness = lateness;
+    s->pollSkippedCycles += skippedCycles;
+}
+
+void mbClientDevice::setStatResponseTime(quint32 last, quint32 smoothed, quint32 variance, quint32 timeout)
+{
+    QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
+    Statistics *s = static_cast<Statistics*>(m_stat);
+    s->rttLast     = last    ;
+    s->rttSmoothed = smoothed;
+    s->rttVariance = variance;
+    s->rttTimeout  = timeout ;
+}
+
 void mbClientDevice::resetStatisticsInner()
 {
     *static_cast<Statistics*>(m_stat) = Statistics();
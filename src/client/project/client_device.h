@@ -60,6 +60,21 @@ public: // statistics
         quint32 countBadConnection;
         quint32 countBadTimeout   ;
         quint32 countBadCRC       ;
+        // polling timing of periodic read requests (milliseconds)
+        quint32 pollCount         ;
+        quint64 pollSumPeriod     ;
+        quint32 pollLastPeriod    ;
+        quint32 pollMinPeriod     ;
+        quint32 pollMaxPeriod     ;
+        quint32 pollAvgPeriod     ;
+        quint32 pollLastLateness  ;
+        quint32 pollMaxLateness   ;
+        quint32 pollSkippedCycles ;
+        // response time and adaptive timeout (milliseconds)
+        quint32 rttLast           ;
+        quint32 rttSmoothed       ;
+        quint32 rttVariance       ;
+        quint32 rttTimeout        ;
 
         Statistics();
     };
@@ -86,8 +101,13 @@ public: // settings
     MBSETTINGS settings() const override;
     bool setSettings(const MBSETTINGS &settings) override;
 
+    void writeRecord(mbCoreBinaryWriter &writer) const override;
+    bool readRecord(mbCoreBinaryReader &reader) override;
+
 public: // statistics
     inline Statistics statistics() const { QReadLocker locker(&m_statLock); return *static_cast<Statistics*>(m_stat); }
+    void setStatPolling(quint32 period, quint32 lateness, quint32 skippedCycles);
+    void setStatResponseTime(quint32 last, quint32 smoothed, quint32 variance, quint32 timeout);
 
 private:
     void resetStatisticsInner() override;
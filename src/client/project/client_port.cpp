@@ -32,6 +32,8 @@ mbClientPort::Statistics::Statistics() :
     CoreStatistics()
 {
     countBadConnection = 0;
+    busProjectedLoad   = 0;
+    busMeasuredLoad    = 0;
 }
 
 mbClientPort::mbClientPort(QObject *parent) :
@@ -102,6 +104,14 @@ int mbClientPort::deviceRemove(int index)
     return -1;
 }
 
+void mbClientPort::setStatBusLoad(double projected, double measured)
+{
+    QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
+    static_cast<Statistics*>(m_stat)->busProjectedLoad = projected;
+    static_cast<Statistics*>(m_stat)->busMeasuredLoad  = measured ;
+}
+
 void mbClientPort::resetStatisticsInner()
 {
     *static_cast<Statistics*>(m_stat) = Statistics();
@@ -42,6 +42,8 @@ public: // statistics
     struct Statistics : public CoreStatistics
     {
         quint32 countBadConnection;
+        double  busProjectedLoad  ; // %, serial ports only
+        double  busMeasuredLoad   ; // %, serial ports only
 
         Statistics();
         virtual ~Statistics() = default;
@@ -75,6 +77,7 @@ public: // devices
 
 public: // statistics
     inline Statistics statistics() const { QReadLocker locker(&m_statLock); return *static_cast<Statistics*>(m_stat); }
+    void setStatBusLoad(double projected, double measured);
 
 private:
     void resetStatisticsInner() override;
@@ -0,0 +1,164 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_busplanner.h"
+
+#include <client.h>
+
+#include <project/client_port.h>
+
+#include "client_runmessage.h"
+
+mbClientBusPlanner::mbClientBusPlanner(const Modbus::Settings &settings)
+{
+    // Note: planner is created in runtime thread, so it uses port settings snapshot
+    // instead of project port object that can be edited in GUI thread at the same time
+    m_name = settings.value(mbClientPort::Strings::instance().name).toString();
+    m_type = Modbus::getSettingType(settings);
+    double bits = 1 + Modbus::getSettingDataBits(settings); // start bit + data bits
+    if (Modbus::getSettingParity(settings) != Modbus::NoParity)
+        bits += 1;
+    switch (Modbus::getSettingStopBits(settings))
+    {
+    case Modbus::OneAndHalfStop: bits += 1.5; break;
+    case Modbus::TwoStop       : bits += 2  ; break;
+    default                    : bits += 1  ; break;
+    }
+    int32_t baudRate = Modbus::getSettingBaudRate(settings);
+    if (baudRate <= 0)
+        baudRate = 9600;
+    m_charTime = bits * 1000000.0 / baudRate;
+    if (m_type == Modbus::RTU)
+    {
+        // Note: Modbus over serial line spec recommends fixed 1.75 ms silence for baud rates above 19200
+        m_silenceTime = (baudRate > 19200) ? 1750.0 : (3.5 * m_charTime);
+    }
+    else
+        m_silenceTime = 0;
+    m_projectedLoad = 0;
+    m_busTime = 0;
+    m_measureTimestamp = 0;
+}
+
+bool mbClientBusPlanner::isSerial(Modbus::ProtocolType type)
+{
+    return (type == Modbus::RTU) || (type == Modbus::ASC);
+}
+
+double mbClientBusPlanner::frameTime(int pduSize) const
+{
+    int chars;
+    if (m_type == Modbus::ASC)
+        chars = 1 + (1 + pduSize + 1) * 2 + 2; // ':' + hex(unit + PDU + LRC) + CR LF
+    else
+        chars = 1 + pduSize + 2;               // unit + PDU + CRC
+    return chars * m_charTime + m_silenceTime;
+}
+
+double mbClientBusPlanner::transactionTime(const mbClientRunMessage *message) const
+{
+    int count = message->count();
+    int req, res;
+    switch (message->function())
+    {
+    case MBF_READ_COILS:
+    case MBF_READ_DISCRETE_INPUTS:
+        req = 5;
+        res = 2 + (count + 7) / 8;
+        break;
+    case MBF_READ_HOLDING_REGISTERS:
+    case MBF_READ_INPUT_REGISTERS:
+        req = 5;
+        res = 2 + count * 2;
+        break;
+    case MBF_WRITE_MULTIPLE_COILS:
+        req = 6 + (count + 7) / 8;
+        res = 5;
+        break;
+    case MBF_WRITE_MULTIPLE_REGISTERS:
+        req = 6 + count * 2;
+        res = 5;
+        break;
+    default:
+        req = 5;
+        res = 5;
+        break;
+    }
+    return frameTime(req) + frameTime(res);
+}
+
+void mbClientBusPlanner::plan(const QList<mbClientRunMessagePtr> &messages, double targetLoad)
+{
+    double load = 0;
+    Q_FOREACH (const mbClientRunMessagePtr &m, messages)
+    {
+        if (m->period() == 0)
+            continue;
+        double t = transactionTime(m.data()) / 1000.0; // ms
+        if (t > m->period())
+            mbClient::LogWarning(m_name, QString("Period %1 ms of function %2 (offset %3, count %4) is infeasible: transaction takes %5 ms")
+                                             .arg(m->period())
+                                             .arg(m->function())
+                                             .arg(m->offset())
+                                             .arg(m->count())
+                                             .arg(t, 0, 'f', 1));
+        load += t / m->period();
+    }
+    load *= 100;
+    m_projectedLoad = load;
+    if ((targetLoad <= 0) || (load <= targetLoad))
+        return;
+    double k = load / targetLoad;
+    mbClient::LogWarning(m_name, QString("Projected bus load %1% exceeds target %2%. Polling periods are stretched %3 times")
+                                     .arg(load, 0, 'f', 1)
+                                     .arg(targetLoad, 0, 'f', 1)
+                                     .arg(k, 0, 'f', 2));
+    Q_FOREACH (const mbClientRunMessagePtr &m, messages)
+    {
+        if (m->period())
+            m->setPeriod(static_cast<uint32_t>(m->period() * k + 0.5));
+    }
+    m_projectedLoad = targetLoad;
+}
+
+void mbClientBusPlanner::addFrame(int size)
+{
+    // Note: ASCII frames are passed as characters, RTU frames as bytes, so one unit is one character on wire
+    m_busTime += size * m_charTime + m_silenceTime;
+}
+
+bool mbClientBusPlanner::measure(mb::Timestamp_t timestamp, double *load)
+{
+    if (m_measureTimestamp == 0)
+    {
+        m_measureTimestamp = timestamp;
+        m_busTime = 0;
+        return false;
+    }
+    mb::Timestamp_t elapsed = timestamp - m_measureTimestamp;
+    if (elapsed < MeasurePeriod)
+        return false;
+    *load = m_busTime / (elapsed * 10.0); // usec / (ms * 1000) * 100%
+    m_busTime = 0;
+    m_measureTimestamp = timestamp;
+    return true;
+}
@@ -0,0 +1,74 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_BUSPLANNER_H
+#define CLIENT_BUSPLANNER_H
+
+#include <client_global.h>
+
+/*
+   Bus-time budget of serial (RTU/ASCII) port.
+   Expected time of every transaction is calculated from port settings
+   (baud rate, data/parity/stop bits, inter-frame silence) and sizes of
+   request and response frames. Periodic read messages are stretched
+   proportionally when projected bus load exceeds target load.
+*/
+class mbClientBusPlanner
+{
+public:
+    enum Constants
+    {
+        MeasurePeriod = 1000 // ms
+    };
+
+public:
+    explicit mbClientBusPlanner(const Modbus::Settings &settings);
+
+public:
+    static bool isSerial(Modbus::ProtocolType type);
+
+public:
+    inline QString name() const { return m_name; }
+    inline double charTime() const { return m_charTime; }
+    inline double silenceTime() const { return m_silenceTime; }
+    inline double projectedLoad() const { return m_projectedLoad; }
+
+public:
+    double frameTime(int pduSize) const;
+    double transactionTime(const mbClientRunMessage *message) const;
+    void plan(const QList<mbClientRunMessagePtr> &messages, double targetLoad);
+
+public:
+    void addFrame(int size);
+    bool measure(mb::Timestamp_t timestamp, double *load);
+
+private:
+    QString m_name;
+    Modbus::ProtocolType m_type;
+    double m_charTime;    // usec
+    double m_silenceTime; // usec
+    double m_projectedLoad;
+    double m_busTime;     // usec since last measure
+    mb::Timestamp_t m_measureTimestamp;
+};
+
+#endif // CLIENT_BUSPLANNER_H
@@ -0,0 +1,315 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_calculator.h"
+
+#include <QtNumeric>
+
+#include <client.h>
+
+#include <project/client_dataview.h>
+
+mbClientCalculator::mbClientCalculator(QObject *parent) : QThread(parent)
+{
+    m_ctrlRun = false;
+}
+
+mbClientCalculator::~mbClientCalculator()
+{
+    stop();
+    wait();
+}
+
+void mbClientCalculator::addItem(mbClientDataViewItem *item)
+{
+    m_items.append(item);
+}
+
+void mbClientCalculator::build()
+{
+    const mb::StatusCode initStatus = mb::Status_MbInitializing;
+    const mb::Timestamp_t timestamp = mb::currentTimestamp();
+
+    // Note: names are resolved within data view of the computed item
+    QHash<mbCoreDataView*, QHash<QString, mbClientDataViewItem*> > names;
+    QHash<mbClientDataViewItem*, int> nodeIndexes;
+    QVector<Node> nodes;
+    Q_FOREACH (mbClientDataViewItem *item, m_items)
+    {
+        Node node;
+        node.item = item;
+        node.slot = slotIndex(item);
+        node.dirty = false;
+        m_computed.insert(item->handle());
+        if (!node.expression.compile(item->expression()))
+        {
+            mbClient::LogWarning(QStringLiteral("Calculator"), QString("Item '%1': %2").arg(item->comment(), node.expression.errorString()));
+            setBad(node.slot, item, timestamp);
+            continue;
+        }
+        mbCoreDataView *dataView = item->dataViewCore();
+        if (!names.contains(dataView))
+        {
+            QHash<QString, mbClientDataViewItem*> &h = names[dataView];
+            Q_FOREACH (mbCoreDataViewItem *i, dataView->itemsCore())
+            {
+                // Note: first item with the same name wins
+                if (!i->comment().isEmpty() && !h.contains(i->comment()))
+                    h.insert(i->comment(), static_cast<mbClientDataViewItem*>(i));
+            }
+        }
+        const QHash<QString, mbClientDataViewItem*> &h = names.value(dataView);
+        bool ok = true;
+        Q_FOREACH (const QString &name, node.expression.references())
+        {
+            mbClientDataViewItem *ref = h.value(name);
+            if (!ref)
+            {
+                mbClient::LogWarning(QStringLiteral("Calculator"), QString("Item '%1': unknown reference '%2'").arg(item->comment(), name));
+                ok = false;
+                break;
+            }
+            node.inputs.append(slotIndex(ref));
+        }
+        if (!ok)
+        {
+            setBad(node.slot, item, timestamp);
+            continue;
+        }
+        item->update(initStatus, timestamp);
+        nodeIndexes.insert(item, nodes.count());
+        nodes.append(node);
+    }
+
+    // Topological sort (Kahn's algorithm) over edges between computed items
+    QHash<int, int> slotNodes; // slot index -> node index
+    for (int i = 0; i < nodes.count(); i++)
+        slotNodes.insert(nodes.at(i).slot, i);
+    QVector<int> inDegree(nodes.count(), 0);
+    QVector<QVector<int> > edges(nodes.count());
+    for (int i = 0; i < nodes.count(); i++)
+    {
+        Q_FOREACH (int input, nodes.at(i).inputs)
+        {
+            int from = slotNodes.value(input, -1);
+            if (from >= 0)
+            {
+                edges[from].append(i);
+                inDegree[i]++;
+            }
+        }
+    }
+    QVector<int> order;
+    for (int i = 0; i < nodes.count(); i++)
+    {
+        if (inDegree.at(i) == 0)
+            order.append(i);
+    }
+    for (int k = 0; k < order.count(); k++)
+    {
+        Q_FOREACH (int to, edges.at(order.at(k)))
+        {
+            if (--inDegree[to] == 0)
+                order.append(to);
+        }
+    }
+    for (int i = 0; i < nodes.count(); i++)
+    {
+        if (inDegree.at(i) > 0)
+        {
+            mbClientDataViewItem *item = nodes.at(i).item;
+            mbClient::LogWarning(QStringLiteral("Calculator"), QString("Item '%1': circular reference").arg(item->comment()));
+            setBad(nodes.at(i).slot, item, timestamp);
+        }
+    }
+
+    m_nodes.clear();
+    Q_FOREACH (int i, order)
+        m_nodes.append(nodes.at(i));
+    for (int i = 0; i < m_nodes.count(); i++)
+    {
+        Q_FOREACH (int input, m_nodes.at(i).inputs)
+        {
+            QVector<int> &dependents = m_values[input].dependents;
+            if (!dependents.contains(i))
+                dependents.append(i);
+        }
+    }
+    m_sources.clear();
+    for (QHash<mb::Client::ItemHandle_t, int>::ConstIterator it = m_slots.constBegin(); it != m_slots.constEnd(); ++it)
+    {
+        // Note: results of computed items are propagated to dependents inside the calculator
+        if (!m_computed.contains(it.key()))
+            m_sources.insert(it.key(), it.value());
+    }
+}
+
+QList<mbClientDataViewItem*> mbClientCalculator::items() const
+{
+    return m_items;
+}
+
+void mbClientCalculator::append(mb::Client::ItemHandle_t handle, double value, mb::StatusCode status, mb::Timestamp_t timestamp)
+{
+    int slot = m_sources.value(handle, -1);
+    if (slot < 0)
+        return;
+    Change c;
+    c.value = value;
+    c.status = status;
+    c.timestamp = timestamp;
+    QMutexLocker _(&m_mutex);
+    m_pending.insert(slot, c);
+    m_cond.wakeOne();
+}
+
+void mbClientCalculator::stop()
+{
+    QMutexLocker _(&m_mutex);
+    m_ctrlRun = false;
+    m_cond.wakeOne();
+}
+
+void mbClientCalculator::run()
+{
+    m_mutex.lock();
+    m_ctrlRun = true;
+    m_mutex.unlock();
+
+    QHash<int, Change> changes;
+    QVector<double> inputs;
+
+    // Note: initial pass evaluates items without references (constants)
+    // and propagates bad status of failed computed items to their dependents
+    for (int i = 0; i < m_nodes.count(); i++)
+    {
+        m_nodes[i].dirty = false;
+        evaluate(m_nodes[i], inputs);
+    }
+
+    for (;;)
+    {
+        m_mutex.lock();
+        if (m_ctrlRun && m_pending.isEmpty())
+            m_cond.wait(&m_mutex, MaxWaitTime);
+        if (!m_ctrlRun)
+        {
+            m_mutex.unlock();
+            break;
+        }
+        changes.swap(m_pending);
+        m_mutex.unlock();
+
+        if (changes.isEmpty())
+            continue;
+        int first = m_nodes.count();
+        for (QHash<int, Change>::ConstIterator it = changes.constBegin(); it != changes.constEnd(); ++it)
+        {
+            // Note: bad status keeps last good value of the slot
+            Slot &s = m_values[it.key()];
+            if (Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(it.value().status)))
+                s.value = it.value().value;
+            s.status = it.value().status;
+            s.timestamp = it.value().timestamp;
+            Q_FOREACH (int n, s.dependents)
+            {
+                m_nodes[n].dirty = true;
+                if (n < first)
+                    first = n;
+            }
+        }
+        changes.clear();
+
+        // Note: dependents always follow their inputs in 'm_nodes'
+        for (int i = first; i < m_nodes.count(); i++)
+        {
+            Node &node = m_nodes[i];
+            if (node.dirty)
+            {
+                node.dirty = false;
+                evaluate(node, inputs);
+            }
+        }
+    }
+}
+
+int mbClientCalculator::slotIndex(mbClientDataViewItem *item)
+{
+    int i = m_slots.value(item->handle(), -1);
+    if (i < 0)
+    {
+        Slot s;
+        s.value = 0;
+        s.status = mb::Status_MbInitializing;
+        s.timestamp = 0;
+        i = m_values.count();
+        m_values.append(s);
+        m_slots.insert(item->handle(), i);
+    }
+    return i;
+}
+
+void mbClientCalculator::setBad(int slot, mbClientDataViewItem *item, mb::Timestamp_t timestamp)
+{
+    Slot &s = m_values[slot];
+    s.status = static_cast<mb::StatusCode>(Modbus::Status_Bad);
+    s.timestamp = timestamp;
+    item->update(s.status, timestamp);
+}
+
+void mbClientCalculator::evaluate(Node &node, QVector<double> &inputs)
+{
+    mb::StatusCode status = static_cast<mb::StatusCode>(Modbus::Status_Good);
+    mb::Timestamp_t timestamp = 0;
+    inputs.resize(node.inputs.count());
+    for (int i = 0; i < node.inputs.count(); i++)
+    {
+        const Slot &s = m_values.at(node.inputs.at(i));
+        // Note: bad input makes result bad, otherwise result takes not good (e.g. initializing) status of input
+        if (Modbus::StatusIsBad(static_cast<Modbus::StatusCode>(s.status)))
+            status = s.status;
+        else if (!Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(s.status)) && !Modbus::StatusIsBad(static_cast<Modbus::StatusCode>(status)))
+            status = s.status;
+        if (s.timestamp > timestamp)
+            timestamp = s.timestamp;
+        inputs[i] = s.value;
+    }
+    if (!timestamp)
+        timestamp = mb::currentTimestamp();
+    Slot &out = m_values[node.slot];
+    double value = out.value;
+    if (Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(status)))
+        value = node.expression.evaluate(inputs.constData());
+    bool sameValue = (value == out.value) || (qIsNaN(value) && qIsNaN(out.value));
+    if (sameValue && (status == out.status))
+        return;
+    out.value = value;
+    out.status = status;
+    out.timestamp = timestamp;
+    Q_FOREACH (int n, out.dependents)
+        m_nodes[n].dirty = true;
+    // Note: result goes through runtime the same way as polled value (data logger, historian)
+    if (Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(status)))
+        mbClient::global()->updateItem(node.item->handle(), node.item->toByteArray(value), static_cast<Modbus::StatusCode>(status), timestamp);
+    else
+        mbClient::global()->updateItem(node.item->handle(), QByteArray(), static_cast<Modbus::StatusCode>(status), timestamp);
+}
@@ -0,0 +1,122 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_CALCULATOR_H
+#define CLIENT_CALCULATOR_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+#include <client_global.h>
+
+#include "client_expression.h"
+
+class mbClientDataViewItem;
+
+/*
+   Evaluates computed data view items in separate thread.
+   Items referenced by expressions ('{name}' is the comment of the item within
+   the same data view) and computed items are the nodes of dependency graph.
+   Computed items are sorted in topological order, so the single pass through
+   changed nodes evaluates every computed item at most once per change of its inputs.
+   Changes of the same item that arrive before they are processed are coalesced.
+*/
+class mbClientCalculator : public QThread
+{
+public:
+    enum Constants
+    {
+        MaxWaitTime = 100 // ms
+    };
+
+public:
+    explicit mbClientCalculator(QObject *parent = nullptr);
+    ~mbClientCalculator();
+
+public:
+    // Note: must be called before thread is started
+    void addItem(mbClientDataViewItem *item);
+    void build();
+
+public:
+    inline bool isEmpty() const { return m_nodes.isEmpty(); }
+    inline bool isSource(mb::Client::ItemHandle_t handle) const { return m_sources.contains(handle); }
+    inline bool isComputed(mb::Client::ItemHandle_t handle) const { return m_computed.contains(handle); }
+    QList<mbClientDataViewItem*> items() const;
+
+public:
+    void append(mb::Client::ItemHandle_t handle, double value, mb::StatusCode status, mb::Timestamp_t timestamp);
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    struct Change
+    {
+        double value;
+        mb::StatusCode status;
+        mb::Timestamp_t timestamp;
+    };
+
+    struct Slot
+    {
+        double value;
+        mb::StatusCode status;
+        mb::Timestamp_t timestamp;
+        QVector<int> dependents; // indexes of nodes that use this slot as input
+    };
+
+    struct Node
+    {
+        mbClientDataViewItem *item;
+        mbClientExpression expression;
+        QVector<int> inputs; // slot indexes ordered as 'expression.references()'
+        int slot;
+        bool dirty;
+    };
+
+private:
+    int slotIndex(mbClientDataViewItem *item);
+    void setBad(int slot, mbClientDataViewItem *item, mb::Timestamp_t timestamp);
+    void evaluate(Node &node, QVector<double> &inputs);
+
+private:
+    QList<mbClientDataViewItem*> m_items;
+    QHash<mb::Client::ItemHandle_t, int> m_slots;
+    QHash<mb::Client::ItemHandle_t, int> m_sources; // polled (not computed) inputs, fed through 'append'
+    QSet<mb::Client::ItemHandle_t> m_computed;
+    QVector<Slot> m_values;
+    QVector<Node> m_nodes;
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_cond;
+    QHash<int, Change> m_pending;
+    bool m_ctrlRun;
+};
+
+#endif // CLIENT_CALCULATOR_H
@@ -0,0 +1,252 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_datalogger.h"
+
+#include <QtEndian>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+
+#include <client.h>
+
+namespace {
+
+template <typename T>
+inline void appendValue(QByteArray &buff, T v)
+{
+    T le = qToLittleEndian(v);
+    buff.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+inline void appendString(QByteArray &buff, const QString &s)
+{
+    QByteArray b = s.toUtf8();
+    appendValue<quint16>(buff, static_cast<quint16>(b.size()));
+    buff.append(b);
+}
+
+} // namespace
+
+mbClientDataLogger::mbClientDataLogger(const QString &fileName, QObject *parent)
+    : QThread(parent),
+    m_fileName(fileName)
+{
+    m_maxFileSize = 0;
+    m_rotatePeriod = 0;
+    m_dropped = 0;
+    m_ctrlRun = true;
+    m_fileTimestamp = 0;
+    m_lastIndexOffset = -1;
+}
+
+mbClientDataLogger::~mbClientDataLogger()
+{
+}
+
+void mbClientDataLogger::addItem(mb::Client::ItemHandle_t handle, const QString &device, const QString &address, const QString &format)
+{
+    if (m_ids.contains(handle))
+        return;
+    quint32 id = static_cast<quint32>(m_itemInfos.count());
+    m_ids.insert(handle, id);
+    m_itemInfos.append(ItemInfo{id, device, address, format});
+}
+
+void mbClientDataLogger::append(mb::Client::ItemHandle_t handle, const QByteArray &data, mb::StatusCode status, mb::Timestamp_t timestamp)
+{
+    auto it = m_ids.constFind(handle);
+    if (it == m_ids.constEnd())
+        return;
+    QMutexLocker _(&m_mutex);
+    if (m_pending.count() >= MaxPending)
+    {
+        // Note: writer can't keep up (e.g. disk is too slow), so drop the record instead of blocking polling thread
+        ++m_dropped;
+        return;
+    }
+    m_pending.append(Record{timestamp, it.value(), static_cast<quint32>(status), data});
+    if (m_pending.count() >= FlushCount)
+        m_cond.wakeOne();
+}
+
+void mbClientDataLogger::stop()
+{
+    QMutexLocker _(&m_mutex);
+    m_ctrlRun = false;
+    m_cond.wakeOne();
+}
+
+void mbClientDataLogger::run()
+{
+    {
+        QMutexLocker _(&m_mutex);
+        m_ctrlRun = true;
+    }
+    if (!openFile())
+        return;
+    mbClient::LogInfo(QStringLiteral("DataLog"), QString("Start logging to '%1'").arg(m_file.fileName()));
+    Records_t records;
+    bool run = true;
+    while (run)
+    {
+        {
+            QMutexLocker _(&m_mutex);
+            if (m_ctrlRun && (m_pending.count() < FlushCount))
+                m_cond.wait(&m_mutex, FlushPeriod);
+            run = m_ctrlRun;
+            records.swap(m_pending); // Note: 'records' is empty here so writers get empty buffer back
+        }
+        if (records.count())
+        {
+            if (needRotate())
+            {
+                closeFile();
+                if (!openFile())
+                    return;
+            }
+            writeDataBlock(records);
+            records.clear();
+        }
+    }
+    closeFile();
+    if (m_dropped)
+        mbClient::LogWarning(QStringLiteral("DataLog"), QString("%1 record(s) were dropped due to overload").arg(m_dropped));
+    mbClient::LogInfo(QStringLiteral("DataLog"), QStringLiteral("Finish logging"));
+}
+
+bool mbClientDataLogger::openFile()
+{
+    // Note: every file (including rotated ones) gets own creation time suffix: <name>_yyyyMMdd_hhmmss_zzz[_N].<ext>,
+    // sequence number 'N' is added when file with the same name already exists (e.g. rotated within the same millisecond)
+    QFileInfo fi(m_fileName);
+    QString suffix = fi.completeSuffix();
+    if (suffix.isEmpty())
+        suffix = QStringLiteral("mbdl");
+    QString base = QString("%1_%2").arg(fi.baseName(), QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_hhmmss_zzz")));
+    QString filePath = fi.dir().filePath(QString("%1.%2").arg(base, suffix));
+    for (int i = 1; QFileInfo::exists(filePath); i++)
+        filePath = fi.dir().filePath(QString("%1_%2.%3").arg(base).arg(i).arg(suffix));
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        mbClient::LogError(QStringLiteral("DataLog"), QString("Can't open file '%1': %2").arg(m_file.fileName(), m_file.errorString()));
+        return false;
+    }
+    m_fileTimestamp = mb::currentTimestamp();
+    m_lastIndexOffset = -1;
+    m_index.clear();
+
+    QByteArray header;
+    header.append("MBDL", 4);
+    appendValue<quint16>(header, Version);
+    appendValue<quint16>(header, 0);
+    appendValue<qint64>(header, m_fileTimestamp);
+    appendValue<quint32>(header, static_cast<quint32>(m_itemInfos.count()));
+    Q_FOREACH (const ItemInfo &info, m_itemInfos)
+    {
+        appendValue<quint32>(header, info.id);
+        appendString(header, info.device);
+        appendString(header, info.address);
+        appendString(header, info.format);
+    }
+    m_file.write(header);
+    return true;
+}
+
+void mbClientDataLogger::closeFile()
+{
+    if (!m_file.isOpen())
+        return;
+    if (m_index.count())
+        writeIndexBlock();
+    m_file.close();
+}
+
+bool mbClientDataLogger::needRotate() const
+{
+    if ((m_maxFileSize > 0) && (m_file.size() >= m_maxFileSize))
+        return true;
+    if ((m_rotatePeriod > 0) && ((mb::currentTimestamp() - m_fileTimestamp) >= m_rotatePeriod))
+        return true;
+    return false;
+}
+
+void mbClientDataLogger::writeDataBlock(const Records_t &records)
+{
+    const int count = records.count();
+    int dataSize = 0;
+    for (const Record &r : records)
+        dataSize += r.data.size();
+
+    QByteArray payload;
+    payload.reserve(4 + count * (8 + 4 + 4 + 2) + dataSize);
+    appendValue<quint32>(payload, static_cast<quint32>(count));
+    for (const Record &r : records)
+        appendValue<qint64>(payload, r.timestamp);
+    for (const Record &r : records)
+        appendValue<quint32>(payload, r.id);
+    for (const Record &r : records)
+        appendValue<quint32>(payload, r.status);
+    for (const Record &r : records)
+        appendValue<quint16>(payload, static_cast<quint16>(r.data.size()));
+    for (const Record &r : records)
+        payload.append(r.data);
+
+    IndexEntry e;
+    e.offset = m_file.pos();
+    e.firstTimestamp = records.first().timestamp;
+    e.lastTimestamp = records.last().timestamp;
+    e.count = static_cast<quint32>(count);
+    writeBlock('D', payload);
+    m_index.append(e);
+    if (m_index.count() >= IndexInterval)
+        writeIndexBlock();
+}
+
+void mbClientDataLogger::writeIndexBlock()
+{
+    QByteArray payload;
+    payload.reserve(12 + m_index.count() * (8 + 8 + 8 + 4));
+    appendValue<qint64>(payload, m_lastIndexOffset);
+    appendValue<quint32>(payload, static_cast<quint32>(m_index.count()));
+    for (const IndexEntry &e : m_index)
+    {
+        appendValue<qint64>(payload, e.offset);
+        appendValue<qint64>(payload, e.firstTimestamp);
+        appendValue<qint64>(payload, e.lastTimestamp);
+        appendValue<quint32>(payload, e.count);
+    }
+    m_lastIndexOffset = m_file.pos();
+    writeBlock('I', payload);
+    m_index.clear();
+    m_file.flush();
+}
+
+void mbClientDataLogger::writeBlock(quint32 type, const QByteArray &payload)
+{
+    QByteArray head;
+    appendValue<quint32>(head, type);
+    appendValue<quint32>(head, static_cast<quint32>(payload.size()));
+    m_file.write(head);
+    m_file.write(payload);
+}
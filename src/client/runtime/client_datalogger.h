@@ -0,0 +1,154 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_DATALOGGER_H
+#define CLIENT_DATALOGGER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QHash>
+#include <QVector>
+
+#include <client_global.h>
+
+/*
+   Data log file format (all numbers are little-endian):
+
+   File header:
+       char[4]  magic "MBDL"
+       quint16  version
+       quint16  reserved
+       qint64   creation timestamp (ms since epoch)
+       quint32  item count, followed by item descriptors:
+                quint32 id, string device, string address, string format
+                (string = quint16 byte length + UTF-8 bytes)
+
+   Then a sequence of blocks: quint32 block type, quint32 payload size, payload.
+
+   Data block ('D') stores records in columns:
+       quint32  record count N
+       qint64   timestamp[N]
+       quint32  item id[N]
+       quint32  status[N]
+       quint16  data size[N]
+       raw data bytes of all records one after another
+
+   Index block ('I') is written every 'IndexInterval' data blocks and when file is closed:
+       qint64   offset of previous index block (-1 if none)
+       quint32  entry count M
+       M * { qint64 block offset, qint64 first timestamp, qint64 last timestamp, quint32 record count }
+*/
+
+class mbClientDataLogger : public QThread
+{
+public:
+    enum Constants
+    {
+        Version       = 1,
+        IndexInterval = 16,     // data blocks per index block
+        FlushCount    = 4096,   // records that wake up writer before flush period
+        FlushPeriod   = 1000,   // ms
+        MaxPending    = 1048576 // records kept in memory before new ones are dropped
+    };
+
+public:
+    explicit mbClientDataLogger(const QString &fileName, QObject *parent = nullptr);
+    ~mbClientDataLogger();
+
+public:
+    inline QString fileName() const { return m_fileName; }
+    inline qint64 maxFileSize() const { return m_maxFileSize; }
+    inline void setMaxFileSize(qint64 size) { m_maxFileSize = size; }
+    inline qint64 rotatePeriod() const { return m_rotatePeriod; }
+    inline void setRotatePeriod(qint64 ms) { m_rotatePeriod = ms; }
+
+public:
+    // Note: must be called before thread is started
+    void addItem(mb::Client::ItemHandle_t handle, const QString &device, const QString &address, const QString &format);
+
+public:
+    void append(mb::Client::ItemHandle_t handle, const QByteArray &data, mb::StatusCode status, mb::Timestamp_t timestamp);
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    struct Record
+    {
+        mb::Timestamp_t timestamp;
+        quint32 id;
+        quint32 status;
+        QByteArray data;
+    };
+    typedef QVector<Record> Records_t;
+
+    struct IndexEntry
+    {
+        qint64 offset;
+        qint64 firstTimestamp;
+        qint64 lastTimestamp;
+        quint32 count;
+    };
+
+    struct ItemInfo
+    {
+        quint32 id;
+        QString device;
+        QString address;
+        QString format;
+    };
+
+private:
+    bool openFile();
+    void closeFile();
+    bool needRotate() const;
+    void writeDataBlock(const Records_t &records);
+    void writeIndexBlock();
+    void writeBlock(quint32 type, const QByteArray &payload);
+
+private:
+    const QString m_fileName;
+    qint64 m_maxFileSize;
+    qint64 m_rotatePeriod;
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_cond;
+    Records_t m_pending;
+    quint32 m_dropped;
+    bool m_ctrlRun;
+
+private:
+    QHash<mb::Client::ItemHandle_t, quint32> m_ids;
+    QList<ItemInfo> m_itemInfos;
+
+private: // accessed from logger thread only
+    QFile m_file;
+    mb::Timestamp_t m_fileTimestamp;
+    qint64 m_lastIndexOffset;
+    QVector<IndexEntry> m_index;
+};
+
+#endif // CLIENT_DATALOGGER_H
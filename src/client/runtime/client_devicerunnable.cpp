@@ -22,11 +22,16 @@
 */
 #include "client_devicerunnable.h"
 
+#include <limits>
+#include <algorithm>
+
 #include <ModbusClientPort.h>
 #include <ModbusClient.h>
 
 #include <client.h>
 
+#include <project/client_device.h>
+
 #include "client_rundevice.h"
 #include "client_runmessage.h"
 #include "client_runitem.h"
@@ -115,10 +120,44 @@ void mbClientDeviceRunnable::run()
     while (fRepeat);
 }
 
+void mbClientDeviceRunnable::beginTransaction()
+{
+    m_rttTimer.start();
+}
+
+void mbClientDeviceRunnable::endTransaction(bool lost)
+{
+    if (!m_rttTimer.isValid())
+        return;
+    if (lost)
+        m_rtt.backoff();
+    else
+        m_rtt.addSample(static_cast<uint32_t>(m_rttTimer.elapsed()));
+    m_rttTimer.invalidate();
+    m_device->device()->setStatResponseTime(m_rtt.lastRtt(), m_rtt.smoothedRtt(), m_rtt.rttVariance(), m_rtt.timeout());
+}
+
+mb::Timestamp_t mbClientDeviceRunnable::nextDeadline() const
+{
+    // Note: device is busy (request in progress or pending) so it must be processed immediately
+    if ((m_state != STATE_PAUSE) || m_currentMessage || hasWriteMessage() || m_device->hasExternalMessage())
+        return 0;
+    mb::Timestamp_t deadline = std::numeric_limits<mb::Timestamp_t>::max();
+    for (Messages_t::ConstIterator it = m_readMessages.constBegin(); it != m_readMessages.constEnd(); ++it)
+    {
+        const mbClientRunMessagePtr &m = *it;
+        mb::Timestamp_t tm = m->beginTimestamp() + m->period();
+        if (tm < deadline)
+            deadline = tm;
+    }
+    return deadline;
+}
+
 void mbClientDeviceRunnable::createReadMessages()
 {
     QList<mbClientRunItem*> items;
     m_device->popItemsToRead(items);
+    shareReadPeriods(items);
     Q_FOREACH (mbClientRunItem *item, items)
     {
         mbClientRunMessagePtr m = nullptr;
@@ -158,6 +197,41 @@ void mbClientDeviceRunnable::createReadMessages()
     }
 }
 
+void mbClientDeviceRunnable::shareReadPeriods(QList<mbClientRunItem*> &items)
+{
+    // Note: items of the same device can come from different data views (or have different formats)
+    //       and point to the same (or overlapping) memory. Overlapping items get the fastest period of
+    //       the group so they are merged into a single read message and results are fanned out
+    //       to every item from that message instead of polling the same memory several times.
+    //       Group contains only items that share common register range with each other (all of them
+    //       start before the earliest end of the group), so one wide item can't chain items
+    //       that don't overlap and speed up their polling.
+    std::sort(items.begin(), items.end(), [](const mbClientRunItem *a, const mbClientRunItem *b) {
+        if (a->memoryType() != b->memoryType())
+            return a->memoryType() < b->memoryType();
+        return a->offset() < b->offset();
+    });
+    int begin = 0;
+    while (begin < items.count())
+    {
+        mbClientRunItem *first = items.at(begin);
+        uint32_t end = static_cast<uint32_t>(first->offset()) + first->count();
+        uint32_t period = first->period();
+        int i = begin + 1;
+        for (; i < items.count(); ++i)
+        {
+            mbClientRunItem *item = items.at(i);
+            if ((item->memoryType() != first->memoryType()) || (item->offset() >= end))
+                break;
+            end = qMin(end, static_cast<uint32_t>(item->offset()) + item->count());
+            period = qMin(period, item->period());
+        }
+        for (int j = begin; j < i; ++j)
+            items.at(j)->setPeriod(period);
+        begin = i;
+    }
+}
+
 void mbClientDeviceRunnable::pushReadMessage(const mbClientRunMessagePtr &message)
 {
     message->setDeleteItems(false);
@@ -512,5 +586,7 @@ Modbus::StatusCode mbClientDeviceRunnable::execReadMessage()
         mbClient::LogError(m_device->name(), text);
     }
     m_currentMessage->setComplete(res, QDateTime::currentMSecsSinceEpoch());
+    if (m_currentMessage->achievedPeriod())
+        m_device->device()->setStatPolling(m_currentMessage->achievedPeriod(), m_currentMessage->lateness(), m_currentMessage->skippedCycles());
     return res;
 }
@@ -25,14 +25,18 @@
 
 #include <QQueue>
 #include <QRunnable>
+#include <QElapsedTimer>
 
 #include <Modbus.h>
 #include <client_global.h>
 
+#include "client_rttestimator.h"
+
 class ModbusClientPort;
 class ModbusClient;
 
 class mbClientRunDevice;
+class mbClientRunItem;
 
 class mbClientDeviceRunnable : public QRunnable
 {
@@ -54,12 +58,20 @@ public:
     inline mbClientRunDevice *device() const { return m_device; }
     inline ModbusClient *modbusClient() const { return m_modbusClient; }
     inline mbClientRunMessagePtr currentMessage() const { return m_currentMessage; }
+    inline QList<mbClientRunMessagePtr> readMessages() const { return m_readMessages; }
 
 public:
     void run() override;
+    mb::Timestamp_t nextDeadline() const;
+
+public: // response time
+    inline mbClientRttEstimator &rtt() { return m_rtt; }
+    void beginTransaction();
+    void endTransaction(bool lost);
 
 private:
     void createReadMessages();
+    static void shareReadPeriods(QList<mbClientRunItem*> &items);
     void pushReadMessage(const mbClientRunMessagePtr &message);
 
 private:
@@ -91,6 +103,10 @@ private:
     Messages_t m_readMessages;
 
     mbClientRunMessagePtr m_currentMessage;
+
+private:
+    mbClientRttEstimator m_rtt;
+    QElapsedTimer m_rttTimer;
 };
 
 #endif // CLIENT_DEVICERUNNABLE_H
@@ -0,0 +1,409 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_expression.h"
+
+#include <QVarLengthArray>
+#include <QtMath>
+
+mbClientExpression::mbClientExpression()
+{
+    m_stackSize = 0;
+    m_pos = 0;
+    m_depth = 0;
+}
+
+bool mbClientExpression::compile(const QString &source)
+{
+    m_code.clear();
+    m_references.clear();
+    m_error.clear();
+    m_source = source;
+    m_pos = 0;
+    m_depth = 0;
+    m_stackSize = 0;
+    bool ok = parseConditional();
+    if (ok)
+    {
+        skipSpaces();
+        if (m_pos < m_source.length())
+            ok = setError(QString("Unexpected '%1' at position %2").arg(m_source.at(m_pos)).arg(m_pos+1));
+    }
+    m_source.clear();
+    if (!ok)
+    {
+        m_code.clear();
+        m_references.clear();
+    }
+    return ok;
+}
+
+double mbClientExpression::evaluate(const double *inputs) const
+{
+    // Note: stack size is computed while compiling, so it's never exceeded here
+    QVarLengthArray<double, 32> stack(m_stackSize);
+    int sp = -1;
+    const Instruction *ins = m_code.constData();
+    const Instruction *end = ins + m_code.count();
+    for (; ins != end; ++ins)
+    {
+        switch (ins->op)
+        {
+        case Op_Const: stack[++sp] = ins->value;         break;
+        case Op_Input: stack[++sp] = inputs[ins->index]; break;
+        case Op_Neg  : stack[sp] = -stack[sp];           break;
+        case Op_Not  : stack[sp] = (stack[sp] == 0.0);   break;
+        case Op_Abs  : stack[sp] = qAbs(stack[sp]);      break;
+        case Op_Sqrt : stack[sp] = qSqrt(stack[sp]);     break;
+        case Op_Round: stack[sp] = std::round(stack[sp]);break;
+        case Op_Floor: stack[sp] = qFloor(stack[sp]);    break;
+        case Op_Ceil : stack[sp] = qCeil(stack[sp]);     break;
+        case Op_Cond:
+            sp -= 2;
+            stack[sp] = (stack[sp] != 0.0) ? stack[sp+1] : stack[sp+2];
+            break;
+        default:
+        {
+            double b = stack[sp--];
+            double &a = stack[sp];
+            switch (ins->op)
+            {
+            case Op_Add: a = a + b; break;
+            case Op_Sub: a = a - b; break;
+            case Op_Mul: a = a * b; break;
+            case Op_Div: a = a / b; break;
+            case Op_Mod: a = std::fmod(a, b); break;
+            case Op_Lt : a = (a <  b); break;
+            case Op_Le : a = (a <= b); break;
+            case Op_Gt : a = (a >  b); break;
+            case Op_Ge : a = (a >= b); break;
+            case Op_Eq : a = (a == b); break;
+            case Op_Ne : a = (a != b); break;
+            case Op_And: a = ((a != 0.0) && (b != 0.0)); break;
+            case Op_Or : a = ((a != 0.0) || (b != 0.0)); break;
+            case Op_Min: a = qMin(a, b); break;
+            case Op_Max: a = qMax(a, b); break;
+            case Op_Pow: a = qPow(a, b); break;
+            case Op_Bit:
+                // Note: conversion and shift are defined only for finite 'a' within 64-bit range and 0 <= 'b' < 64
+                if ((a >= -9223372036854775808.0) && (a < 9223372036854775808.0) && (b >= 0.0) && (b < 64.0))
+                    a = (static_cast<qint64>(a) >> static_cast<int>(b)) & 1;
+                else
+                    a = qQNaN();
+                break;
+            default:
+                break;
+            }
+        }
+            break;
+        }
+    }
+    return sp == 0 ? stack[0] : 0.0;
+}
+
+void mbClientExpression::skipSpaces()
+{
+    while ((m_pos < m_source.length()) && m_source.at(m_pos).isSpace())
+        m_pos++;
+}
+
+bool mbClientExpression::match(const char *token)
+{
+    skipSpaces();
+    int len = static_cast<int>(qstrlen(token));
+    if (m_source.midRef(m_pos, len) == QLatin1String(token))
+    {
+        m_pos += len;
+        return true;
+    }
+    return false;
+}
+
+void mbClientExpression::addInstruction(OpCode op, int index, double value)
+{
+    Instruction ins;
+    ins.op = op;
+    ins.index = index;
+    ins.value = value;
+    m_code.append(ins);
+    switch (op)
+    {
+    case Op_Const:
+    case Op_Input:
+        m_depth++;
+        if (m_depth > m_stackSize)
+            m_stackSize = m_depth;
+        break;
+    case Op_Neg:
+    case Op_Not:
+    case Op_Abs:
+    case Op_Sqrt:
+    case Op_Round:
+    case Op_Floor:
+    case Op_Ceil:
+        break;
+    case Op_Cond:
+        m_depth -= 2;
+        break;
+    default:
+        m_depth--;
+        break;
+    }
+}
+
+bool mbClientExpression::parseConditional()
+{
+    if (!parseOr())
+        return false;
+    if (match("?"))
+    {
+        if (!parseConditional())
+            return false;
+        if (!match(":"))
+            return setError(QString("Expected ':' at position %1").arg(m_pos+1));
+        if (!parseConditional())
+            return false;
+        addInstruction(Op_Cond);
+    }
+    return true;
+}
+
+bool mbClientExpression::parseOr()
+{
+    if (!parseAnd())
+        return false;
+    while (match("||"))
+    {
+        if (!parseAnd())
+            return false;
+        addInstruction(Op_Or);
+    }
+    return true;
+}
+
+bool mbClientExpression::parseAnd()
+{
+    if (!parseCompare())
+        return false;
+    while (match("&&"))
+    {
+        if (!parseCompare())
+            return false;
+        addInstruction(Op_And);
+    }
+    return true;
+}
+
+bool mbClientExpression::parseCompare()
+{
+    if (!parseAdd())
+        return false;
+    for (;;)
+    {
+        OpCode op;
+        // Note: two-char operators must be checked first
+        if      (match("<=")) op = Op_Le;
+        else if (match(">=")) op = Op_Ge;
+        else if (match("==")) op = Op_Eq;
+        else if (match("!=")) op = Op_Ne;
+        else if (match("<" )) op = Op_Lt;
+        else if (match(">" )) op = Op_Gt;
+        else
+            return true;
+        if (!parseAdd())
+            return false;
+        addInstruction(op);
+    }
+}
+
+bool mbClientExpression::parseAdd()
+{
+    if (!parseMul())
+        return false;
+    for (;;)
+    {
+        OpCode op;
+        if      (match("+")) op = Op_Add;
+        else if (match("-")) op = Op_Sub;
+        else
+            return true;
+        if (!parseMul())
+            return false;
+        addInstruction(op);
+    }
+}
+
+bool mbClientExpression::parseMul()
+{
+    if (!parseUnary())
+        return false;
+    for (;;)
+    {
+        OpCode op;
+        if      (match("*")) op = Op_Mul;
+        else if (match("/")) op = Op_Div;
+        else if (match("%")) op = Op_Mod;
+        else
+            return true;
+        if (!parseUnary())
+            return false;
+        addInstruction(op);
+    }
+}
+
+bool mbClientExpression::parseUnary()
+{
+    if (match("-"))
+    {
+        if (!parseUnary())
+            return false;
+        addInstruction(Op_Neg);
+        return true;
+    }
+    if (match("+"))
+        return parseUnary();
+    if (match("!"))
+    {
+        if (!parseUnary())
+            return false;
+        addInstruction(Op_Not);
+        return true;
+    }
+    return parsePrimary();
+}
+
+bool mbClientExpression::parsePrimary()
+{
+    skipSpaces();
+    if (m_pos >= m_source.length())
+        return setError(QStringLiteral("Unexpected end of expression"));
+    QChar c = m_source.at(m_pos);
+    if (c == '(')
+    {
+        m_pos++;
+        if (!parseConditional())
+            return false;
+        if (!match(")"))
+            return setError(QString("Expected ')' at position %1").arg(m_pos+1));
+        return true;
+    }
+    if (c == '{')
+    {
+        int end = m_source.indexOf('}', m_pos+1);
+        if (end < 0)
+            return setError(QString("Unterminated reference at position %1").arg(m_pos+1));
+        QString name = m_source.mid(m_pos+1, end-m_pos-1).trimmed();
+        if (name.isEmpty())
+            return setError(QString("Empty reference at position %1").arg(m_pos+1));
+        m_pos = end+1;
+        int index = m_references.indexOf(name);
+        if (index < 0)
+        {
+            index = m_references.count();
+            m_references.append(name);
+        }
+        addInstruction(Op_Input, index);
+        return true;
+    }
+    if (c.isDigit() || (c == '.'))
+    {
+        int begin = m_pos;
+        bool ok;
+        double v;
+        if (m_source.midRef(m_pos, 2).compare(QLatin1String("0x"), Qt::CaseInsensitive) == 0)
+        {
+            m_pos += 2;
+            while ((m_pos < m_source.length()) && isxdigit(m_source.at(m_pos).toLatin1()))
+                m_pos++;
+            v = static_cast<double>(m_source.midRef(begin+2, m_pos-begin-2).toULongLong(&ok, 16));
+        }
+        else
+        {
+            while ((m_pos < m_source.length()) && (m_source.at(m_pos).isDigit() || (m_source.at(m_pos) == '.')))
+                m_pos++;
+            if ((m_pos < m_source.length()) && (m_source.at(m_pos).toLower() == 'e'))
+            {
+                m_pos++;
+                if ((m_pos < m_source.length()) && ((m_source.at(m_pos) == '-') || (m_source.at(m_pos) == '+')))
+                    m_pos++;
+                while ((m_pos < m_source.length()) && m_source.at(m_pos).isDigit())
+                    m_pos++;
+            }
+            v = m_source.midRef(begin, m_pos-begin).toDouble(&ok);
+        }
+        if (!ok)
+            return setError(QString("Invalid number at position %1").arg(begin+1));
+        addInstruction(Op_Const, 0, v);
+        return true;
+    }
+    if (c.isLetter())
+    {
+        int begin = m_pos;
+        while ((m_pos < m_source.length()) && m_source.at(m_pos).isLetterOrNumber())
+            m_pos++;
+        return parseFunction(m_source.mid(begin, m_pos-begin).toLower());
+    }
+    return setError(QString("Unexpected '%1' at position %2").arg(c).arg(m_pos+1));
+}
+
+bool mbClientExpression::parseFunction(const QString &name)
+{
+    struct Function { const char *name; OpCode op; int args; };
+    static const Function functions[] =
+    {
+        { "abs"  , Op_Abs  , 1 },
+        { "sqrt" , Op_Sqrt , 1 },
+        { "round", Op_Round, 1 },
+        { "floor", Op_Floor, 1 },
+        { "ceil" , Op_Ceil , 1 },
+        { "min"  , Op_Min  , 2 },
+        { "max"  , Op_Max  , 2 },
+        { "pow"  , Op_Pow  , 2 },
+        { "bit"  , Op_Bit  , 2 }
+    };
+    for (const Function &f : functions)
+    {
+        if (name != QLatin1String(f.name))
+            continue;
+        if (!match("("))
+            return setError(QString("Expected '(' after '%1'").arg(name));
+        for (int i = 0; i < f.args; i++)
+        {
+            if (i && !match(","))
+                return setError(QString("Expected ',' at position %1").arg(m_pos+1));
+            if (!parseConditional())
+                return false;
+        }
+        if (!match(")"))
+            return setError(QString("Expected ')' at position %1").arg(m_pos+1));
+        addInstruction(f.op);
+        return true;
+    }
+    return setError(QString("Unknown function '%1'").arg(name));
+}
+
+bool mbClientExpression::setError(const QString &error)
+{
+    if (m_error.isEmpty())
+        m_error = error;
+    return false;
+}
@@ -0,0 +1,118 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_EXPRESSION_H
+#define CLIENT_EXPRESSION_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/*
+   Arithmetic expression of the computed data view item. Expression is compiled
+   once into postfix code, so evaluation doesn't parse anything.
+
+   Operands:  numbers (1, 0.5, 1e3, 0x1F), references to other items '{name}'
+   Operators: ?: || && == != < <= > >= + - * / % unary - + !
+   Functions: abs(x) sqrt(x) round(x) floor(x) ceil(x) min(x,y) max(x,y)
+              pow(x,y) bit(x,n) - value of bit 'n' of integer 'x'
+              (NaN if 'x' is not finite or out of 64-bit range or 'n' is not in [0, 63])
+*/
+class mbClientExpression
+{
+public:
+    mbClientExpression();
+
+public:
+    bool compile(const QString &source);
+    inline bool isValid() const { return m_code.count() > 0; }
+    inline QString errorString() const { return m_error; }
+    inline const QStringList &references() const { return m_references; }
+    double evaluate(const double *inputs) const;
+
+private:
+    enum OpCode
+    {
+        Op_Const,
+        Op_Input,
+        Op_Neg,
+        Op_Not,
+        Op_Add,
+        Op_Sub,
+        Op_Mul,
+        Op_Div,
+        Op_Mod,
+        Op_Lt,
+        Op_Le,
+        Op_Gt,
+        Op_Ge,
+        Op_Eq,
+        Op_Ne,
+        Op_And,
+        Op_Or,
+        Op_Cond,
+        Op_Abs,
+        Op_Sqrt,
+        Op_Round,
+        Op_Floor,
+        Op_Ceil,
+        Op_Min,
+        Op_Max,
+        Op_Pow,
+        Op_Bit
+    };
+
+    struct Instruction
+    {
+        OpCode op;
+        int index;
+        double value;
+    };
+
+private:
+    void skipSpaces();
+    bool match(const char *token);
+    void addInstruction(OpCode op, int index = 0, double value = 0);
+    bool parseConditional();
+    bool parseOr();
+    bool parseAnd();
+    bool parseCompare();
+    bool parseAdd();
+    bool parseMul();
+    bool parseUnary();
+    bool parsePrimary();
+    bool parseFunction(const QString &name);
+    bool setError(const QString &error);
+
+private:
+    QVector<Instruction> m_code;
+    QStringList m_references;
+    int m_stackSize;
+    QString m_error;
+
+private: // compile state
+    QString m_source;
+    int m_pos;
+    int m_depth;
+};
+
+#endif // CLIENT_EXPRESSION_H
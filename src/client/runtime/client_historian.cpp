@@ -0,0 +1,165 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_historian.h"
+
+const mb::Timestamp_t mbClientHistorian::LevelResolution[mbClientHistorian::LevelCount] = { 1000, 10000, 60000, 600000 };
+
+void mbClientHistorian::Ring::push(const Sample &s)
+{
+    if (m_buff.count() < m_capacity)
+    {
+        m_buff.append(s);
+        return;
+    }
+    m_buff[m_head] = s; // overwrite the oldest sample
+    m_head = (m_head + 1) % m_capacity;
+}
+
+void mbClientHistorian::Ring::collect(mb::Timestamp_t begin, mb::Timestamp_t end, Samples_t &out) const
+{
+    const int c = count();
+    // Note: samples are ordered by time, so find first one within range using binary search
+    int lo = 0, hi = c;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (at(mid).timestamp < begin)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (int i = lo; i < c; i++)
+    {
+        const Sample &s = at(i);
+        if (s.timestamp > end)
+            break;
+        out.append(s);
+    }
+}
+
+mbClientHistorian::Series::Series()
+{
+    raw.setCapacity(RawCapacity);
+    for (int i = 0; i < LevelCount; i++)
+    {
+        levels[i].setCapacity(LevelCapacity);
+        current[i].count = 0;
+    }
+}
+
+mbClientHistorian::mbClientHistorian()
+{
+}
+
+mbClientHistorian::~mbClientHistorian()
+{
+    qDeleteAll(m_series);
+}
+
+bool mbClientHistorian::isNumeric(mb::Format format)
+{
+    switch (format)
+    {
+    case mb::ByteArray:
+    case mb::String:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void mbClientHistorian::addItem(mb::Client::ItemHandle_t handle)
+{
+    Series *&series = m_series[handle];
+    if (!series)
+        series = new Series;
+}
+
+void mbClientHistorian::append(mb::Client::ItemHandle_t handle, mb::Timestamp_t timestamp, double value)
+{
+    Series *series = m_series.value(handle);
+    if (!series)
+        return;
+    QMutexLocker _(&series->lock);
+    series->raw.push(Sample{timestamp, value, value, value, 1});
+    for (int i = 0; i < LevelCount; i++)
+    {
+        Sample &b = series->current[i];
+        mb::Timestamp_t bucket = timestamp - (timestamp % LevelResolution[i]);
+        if (b.count && (b.timestamp != bucket))
+        {
+            series->levels[i].push(b);
+            b.count = 0;
+        }
+        if (b.count == 0)
+        {
+            b = Sample{bucket, value, value, value, 1};
+            continue;
+        }
+        if (value < b.min)
+            b.min = value;
+        if (value > b.max)
+            b.max = value;
+        b.avg += (value - b.avg) / (++b.count); // running mean
+    }
+}
+
+mbClientHistorian::Samples_t mbClientHistorian::samples(mb::Client::ItemHandle_t handle, mb::Timestamp_t begin, mb::Timestamp_t end, int maxCount) const
+{
+    Samples_t res;
+    Series *series = m_series.value(handle);
+    if (!series)
+        return res;
+    QMutexLocker _(&series->lock);
+    // Note: use raw samples when they cover the requested range and fit 'maxCount',
+    //       otherwise use the finest rollup that fits, falling back to the coarsest one
+    const mb::Timestamp_t span = end - begin;
+    if (series->raw.count() && (series->raw.oldestTimestamp() <= begin || series->levels[0].count() == 0))
+    {
+        series->raw.collect(begin, end, res);
+        if (res.count() <= maxCount)
+            return res;
+        res.clear();
+    }
+    for (int i = 0; i < LevelCount; i++)
+    {
+        const bool last = (i == LevelCount-1);
+        const Ring &level = series->levels[i];
+        if (!last && (span / LevelResolution[i] > maxCount))
+            continue;
+        if (!last && level.count() && (level.oldestTimestamp() > begin) && (series->levels[i+1].count() > 0))
+            continue; // coarser level keeps longer history
+        level.collect(begin, end, res);
+        const Sample &b = series->current[i];
+        if (b.count && (b.timestamp >= begin) && (b.timestamp <= end))
+            res.append(b);
+        return res;
+    }
+    return res;
+}
+
+void mbClientHistorian::clear()
+{
+    qDeleteAll(m_series);
+    m_series.clear();
+}
@@ -0,0 +1,114 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_HISTORIAN_H
+#define CLIENT_HISTORIAN_H
+
+#include <QMutex>
+#include <QHash>
+#include <QVector>
+
+#include <client_global.h>
+
+/*
+   In-memory history of numeric item values.
+   Every item keeps a ring buffer of raw samples plus ring buffers of min/max/avg
+   rollups at several fixed resolutions. Rollups are maintained incrementally on
+   every append, so reading any time range costs at most as many samples as the
+   caller can display.
+   Items are registered before runtime threads are started, so the map of series
+   is not changed while polling and every series is guarded by its own mutex.
+*/
+
+class mbClientHistorian
+{
+public:
+    struct Sample
+    {
+        mb::Timestamp_t timestamp; // begin of the bucket for rollups
+        double min;
+        double max;
+        double avg;
+        quint32 count;
+    };
+    typedef QVector<Sample> Samples_t;
+
+    enum Constants
+    {
+        RawCapacity   = 2048,
+        LevelCapacity = 1024,
+        LevelCount    = 4
+    };
+
+    // Note: rollup resolutions in milliseconds (1 sec, 10 sec, 1 min, 10 min)
+    static const mb::Timestamp_t LevelResolution[LevelCount];
+
+public:
+    mbClientHistorian();
+    ~mbClientHistorian();
+
+public:
+    static bool isNumeric(mb::Format format);
+
+public:
+    // Note: must be called before runtime threads are started
+    void addItem(mb::Client::ItemHandle_t handle);
+    inline bool contains(mb::Client::ItemHandle_t handle) const { return m_series.contains(handle); }
+    void append(mb::Client::ItemHandle_t handle, mb::Timestamp_t timestamp, double value);
+    Samples_t samples(mb::Client::ItemHandle_t handle, mb::Timestamp_t begin, mb::Timestamp_t end, int maxCount) const;
+    void clear();
+
+private:
+    class Ring
+    {
+    public:
+        Ring() : m_capacity(0), m_head(0) {}
+
+    public:
+        inline void setCapacity(int capacity) { m_capacity = capacity; }
+        inline int count() const { return m_buff.count(); }
+        inline const Sample &at(int i) const { return m_buff.at((m_head + i) % m_buff.count()); } // 0 - oldest
+        inline mb::Timestamp_t oldestTimestamp() const { return m_buff.count() ? at(0).timestamp : 0; }
+        void push(const Sample &s);
+        void collect(mb::Timestamp_t begin, mb::Timestamp_t end, Samples_t &out) const;
+
+    private:
+        int m_capacity;
+        int m_head;
+        Samples_t m_buff;
+    };
+
+    struct Series
+    {
+        QMutex lock;
+        Ring raw;
+        Ring levels[LevelCount];
+        Sample current[LevelCount]; // rollup bucket which is not completed yet
+
+        Series();
+    };
+
+private:
+    QHash<mb::Client::ItemHandle_t, Series*> m_series;
+};
+
+#endif // CLIENT_HISTORIAN_H
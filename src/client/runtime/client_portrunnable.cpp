@@ -22,11 +22,14 @@
 */
 #include "client_portrunnable.h"
 
+#include <limits>
+
 #include <QEventLoop>
 #include <QElapsedTimer>
 
 #include <ModbusQt.h>
 #include <ModbusClientPort.h>
+#include <ModbusPort.h>
 #include <ModbusClient.h>
 
 #include <client.h>
@@ -38,6 +41,7 @@
 #include "client_rundevice.h"
 #include "client_devicerunnable.h"
 #include "client_runmessage.h"
+#include "client_busplanner.h"
 
 mbClientPortRunnable::mbClientPortRunnable(mbClientRunPort *port, const Modbus::Settings &settings, QObject *parent)
     : QObject(parent)
@@ -65,13 +69,31 @@ mbClientPortRunnable::mbClientPortRunnable(mbClientRunPort *port, const Modbus::
     m_modbusPort->connect(&ModbusClientPort::signalError    , this, &mbClientPortRunnable::slotError    );
     m_modbusPort->connect(&ModbusClientPort::signalCompleted, this, &mbClientPortRunnable::slotCompleted);
 
+    const mbClient *core = mbClient::global();
+    m_adaptiveTimeout = core->runtimeAdaptiveTimeout();
+    // Note: configured port timeout is the upper bound of adaptive timeout
+    m_portTimeout = m_modbusPort->port()->timeout();
+    uint32_t maxTimeout = m_portTimeout;
+    uint32_t minTimeout = static_cast<uint32_t>(qMax(core->runtimeAdaptiveTimeoutMin(), 0));
     Q_FOREACH (mbClientRunDevice *device, m_devices)
     {
         mbClientDeviceRunnable *d = new mbClientDeviceRunnable(device, m_modbusPort);
+        d->rtt().setBounds(minTimeout, maxTimeout);
         m_runnables.append(d);
         m_hashRunnables.insert(d->modbusClient(), d);
     }
     setName(settings.value(mbClientPort::Strings::instance().name).toString());
+
+    m_busPlanner = nullptr;
+    if (mbClientBusPlanner::isSerial(m_modbusPort->type()))
+    {
+        m_busPlanner = new mbClientBusPlanner(settings);
+        QList<mbClientRunMessagePtr> messages;
+        Q_FOREACH (mbClientDeviceRunnable *d, m_runnables)
+            messages.append(d->readMessages());
+        m_busPlanner->plan(messages, mbClient::global()->runtimeBusLoadTarget());
+        m_port->setStatBusLoad(m_busPlanner->projectedLoad(), 0);
+    }
 }
 
 mbClientPortRunnable::~mbClientPortRunnable()
@@ -79,6 +101,7 @@ mbClientPortRunnable::~mbClientPortRunnable()
     m_hashRunnables.clear();
     qDeleteAll(m_runnables);
     m_runnables.clear();
+    delete m_busPlanner;
     delete m_modbusPort;
 }
 
@@ -117,6 +140,9 @@ void mbClientPortRunnable::run()
     // Statistics
     qint64 microsElapsed = timer.nsecsElapsed() / 1000;
     m_port->setStatCycleTime(microsElapsed);
+    double load;
+    if (m_busPlanner && m_busPlanner->measure(mb::currentTimestamp(), &load))
+        m_port->setStatBusLoad(m_busPlanner->projectedLoad(), load);
 }
 
 void mbClientPortRunnable::close()
@@ -124,6 +150,20 @@ void mbClientPortRunnable::close()
     m_modbusPort->close();
 }
 
+mb::Timestamp_t mbClientPortRunnable::nextDeadline() const
+{
+    if ((m_state != STATE_PAUSE) || m_runPort->hasExternalMessage())
+        return 0;
+    mb::Timestamp_t deadline = std::numeric_limits<mb::Timestamp_t>::max();
+    Q_FOREACH (mbClientDeviceRunnable *d, m_runnables)
+    {
+        mb::Timestamp_t tm = d->nextDeadline();
+        if (tm < deadline)
+            deadline = tm;
+    }
+    return deadline;
+}
+
 Modbus::StatusCode mbClientPortRunnable::execExternalMessage()
 {
     Modbus::StatusCode res;
@@ -347,6 +387,23 @@ Modbus::StatusCode mbClientPortRunnable::execExternalMessage()
     return res;
 }
 
+void mbClientPortRunnable::beginTransaction(mbClientDeviceRunnable *device)
+{
+    device->beginTransaction();
+    if (m_adaptiveTimeout)
+        m_modbusPort->port()->setTimeout(device->rtt().timeout());
+}
+
+void mbClientPortRunnable::endTransaction(mbClientDeviceRunnable *device, bool lost)
+{
+    if (device)
+        device->endTransaction(lost);
+    // Note: adaptive timeout is valid only for the device transaction,
+    // so (re)connect and port-level messages must use configured timeout
+    if (m_adaptiveTimeout && (m_modbusPort->port()->timeout() != m_portTimeout))
+        m_modbusPort->port()->setTimeout(m_portTimeout);
+}
+
 void mbClientPortRunnable::slotBytesTx(const Modbus::Char */*source*/, const uint8_t* buff, uint16_t size)
 {
     const ModbusClient *c = reinterpret_cast<const ModbusClient*>(m_modbusPort->currentClient());
@@ -355,6 +412,7 @@ void mbClientPortRunnable::slotBytesTx(const Modbus::Char */*source*/, const uin
     if (r)
     {
         r->currentMessage()->setBytesTx(bytes);
+        beginTransaction(r);
         reinterpret_cast<mbClientDevice*>(c->context())->incStatCountTx();
         mbClient::LogTx(r->name(), Modbus::bytesToString(buff, size).data());
     }
@@ -366,6 +424,8 @@ void mbClientPortRunnable::slotBytesTx(const Modbus::Char */*source*/, const uin
         }
         mbClient::LogTx(name(), Modbus::bytesToString(buff, size).data());
     }
+    if (m_busPlanner)
+        m_busPlanner->addFrame(size);
     m_port->incStatCountTx();
 }
 
@@ -377,6 +437,7 @@ void mbClientPortRunnable::slotBytesRx(const Modbus::Char */*source*/, const uin
     if (r)
     {
         r->currentMessage()->setBytesRx(bytes);
+        endTransaction(r, false);
         reinterpret_cast<mbClientDevice*>(c->context())->incStatCountRx();
         mbClient::LogRx(r->name(), Modbus::bytesToString(buff, size).data());
     }
@@ -386,6 +447,8 @@ void mbClientPortRunnable::slotBytesRx(const Modbus::Char */*source*/, const uin
             m_currentMessage->setBytesRx(bytes);
         mbClient::LogRx(name(), Modbus::bytesToString(buff, size).data());
     }
+    if (m_busPlanner)
+        m_busPlanner->addFrame(size);
     m_port->incStatCountRx();
 }
 
@@ -397,6 +460,7 @@ void mbClientPortRunnable::slotAsciiTx(const Modbus::Char */*source*/, const uin
     if (r)
     {
         r->currentMessage()->setAsciiTx(bytes);
+        beginTransaction(r);
         reinterpret_cast<mbClientDevice*>(c->context())->incStatCountTx();
         mbClient::LogTx(r->name(), Modbus::asciiToString(buff, size).data());
     }
@@ -406,6 +470,8 @@ void mbClientPortRunnable::slotAsciiTx(const Modbus::Char */*source*/, const uin
             m_currentMessage->setAsciiTx(bytes);
         mbClient::LogTx(name(), Modbus::asciiToString(buff, size).data());
     }
+    if (m_busPlanner)
+        m_busPlanner->addFrame(size);
     m_port->incStatCountTx();
 }
 
@@ -417,6 +483,7 @@ void mbClientPortRunnable::slotAsciiRx(const Modbus::Char */*source*/, const uin
     if (r)
     {
         r->currentMessage()->setAsciiRx(bytes);
+        endTransaction(r, false);
         reinterpret_cast<mbClientDevice*>(c->context())->incStatCountRx();
         mbClient::LogRx(r->name(), Modbus::asciiToString(buff, size).data());
     }
@@ -426,6 +493,8 @@ void mbClientPortRunnable::slotAsciiRx(const Modbus::Char */*source*/, const uin
             m_currentMessage->setAsciiRx(bytes);
         mbClient::LogRx(name(), Modbus::asciiToString(buff, size).data());
     }
+    if (m_busPlanner)
+        m_busPlanner->addFrame(size);
     m_port->incStatCountRx();
 }
 
@@ -437,19 +506,21 @@ void mbClientPortRunnable::slotError(const Modbus::Char* /*source*/, Modbus::Sta
     const ModbusClient *c = reinterpret_cast<const ModbusClient*>(m_modbusPort->currentClient());
     mbClientDeviceRunnable *r = deviceRunnable(c);
     if (r)
-    {
         reinterpret_cast<mbClientDevice*>(c->context())->setStatStatus(status, tm, s);
-    }
+    // Note: any failure of the started transaction before valid response (read timeout,
+    // write or connection error) counts as lost response, response already received is not affected
+    endTransaction(r, true);
 }
 
 void mbClientPortRunnable::slotCompleted(const Modbus::Char *, Modbus::StatusCode status)
 {
+    const ModbusClient *c = reinterpret_cast<const ModbusClient*>(m_modbusPort->currentClient());
+    mbClientDeviceRunnable *r = deviceRunnable(c);
+    endTransaction(r, Modbus::StatusIsBad(status));
     if (Modbus::StatusIsGood(status))
     {
         Modbus::Timestamp tm = Modbus::currentTimestamp();
         m_port->setStatStatus(status, tm);
-        const ModbusClient *c = reinterpret_cast<const ModbusClient*>(m_modbusPort->currentClient());
-        mbClientDeviceRunnable *r = deviceRunnable(c);
         if (r)
         {
             reinterpret_cast<mbClientDevice*>(c->context())->setStatStatus(status, tm);
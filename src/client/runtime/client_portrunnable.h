@@ -35,6 +35,7 @@ class ModbusClientPort;
 class mbClientRunPort;
 class mbClientRunDevice;
 class mbClientDeviceRunnable;
+class mbClientBusPlanner;
 
 class mbClientPortRunnable : public QObject
 {
@@ -58,12 +59,15 @@ public:
 public:
     void run();
     void close();
+    mb::Timestamp_t nextDeadline() const;
 
 private:
     inline mbClientDeviceRunnable *deviceRunnable(const ModbusClient *c) const { return m_hashRunnables.value(c); }
 
 private:
     Modbus::StatusCode execExternalMessage();
+    void beginTransaction(mbClientDeviceRunnable *device);
+    void endTransaction(mbClientDeviceRunnable *device, bool lost);
 
 private Q_SLOTS:
     void slotBytesTx(const Modbus::Char *source, const uint8_t* buff, uint16_t size);
@@ -90,6 +94,11 @@ private:
     
     Runnables_t m_runnables;
     HashRunnables_t m_hashRunnables;
+
+private:
+    mbClientBusPlanner *m_busPlanner; // serial ports only
+    bool m_adaptiveTimeout;
+    uint32_t m_portTimeout; // configured timeout, used for connect and port-level messages
 };
 
 #endif // CLIENT_PORTRUNNABLE_H
@@ -0,0 +1,79 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_rttestimator.h"
+
+mbClientRttEstimator::mbClientRttEstimator()
+{
+    m_minTimeout = 0;
+    m_maxTimeout = 0;
+    reset();
+}
+
+void mbClientRttEstimator::setBounds(uint32_t minTimeout, uint32_t maxTimeout)
+{
+    m_maxTimeout = maxTimeout;
+    m_minTimeout = qMin(minTimeout, maxTimeout);
+    reset();
+}
+
+void mbClientRttEstimator::addSample(uint32_t rtt)
+{
+    m_lastRtt = rtt;
+    if (m_hasSample)
+    {
+        m_rttvar = 0.75 * m_rttvar + 0.25 * qAbs(m_srtt - rtt);
+        m_srtt   = 0.875 * m_srtt + 0.125 * rtt;
+    }
+    else
+    {
+        m_srtt = rtt;
+        m_rttvar = rtt / 2.0;
+        m_hasSample = true;
+    }
+    updateTimeout(m_srtt + qMax(static_cast<double>(Granularity), 4 * m_rttvar));
+}
+
+void mbClientRttEstimator::backoff()
+{
+    updateTimeout(2.0 * m_timeout);
+}
+
+void mbClientRttEstimator::reset()
+{
+    m_hasSample = false;
+    m_lastRtt = 0;
+    m_srtt = 0;
+    m_rttvar = 0;
+    // Note: no measurements yet, so use configured timeout
+    m_timeout = m_maxTimeout;
+}
+
+void mbClientRttEstimator::updateTimeout(double rto)
+{
+    if (rto < m_minTimeout)
+        m_timeout = m_minTimeout;
+    else if (rto > m_maxTimeout)
+        m_timeout = m_maxTimeout;
+    else
+        m_timeout = static_cast<uint32_t>(rto + 0.5);
+}
@@ -0,0 +1,78 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_RTTESTIMATOR_H
+#define CLIENT_RTTESTIMATOR_H
+
+#include <client_global.h>
+
+/*
+   Estimates response timeout of the device from measured round-trip times
+   the same way TCP calculates its retransmission timeout (RFC 6298):
+       RTTVAR = 3/4 * RTTVAR + 1/4 * |SRTT - R|
+       SRTT   = 7/8 * SRTT   + 1/8 * R
+       RTO    = SRTT + max(G, 4 * RTTVAR)
+   Timeout is doubled (up to maximum) every time response is lost.
+   Result is always bounded by [minTimeout, maxTimeout].
+*/
+class mbClientRttEstimator
+{
+public:
+    enum Constants
+    {
+        Granularity = 1 // ms
+    };
+
+public:
+    mbClientRttEstimator();
+
+public:
+    inline uint32_t minTimeout() const { return m_minTimeout; }
+    inline uint32_t maxTimeout() const { return m_maxTimeout; }
+    void setBounds(uint32_t minTimeout, uint32_t maxTimeout);
+
+public:
+    inline bool hasSample() const { return m_hasSample; }
+    inline uint32_t lastRtt() const { return m_lastRtt; }
+    inline uint32_t smoothedRtt() const { return static_cast<uint32_t>(m_srtt + 0.5); }
+    inline uint32_t rttVariance() const { return static_cast<uint32_t>(m_rttvar + 0.5); }
+    inline uint32_t timeout() const { return m_timeout; }
+
+public:
+    void addSample(uint32_t rtt);
+    void backoff();
+    void reset();
+
+private:
+    void updateTimeout(double rto);
+
+private:
+    uint32_t m_minTimeout;
+    uint32_t m_maxTimeout;
+    bool m_hasSample;
+    uint32_t m_lastRtt;
+    double m_srtt;
+    double m_rttvar;
+    uint32_t m_timeout;
+};
+
+#endif // CLIENT_RTTESTIMATOR_H
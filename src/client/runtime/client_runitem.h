@@ -40,6 +40,7 @@ public:
 public:
     inline mbClientRunMessage *message() const { return m_message; }
     inline void setMessage(mbClientRunMessage *message) { m_message = message;}
+    inline mb::Client::ItemHandle_t handle() const { return m_handle; }
 
 public:
     inline Modbus::MemoryType memoryType() const { return m_memoryType; }
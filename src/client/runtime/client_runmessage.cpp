@@ -22,6 +22,8 @@
 */
 #include "client_runmessage.h"
 
+#include <client.h>
+
 #include "client_runitem.h"
 
 mbClientRunMessage::mbClientRunMessage(mbClientRunItem *item, uint16_t maxCount, QObject *parent)
@@ -38,8 +40,12 @@ mbClientRunMessage::mbClientRunMessage(mbClientRunItem *item, uint16_t maxCount,
     m_writeCount = 0;
     m_period = item->period();
     m_status = Modbus::Status_Uncertain;
+    m_scheduledTimestamp = 0;
     m_beginTimestamp = 0;
     m_timestamp = 0;
+    m_achievedPeriod = 0;
+    m_lateness = 0;
+    m_skippedCycles = 0;
     addItemPrivate(item);
     m_deleteItems = false;
     m_isCompleted = false;
@@ -61,8 +67,12 @@ mbClientRunMessage::mbClientRunMessage(uint8_t unit, uint16_t offset, uint16_t c
     m_period = 0;
     m_maxCount = maxCount;
     m_status = Modbus::Status_Uncertain;
+    m_scheduledTimestamp = 0;
     m_beginTimestamp = 0;
     m_timestamp = 0;
+    m_achievedPeriod = 0;
+    m_lateness = 0;
+    m_skippedCycles = 0;
     m_deleteItems = false;
     m_isCompleted = false;
     memset(m_buff, 0, sizeof(m_buff));
@@ -131,7 +141,23 @@ Modbus::StatusCode mbClientRunMessage::setData(uint16_t innerOffset, uint16_t co
 
 void mbClientRunMessage::prepareToSend()
 {
-    m_beginTimestamp = mb::currentTimestamp();
+    mb::Timestamp_t tm = mb::currentTimestamp();
+    if (m_period && m_beginTimestamp)
+    {
+        // Note: periodic message is due one period after its previous send
+        m_scheduledTimestamp = m_beginTimestamp + m_period;
+        m_achievedPeriod = static_cast<uint32_t>(tm - m_beginTimestamp);
+        m_lateness = (tm > m_scheduledTimestamp) ? static_cast<uint32_t>(tm - m_scheduledTimestamp) : 0;
+        m_skippedCycles = m_lateness / m_period;
+    }
+    else
+    {
+        m_scheduledTimestamp = tm;
+        m_achievedPeriod = 0;
+        m_lateness = 0;
+        m_skippedCycles = 0;
+    }
+    m_beginTimestamp = tm;
 }
 
 void mbClientRunMessage::setComplete(Modbus::StatusCode status, mb::Timestamp_t timestamp)
@@ -226,6 +252,14 @@ void mbClientRunMessageRead::setComplete(Modbus::StatusCode status, mb::Timestam
         mbClientRunItem *pItem = static_cast<mbClientRunItem*>(*it);
         pItem->readDataFromMessage();
     }
+    if (m_achievedPeriod)
+    {
+        QVector<mb::Client::ItemHandle_t> handles;
+        handles.reserve(m_items.count());
+        for (Items_t::ConstIterator it = m_items.cbegin(); it != m_items.cend(); ++it)
+            handles.append(static_cast<mbClientRunItem*>(*it)->handle());
+        mbClient::global()->updatePollTiming(handles, m_achievedPeriod, lateness(), skippedCycles());
+    }
     m_isCompleted = true;
     Q_EMIT completed();
 }
@@ -56,6 +56,7 @@ public:
     inline uint16_t writeCount () const { return m_writeCount ; }
     inline uint16_t maxCount() const { return m_count; }
     inline uint32_t period() const { return m_period; }
+    inline void setPeriod(uint32_t period) { m_period = period; }
     inline const void *innerBuffer() const { return m_buff; }
     inline void *innerBuffer() { return m_buff; }
     inline uint16_t *innerBufferReg() { return reinterpret_cast<uint16_t*>(innerBuffer()); }
@@ -63,9 +64,15 @@ public:
     inline int innerBufferBitSize() const { return innerBufferSize() * MB_BYTE_SZ_BITES; }
     inline int innerBufferRegSize() const { return innerBufferSize() / MB_REGE_SZ_BYTES; }
     inline Modbus::StatusCode status() const { return m_status; }
+    inline mb::Timestamp_t scheduledTimestamp() const { return m_scheduledTimestamp; }
     inline mb::Timestamp_t beginTimestamp() const { return m_beginTimestamp; }
     inline mb::Timestamp_t timestamp() const { return m_timestamp; }
 
+public: // polling timing (valid for periodic messages starting from the second send)
+    inline uint32_t achievedPeriod() const { return m_achievedPeriod; }
+    inline uint32_t lateness() const { return m_lateness; }
+    inline uint32_t skippedCycles() const { return m_skippedCycles; }
+
 public:
     bool addItem(mbClientRunItem *item);
     void setDeleteItems(bool del);
@@ -119,8 +126,12 @@ protected:
     uint32_t m_period;
     uint16_t m_maxCount;
     Modbus::StatusCode m_status;
+    mb::Timestamp_t m_scheduledTimestamp;
     mb::Timestamp_t m_beginTimestamp;
     mb::Timestamp_t m_timestamp;
+    uint32_t m_achievedPeriod;
+    uint32_t m_lateness;
+    uint32_t m_skippedCycles;
     uint8_t m_buff[MSG_MAX_BYTES];
 
 protected:
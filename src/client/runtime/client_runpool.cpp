@@ -0,0 +1,177 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "client_runpool.h"
+
+#include <limits>
+
+#include <QEventLoop>
+#include <QDateTime>
+
+#include <ModbusClientPort.h>
+
+#include <client.h>
+
+#include "client_runport.h"
+#include "client_rundevice.h"
+#include "client_portrunnable.h"
+
+mbClientRunWorker::mbClientRunWorker(QObject *parent)
+    : QThread(parent)
+{
+    m_ctrlRun = true;
+    m_wake = false;
+    m_load = 0;
+    moveToThread(this);
+}
+
+mbClientRunWorker::~mbClientRunWorker()
+{
+}
+
+void mbClientRunWorker::addPort(mbClientRunPort *port)
+{
+    m_ports.append(port);
+    m_load += qMax(port->devices().count(), 1);
+}
+
+void mbClientRunWorker::stop()
+{
+    QMutexLocker locker(&m_mutex);
+    m_ctrlRun = false;
+    m_condition.wakeOne();
+}
+
+void mbClientRunWorker::wake()
+{
+    QMutexLocker locker(&m_mutex);
+    m_wake = true;
+    m_condition.wakeOne();
+}
+
+void mbClientRunWorker::run()
+{
+    QEventLoop loop;
+    QList<mbClientPortRunnable*> runnables;
+    Q_FOREACH (mbClientRunPort *p, m_ports)
+    {
+        mbClientPortRunnable *port = new mbClientPortRunnable(p, p->settings(), this);
+        runnables.append(port);
+        mbClient::LogInfo(port->name(), QStringLiteral("Start polling"));
+    }
+    Q_FOREVER
+    {
+        loop.processEvents();
+        mb::Timestamp_t deadline = std::numeric_limits<mb::Timestamp_t>::max();
+        Q_FOREACH (mbClientPortRunnable *port, runnables)
+        {
+            port->run();
+            mb::Timestamp_t tm = port->nextDeadline();
+            if (tm < deadline)
+                deadline = tm;
+        }
+        qint64 timeout = MaxIdleInterval;
+        if (deadline < std::numeric_limits<mb::Timestamp_t>::max())
+            timeout = qBound<qint64>(BusyInterval, deadline - QDateTime::currentMSecsSinceEpoch(), MaxIdleInterval);
+
+        QMutexLocker locker(&m_mutex);
+        if (!m_ctrlRun)
+            break;
+        if (!m_wake)
+            m_condition.wait(&m_mutex, static_cast<unsigned long>(timeout));
+        m_wake = false;
+    }
+    Q_FOREACH (mbClientPortRunnable *port, runnables)
+    {
+        port->close();
+        mbClient::LogInfo(port->name(), QStringLiteral("Finish polling"));
+    }
+    qDeleteAll(runnables);
+}
+
+
+mbClientRunPool::mbClientRunPool(int maxWorkerCount)
+{
+    m_maxWorkerCount = qMax(maxWorkerCount, 1);
+}
+
+mbClientRunPool::~mbClientRunPool()
+{
+    qDeleteAll(m_workers);
+}
+
+void mbClientRunPool::addPort(mbClientRunPort *port)
+{
+    // Note: 'port' must already contain its devices
+    mbClientRunWorker *worker = nullptr;
+    if (m_workers.count() < m_maxWorkerCount)
+    {
+        worker = new mbClientRunWorker();
+        m_workers.append(worker);
+    }
+    else
+    {
+        Q_FOREACH (mbClientRunWorker *w, m_workers)
+        {
+            if (!worker || (w->load() < worker->load()))
+                worker = w;
+        }
+    }
+    worker->addPort(port);
+    m_hashPorts.insert(port, worker);
+    Q_FOREACH (mbClientRunDevice *device, port->devices())
+        m_hashDevices.insert(device, worker);
+}
+
+void mbClientRunPool::wake(mbClientRunPort *port)
+{
+    if (mbClientRunWorker *worker = m_hashPorts.value(port))
+        worker->wake();
+}
+
+void mbClientRunPool::wake(mbClientRunDevice *device)
+{
+    if (mbClientRunWorker *worker = m_hashDevices.value(device))
+        worker->wake();
+}
+
+void mbClientRunPool::start()
+{
+    Q_FOREACH (mbClientRunWorker *w, m_workers)
+        w->start();
+}
+
+void mbClientRunPool::stop()
+{
+    Q_FOREACH (mbClientRunWorker *w, m_workers)
+        w->stop();
+}
+
+bool mbClientRunPool::isRunning() const
+{
+    Q_FOREACH (mbClientRunWorker *w, m_workers)
+    {
+        if (w->isRunning())
+            return true;
+    }
+    return false;
+}
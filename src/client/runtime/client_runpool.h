@@ -0,0 +1,106 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CLIENT_RUNPOOL_H
+#define CLIENT_RUNPOOL_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+
+#include <client_global.h>
+
+class mbClientRunPort;
+class mbClientRunDevice;
+
+/*
+   Worker thread that processes several ports (state machines of 'mbClientPortRunnable')
+   at once. Unlike 'mbClientRunThread' it doesn't poll with a fixed 1 ms tick:
+   it sleeps until the nearest read deadline of its ports or until it's woken
+   by new external/write message. Ports with request in progress are polled
+   with 'BusyInterval' until response is received or timeout is elapsed.
+*/
+class mbClientRunWorker : public QThread
+{
+public:
+    enum Constants
+    {
+        BusyInterval    = 1,  // ms
+        MaxIdleInterval = 100 // ms
+    };
+
+public:
+    explicit mbClientRunWorker(QObject *parent = nullptr);
+    ~mbClientRunWorker();
+
+public:
+    inline int load() const { return m_load; }
+    inline QList<mbClientRunPort*> ports() const { return m_ports; }
+    void addPort(mbClientRunPort *port);
+
+public:
+    void stop();
+    void wake();
+
+protected:
+    void run() override;
+
+private:
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+    bool m_ctrlRun;
+    bool m_wake;
+
+private:
+    QList<mbClientRunPort*> m_ports;
+    int m_load;
+};
+
+class mbClientRunPool
+{
+public:
+    explicit mbClientRunPool(int maxWorkerCount);
+    ~mbClientRunPool();
+
+public:
+    inline int maxWorkerCount() const { return m_maxWorkerCount; }
+    inline int workerCount() const { return m_workers.count(); }
+
+public:
+    void addPort(mbClientRunPort *port);
+    void wake(mbClientRunPort *port);
+    void wake(mbClientRunDevice *device);
+
+public:
+    void start();
+    void stop();
+    bool isRunning() const;
+
+private:
+    int m_maxWorkerCount;
+    QList<mbClientRunWorker*> m_workers;
+    QHash<mbClientRunPort*, mbClientRunWorker*> m_hashPorts;
+    QHash<mbClientRunDevice*, mbClientRunWorker*> m_hashDevices;
+};
+
+#endif // CLIENT_RUNPOOL_H
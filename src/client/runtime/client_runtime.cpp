@@ -36,10 +36,23 @@
 #include "client_runitem.h"
 #include "client_runmessage.h"
 #include "client_runthread.h"
+#include "client_runpool.h"
+#include "client_datalogger.h"
+#include "client_historian.h"
+#include "client_calculator.h"
 
 mbClientRuntime::mbClientRuntime(QObject *parent)
     : mbCoreRuntime{parent}
 {
+    m_pool = nullptr;
+    m_dataLogger = nullptr;
+    m_historian = new mbClientHistorian;
+    m_calculator = nullptr;
+}
+
+mbClientRuntime::~mbClientRuntime()
+{
+    delete m_historian;
 }
 
 void mbClientRuntime::createComponents()
@@ -47,18 +60,43 @@ void mbClientRuntime::createComponents()
     const mb::StatusCode status = mb::Status_MbInitializing;
     const mb::Timestamp_t timestamp = mb::currentTimestamp();
 
+    createDataLogger();
+    m_historian->clear();
+    int workerThreads = mbClient::global()->runtimeWorkerThreads();
+    if (workerThreads > 0)
+        m_pool = new mbClientRunPool(workerThreads);
+
     QHash<mbClientDevice*, QList<mbClientDataViewItem*> > hashDevices;
     Q_FOREACH (mbClientDataView *wl, project()->dataViews())
     {
         if (wl->isEnableProcessing())
         {
+            wl->resetStatistics();
             Q_FOREACH (mbClientDataViewItem *item, wl->items())
             {
-                if (item->device())
+                if (item->isComputed())
+                {
+                    if (!m_calculator)
+                        m_calculator = new mbClientCalculator;
+                    m_calculator->addItem(item);
+                }
+                else if (item->device())
                     hashDevices[item->device()].append(item);
             }
         }
     }
+    if (m_calculator)
+    {
+        m_calculator->build();
+        Q_FOREACH (mbClientDataViewItem *item, m_calculator->items())
+        {
+            if (mbClientHistorian::isNumeric(item->format()))
+                m_historian->addItem(item->handle());
+            // Note: computed item has no device address, so its expression is logged instead
+            if (m_dataLogger)
+                m_dataLogger->addItem(item->handle(), QString(), item->expression(), item->formatStr());
+        }
+    }
 
     Q_FOREACH (mbClientPort *port, project()->ports())
     {
@@ -71,23 +109,36 @@ void mbClientRuntime::createComponents()
             Q_FOREACH (mbClientDataViewItem *item, items)
             {
                 item->update(status, timestamp);
+                if (mbClientHistorian::isNumeric(item->format()))
+                    m_historian->addItem(item->handle());
                 mbClientRunItem *ri = createRunItem(item);
                 runItems.append(ri);
+                if (m_dataLogger)
+                    m_dataLogger->addItem(item->handle(), device->name(), item->addressStr(), item->formatStr());
             }
             mbClientRunDevice *rd = createRunDevice(device);
             rd->pushItemsToRead(runItems);
             runDevices.append(rd);
         }
-        createRunThread(rp);
         rp->pushDevices(runDevices);
+        if (m_pool)
+            m_pool->addPort(rp);
+        else
+            createRunThread(rp);
     }
 }
 
 void mbClientRuntime::startComponents()
 {
     mbCoreRuntime::startComponents();
+    if (m_dataLogger)
+        m_dataLogger->start();
+    if (m_calculator)
+        m_calculator->start();
     Q_FOREACH (mbClientRunThread *t, m_threads)
         t->start();
+    if (m_pool)
+        m_pool->start();
 }
 
 void mbClientRuntime::beginStopComponents()
@@ -95,6 +146,12 @@ void mbClientRuntime::beginStopComponents()
     mbCoreRuntime::beginStopComponents();
     Q_FOREACH (mbClientRunThread *t, m_threads)
         t->stop();
+    if (m_pool)
+        m_pool->stop();
+    if (m_dataLogger)
+        m_dataLogger->stop();
+    if (m_calculator)
+        m_calculator->stop();
 }
 
 bool mbClientRuntime::tryStopComponents()
@@ -106,6 +163,12 @@ bool mbClientRuntime::tryStopComponents()
         if (t->isRunning())
             return false;
     }
+    if (m_pool && m_pool->isRunning())
+        return false;
+    if (m_dataLogger && m_dataLogger->isRunning())
+        return false;
+    if (m_calculator && m_calculator->isRunning())
+        return false;
     return true;
 }
 
@@ -114,6 +177,8 @@ void mbClientRuntime::clearComponents()
     const mb::StatusCode status = mb::Status_MbStopped;
     const mb::Timestamp_t timestamp = mb::currentTimestamp();
     QList<mbClientDataViewItem*> items = m_items.keys();
+    if (m_calculator)
+        items.append(m_calculator->items());
     Q_FOREACH (mbClientDataViewItem *item, items)
     {
         item->update(status, timestamp);
@@ -127,16 +192,28 @@ void mbClientRuntime::clearComponents()
 
     qDeleteAll(m_threads);
     m_threads.clear();
+    delete m_pool;
+    m_pool = nullptr;
 
     qDeleteAll(m_ports);
     m_ports.clear();
+
+    delete m_dataLogger;
+    m_dataLogger = nullptr;
+
+    delete m_calculator;
+    m_calculator = nullptr;
 }
 
 void mbClientRuntime::sendPortMessage(mb::Client::PortHandle_t handle, const mbClientRunMessagePtr &message)
 {
     mbClientRunPort *rd = m_ports.value(handle);
     if (rd)
+    {
         rd->pushExternalMessage(message);
+        if (m_pool)
+            m_pool->wake(rd);
+    }
     else
         message->setComplete(Modbus::Status_Bad, mb::currentTimestamp());
 }
@@ -145,17 +222,63 @@ void mbClientRuntime::sendMessage(mb::Client::DeviceHandle_t handle, const mbCli
 {
     mbClientRunDevice *rd = m_devices.value(handle);
     if (rd)
+    {
         rd->pushExternalMessage(message);
+        if (m_pool)
+            m_pool->wake(rd);
+    }
     else
         message->setComplete(Modbus::Status_Bad, mb::currentTimestamp());
 }
 
 void mbClientRuntime::updateItem(mb::Client::ItemHandle_t handle, const QByteArray &data, mb::StatusCode status, mb::Timestamp_t timestamp)
 {
-    if (!m_items.contains(handle))
+    if (!m_items.contains(handle) && !(m_calculator && m_calculator->isComputed(handle)))
         return;
     mbClientDataViewItem *item = handle;
     item->update(data, status, timestamp);
+    if (m_dataLogger)
+        m_dataLogger->append(handle, data, status, timestamp);
+    // Note: numeric value is needed only for historised items (numeric formats) and calculator inputs
+    bool historised = m_historian->contains(handle);
+    bool source = m_calculator && m_calculator->isSource(handle);
+    if (!historised && !source)
+        return;
+    bool ok = false;
+    double v = 0;
+    if (Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(status)) && data.count())
+    {
+        v = item->value().toDouble(&ok);
+        if (ok && historised)
+            m_historian->append(handle, timestamp, v);
+    }
+    if (source)
+    {
+        // Note: non-numeric value (e.g. string) can't be used by expression
+        if (ok || !Modbus::StatusIsGood(static_cast<Modbus::StatusCode>(status)))
+            m_calculator->append(handle, v, status, timestamp);
+        else if (data.count())
+            m_calculator->append(handle, v, static_cast<mb::StatusCode>(Modbus::Status_Bad), timestamp);
+    }
+}
+
+void mbClientRuntime::updatePollTiming(const QVector<mb::Client::ItemHandle_t> &handles, uint32_t achievedPeriod, uint32_t lateness, uint32_t skippedCycles)
+{
+    // Note: one message can carry several items of the same data view,
+    // so data view statistics is updated once per completed message
+    QList<mbClientDataView*> dataViews;
+    Q_FOREACH (mb::Client::ItemHandle_t handle, handles)
+    {
+        if (!m_items.contains(handle))
+            continue;
+        mbClientDataViewItem *item = handle;
+        item->setPollTiming(achievedPeriod, lateness);
+        mbClientDataView *dataView = static_cast<mbClientDataView*>(item->dataViewCore());
+        if (dataView && !dataViews.contains(dataView))
+            dataViews.append(dataView);
+    }
+    Q_FOREACH (mbClientDataView *dataView, dataViews)
+        dataView->setStatPolling(achievedPeriod, lateness, skippedCycles);
 }
 
 void mbClientRuntime::writeItemData(mb::Client::ItemHandle_t handle, const QByteArray &data)
@@ -169,6 +292,8 @@ void mbClientRuntime::writeItemData(mb::Client::ItemHandle_t handle, const QByte
     {
         mbClientRunItem *ri = createRunItem(item, data);
         rd->pushItemToWrite(ri);
+        if (m_pool)
+            m_pool->wake(rd);
     }
 }
 
@@ -214,3 +339,14 @@ mbClientRunThread *mbClientRuntime::createRunThread(mbClientRunPort *port)
     m_threads.insert(port, t);
     return t;
 }
+
+void mbClientRuntime::createDataLogger()
+{
+    mbClient *core = mbClient::global();
+    QString file = core->dataLogFile();
+    if (file.isEmpty())
+        return;
+    m_dataLogger = new mbClientDataLogger(file);
+    m_dataLogger->setMaxFileSize(static_cast<qint64>(core->dataLogMaxFileSize()) * 1024 * 1024);
+    m_dataLogger->setRotatePeriod(static_cast<qint64>(core->dataLogRotatePeriod()) * 60 * 1000);
+}
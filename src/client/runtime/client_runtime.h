@@ -34,21 +34,28 @@ class mbClientRunPort;
 class mbClientRunDevice;
 class mbClientRunItem;
 class mbClientRunThread;
+class mbClientRunPool;
+class mbClientDataLogger;
+class mbClientHistorian;
+class mbClientCalculator;
 
 class mbClientRuntime : public mbCoreRuntime
 {
     Q_OBJECT
 public:
     explicit mbClientRuntime(QObject *parent = nullptr);
+    ~mbClientRuntime();
 
 public:
     inline mbClientProject *project() const { return static_cast<mbClientProject*>(projectCore()); }
+    inline mbClientHistorian *historian() const { return m_historian; }
 
 public:
     void sendPortMessage(mb::Client::PortHandle_t handle, const mbClientRunMessagePtr &message);
     void sendMessage(mb::Client::DeviceHandle_t handle, const mbClientRunMessagePtr &message);
     void updateItem(mb::Client::ItemHandle_t handle, const QByteArray &data, mb::StatusCode status, mb::Timestamp_t timestamp);
     inline void updateItem(mb::Client::ItemHandle_t handle, const QByteArray &data, Modbus::StatusCode status, mb::Timestamp_t timestamp) { updateItem(handle, data, static_cast<mb::StatusCode>(status), timestamp); }
+    void updatePollTiming(const QVector<mb::Client::ItemHandle_t> &handles, uint32_t achievedPeriod, uint32_t lateness, uint32_t skippedCycles);
     void writeItemData(mb::Client::ItemHandle_t handle, const QByteArray &data);
 
 private:
@@ -64,6 +71,7 @@ private:
     mbClientRunPort *createRunPort(mbClientPort *port);
     mbClientRunDevice *createRunDevice(mbClientDevice *device);
     mbClientRunThread *createRunThread(mbClientRunPort *port);
+    void createDataLogger();
 
 private: // items
     typedef QHash<mbClientDataViewItem*, mbClientRunItem*> Items_t;
@@ -80,6 +88,16 @@ private: // devices
 private: // threads
     typedef QHash<mbClientRunPort*, mbClientRunThread*> Threads_t;
     Threads_t m_threads;
+    mbClientRunPool *m_pool; // used instead of 'm_threads' when 'Runtime.WorkerThreads' > 0
+
+private: // data logger
+    mbClientDataLogger *m_dataLogger;
+
+private: // historian
+    mbClientHistorian *m_historian;
+
+private: // computed items
+    mbClientCalculator *m_calculator;
 };
 
 #endif // CLIENT_RUNTIME_H
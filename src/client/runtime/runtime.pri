@@ -1,19 +1,33 @@
 HEADERS += \
+    $$PWD/client_busplanner.h \
+    $$PWD/client_calculator.h \
+    $$PWD/client_datalogger.h \
     $$PWD/client_devicerunnable.h \
+    $$PWD/client_expression.h \
+    $$PWD/client_historian.h \
     $$PWD/client_portrunnable.h \
+    $$PWD/client_rttestimator.h \
     $$PWD/client_rundevice.h \
     $$PWD/client_runitem.h \
     $$PWD/client_runmessage.h \
+    $$PWD/client_runpool.h \
     $$PWD/client_runport.h \
     $$PWD/client_runthread.h \
     $$PWD/client_runtime.h
 
 SOURCES += \
+    $$PWD/client_busplanner.cpp \
+    $$PWD/client_calculator.cpp \
+    $$PWD/client_datalogger.cpp \
     $$PWD/client_devicerunnable.cpp \
+    $$PWD/client_expression.cpp \
+    $$PWD/client_historian.cpp \
     $$PWD/client_portrunnable.cpp \
+    $$PWD/client_rttestimator.cpp \
     $$PWD/client_rundevice.cpp \
     $$PWD/client_runitem.cpp \
     $$PWD/client_runmessage.cpp \
+    $$PWD/client_runpool.cpp \
     $$PWD/client_runport.cpp \
     $$PWD/client_runthread.cpp \
     $$PWD/client_runtime.cpp
@@ -32,6 +32,7 @@
 #include "task/core_taskfactoryinfo.h"
 #include "sdk/mbcore_taskfactory.h"
 #include "core_filemanager.h"
+#include "core_logfile.h"
 #include "plugin/core_pluginmanager.h"
 #include "project/core_project.h"
 #include "project/core_dataview.h"
@@ -123,14 +124,15 @@ mbCore::mbCore(const QString &application, QObject *parent) : mbCoreBase(parent)
     m_runtime = nullptr;
     m_ui = nullptr;
     m_project = nullptr;
+    m_logFile = new mbCoreLogFile(this);
 
-    connect(this, &mbCore::signalLog   , this, &mbCore::logMessageThreadUnsafe);
     connect(this, &mbCore::signalOutput, this, &mbCore::outputMessageThreadUnsafe);
 
     m_settings.logFlags        = d.settings_logFlags       ;
     m_settings.useTimestamp    = d.settings_useTimestamp   ;
     m_settings.formatDateTime  = d.settings_formatDateTime ;
     m_settings.addressNotation = d.settings_addressNotation;
+    m_logFile->setFormat(m_settings.useTimestamp, m_settings.formatDateTime);
     m_config = new QSettings(s.settings_organization, application, this);
 }
 
@@ -183,11 +185,14 @@ int mbCore::exec(int argc, char **argv)
     m_pluginManager = createPluginManager();
     m_builder = createBuilder();
     m_runtime = createRuntime();
+    m_logFile->start();
     if (gui)
         r = runGui();
     else
         r = runConsole();
     stop();
+    m_logFile->stop();
+    m_logFile->wait();
     return r;
 }
 
@@ -272,6 +277,12 @@ int mbCore::parseArgs(int &argc, char **argv)
                 m_args[Arg_Tray] = false;
                 continue;
             }
+            if (!qstrcmp(argv[i], "-log-file"))
+            {
+                if (++i < argc)
+                    m_args[Arg_LogFile] = QString(argv[i]);
+                continue;
+            }
             std::cerr << "Unknown parameter " << argv[i];
             return 1;
         }
@@ -440,6 +451,7 @@ MBSETTINGS mbCore::cachedSettings() const
     r[s.settings_formatDateTime ] = formatDateTime();
     r[s.settings_addressNotation] = mb::toString(addressNotation());
     r[s.settings_columns        ] = columnNames();
+    mb::unite(r, m_logFile->cachedSettings());
     return r;
 }
 
@@ -494,6 +506,9 @@ void mbCore::setCachedSettings(const MBSETTINGS &settings)
         setColumnNames(v);
     }
 
+    m_logFile->setCachedSettings(settings);
+    m_logFile->setFormat(useTimestamp(), formatDateTime());
+
     if (m_ui)
         m_ui->setCachedSettings(settings);
 }
@@ -501,10 +516,28 @@ void mbCore::setCachedSettings(const MBSETTINGS &settings)
 
 void mbCore::logMessageThreadSafe(mb::LogFlag flag, const QString &source, const QString &text)
 {
+    if (m_logFile->isEnabled())
+        m_logFile->logMessage(flag, source, text);
     if (thread() == QThread::currentThread())
+    {
+        // Note: deliver messages queued by other threads first to keep the order
+        drainLog();
         logMessageThreadUnsafe(flag, source, text);
+    }
     else
-        Q_EMIT signalLog(flag, source, text);
+    {
+        if (m_logQueued.fetchAndAddRelaxed(1) >= MaxLogQueued)
+        {
+            m_logQueued.fetchAndAddRelaxed(-1);
+            m_logDropped.fetchAndAddRelaxed(1);
+            return;
+        }
+        if (m_logQueue.push(flag, source, text))
+        {
+            // Note: only the first message of the batch posts event, the rest are collected by the same 'drainLog'
+            QMetaObject::invokeMethod(this, "drainLog", Qt::QueuedConnection);
+        }
+    }
 }
 
 void mbCore::outputMessageThreadSafe(const QString &text)
@@ -515,13 +548,39 @@ void mbCore::outputMessageThreadSafe(const QString &text)
         Q_EMIT signalOutput(text);
 }
 
+void mbCore::drainLog()
+{
+    int count = m_logQueue.drain(m_logBatch);
+    m_logQueued.fetchAndAddRelaxed(-count);
+    int dropped = m_logDropped.fetchAndStoreRelaxed(0);
+    if (count)
+    {
+        if (m_ui)
+            m_ui->logMessages(m_logBatch.constData(), m_logBatch.count());
+        else
+        {
+            // Note: messages are stamped with the time they were produced, not the time they were drained
+            Q_FOREACH (const mbCoreLogMessage &m, m_logBatch)
+                logMessageThreadUnsafe(m.datetime, m.flag, m.source, m.text);
+        }
+        m_logBatch.clear();
+    }
+    if (dropped)
+        logMessageThreadUnsafe(mb::Log_Warning, applicationName(), QString("%1 log messages were dropped (log queue overload)").arg(dropped));
+}
+
 void mbCore::logMessageThreadUnsafe(mb::LogFlag flag, const QString &source, const QString &text)
+{
+    logMessageThreadUnsafe(QDateTime::currentDateTime(), flag, source, text);
+}
+
+void mbCore::logMessageThreadUnsafe(const QDateTime &datetime, mb::LogFlag flag, const QString &source, const QString &text)
 {
     if (m_ui)
         m_ui->logMessage(flag, source, text);
     else
     {
-        QString msg = QString("%1 %2").arg(QDateTime::currentDateTime().toString(m_settings.formatDateTime), msg);
+        QString msg = QString("%1 %2: %3\n").arg(datetime.toString(m_settings.formatDateTime), source, text);
         std::cout << msg.toStdString();
     }
 }
@@ -543,8 +602,10 @@ void mbCore::loadCachedSettings()
         QString name = key;
         settings.insert(name.replace('/', '.'), m_config->value(key));
     }
-
     this->setCachedSettings(settings);
+    // Note: log file from command line has priority over the saved one but it's not saved itself
+    if (m_args.contains(Arg_LogFile))
+        m_logFile->setFileNameOverride(m_args.value(Arg_LogFile).toString());
 }
 
 void mbCore::saveCachedSettings()
@@ -29,6 +29,7 @@
 
 #include <mbcore_base.h>
 #include "core_global.h"
+#include "core_logqueue.h"
 
 class QCoreApplication;
 
@@ -41,6 +42,7 @@ class mbCoreUi;
 class mbCoreProject;
 class mbCoreBuilder;
 class mbCoreRuntime;
+class mbCoreLogFile;
 
 Q_DECLARE_METATYPE(mb::LogFlag)
 
@@ -85,9 +87,15 @@ public:
         Arg_Project,
         Arg_Singleton,
         Arg_Tray,
+        Arg_LogFile,
         ArgCount
     };
 
+    enum
+    {
+        MaxLogQueued = 100000 // max count of messages queued by other threads, the rest are dropped and counted
+    };
+
     enum Status
     {
         NoProject,
@@ -137,6 +145,7 @@ public:
     inline void setUseTimestamp(bool useTimestamp) { m_settings.useTimestamp = useTimestamp; }
     inline QString formatDateTime() const { return m_settings.formatDateTime; }
     inline void setFormatDateTime(const QString& formatDateTime) { m_settings.formatDateTime = formatDateTime; }
+    inline mbCoreLogFile *logFile() const { return m_logFile; }
     inline mb::AddressNotation addressNotation() const { return m_settings.addressNotation; }
     void setAddressNotation(mb::AddressNotation notation);
 
@@ -189,7 +198,6 @@ Q_SIGNALS:
     void columnsChanged();
 
 Q_SIGNALS:
-    void signalLog(mb::LogFlag flag, const QString &source, const QString &text);
     void signalOutput(const QString &text);
 
 public:
@@ -215,10 +223,12 @@ private:
     void outputMessageThreadSafe(const QString &text);
 
 private Q_SLOTS:
+    void drainLog();
     void logMessageThreadUnsafe(mb::LogFlag flag, const QString &source, const QString &text);
     void outputMessageThreadUnsafe(const QString &text);
 
 private:
+    void logMessageThreadUnsafe(const QDateTime &datetime, mb::LogFlag flag, const QString &source, const QString &text);
     void loadCachedSettings();
     void saveCachedSettings();
     void pluginManagerSync();
@@ -236,6 +246,11 @@ protected:
     QCoreApplication* m_app;
     QSettings* m_config;
     QSharedMemory m_shared;
+    mbCoreLogQueue m_logQueue;
+    QAtomicInt m_logQueued;
+    QAtomicInt m_logDropped;
+    mbCoreLogFile *m_logFile;
+    QVector<mbCoreLogMessage> m_logBatch;
 
 protected:
     MBPARAMS m_args;
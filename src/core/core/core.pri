@@ -1,9 +1,13 @@
 HEADERS += \
     $$PWD/core.h \
     $$PWD/core_filemanager.h \
+    $$PWD/core_logqueue.h \
+    $$PWD/core_logfile.h \
     $$PWD/core_global.h
 
 SOURCES += \
     $$PWD/core.cpp \
     $$PWD/core_filemanager.cpp \
+    $$PWD/core_logqueue.cpp \
+    $$PWD/core_logfile.cpp \
     $$PWD/core_global.cpp
@@ -0,0 +1,418 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "core_logfile.h"
+
+#include "core.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QDir>
+
+mbCoreLogFile::Strings::Strings() :
+    prefix        (QStringLiteral("Log.File.")),
+    fileName      (prefix+QStringLiteral("Name")),
+    maxSize       (prefix+QStringLiteral("MaxSize")),
+    rotateInterval(prefix+QStringLiteral("RotateInterval")),
+    maxCount      (prefix+QStringLiteral("MaxCount")),
+    compress      (prefix+QStringLiteral("Compress"))
+{
+}
+
+const mbCoreLogFile::Strings &mbCoreLogFile::Strings::instance()
+{
+    static const Strings s;
+    return s;
+}
+
+mbCoreLogFile::Defaults::Defaults() :
+    fileName      (),
+    maxSize       (10 << 20),
+    rotateInterval(0),
+    maxCount      (5),
+    compress      (false)
+{
+}
+
+const mbCoreLogFile::Defaults &mbCoreLogFile::Defaults::instance()
+{
+    static const Defaults d;
+    return d;
+}
+
+mbCoreLogFile::mbCoreLogFile(QObject *parent) : QThread(parent)
+{
+    const Defaults &d = Defaults::instance();
+    m_ctrlRun = true;
+    m_config.fileName       = d.fileName      ;
+    m_config.maxSize        = d.maxSize       ;
+    m_config.rotateInterval = d.rotateInterval;
+    m_config.maxCount       = d.maxCount      ;
+    m_config.compress       = d.compress      ;
+    m_config.useTimestamp   = true;
+    m_current.maxSize        = 0;
+    m_current.rotateInterval = 0;
+    m_current.maxCount       = 0;
+    m_current.compress       = false;
+    m_current.useTimestamp   = true;
+    m_tmOpened = 0;
+    m_tmRetry = 0;
+    m_retryInterval = RetryMin;
+}
+
+mbCoreLogFile::~mbCoreLogFile()
+{
+    stop();
+    wait();
+}
+
+QString mbCoreLogFile::fileName() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_config.fileName;
+}
+
+void mbCoreLogFile::setFileName(const QString &fileName)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.fileName = fileName;
+    m_enabled.storeRelease(!effectiveConfig().fileName.isEmpty());
+}
+
+QString mbCoreLogFile::fileNameOverride() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_fileNameOverride;
+}
+
+void mbCoreLogFile::setFileNameOverride(const QString &fileName)
+{
+    QMutexLocker _(&m_mutex);
+    m_fileNameOverride = fileName;
+    m_enabled.storeRelease(!effectiveConfig().fileName.isEmpty());
+}
+
+qint64 mbCoreLogFile::maxSize() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_config.maxSize;
+}
+
+void mbCoreLogFile::setMaxSize(qint64 maxSize)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.maxSize = maxSize;
+}
+
+int mbCoreLogFile::rotateInterval() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_config.rotateInterval;
+}
+
+void mbCoreLogFile::setRotateInterval(int sec)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.rotateInterval = sec;
+}
+
+int mbCoreLogFile::maxCount() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_config.maxCount;
+}
+
+void mbCoreLogFile::setMaxCount(int count)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.maxCount = count;
+}
+
+bool mbCoreLogFile::compress() const
+{
+    QMutexLocker _(&m_mutex);
+    return m_config.compress;
+}
+
+void mbCoreLogFile::setCompress(bool compress)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.compress = compress;
+}
+
+void mbCoreLogFile::setFormat(bool useTimestamp, const QString &formatDateTime)
+{
+    QMutexLocker _(&m_mutex);
+    m_config.useTimestamp = useTimestamp;
+    m_config.formatDateTime = formatDateTime;
+}
+
+MBSETTINGS mbCoreLogFile::cachedSettings() const
+{
+    const Strings &s = Strings::instance();
+    QMutexLocker _(&m_mutex);
+    MBSETTINGS r;
+    r[s.fileName      ] = m_config.fileName      ;
+    r[s.maxSize       ] = m_config.maxSize       ;
+    r[s.rotateInterval] = m_config.rotateInterval;
+    r[s.maxCount      ] = m_config.maxCount      ;
+    r[s.compress      ] = m_config.compress      ;
+    return r;
+}
+
+void mbCoreLogFile::setCachedSettings(const MBSETTINGS &settings)
+{
+    const Strings &s = Strings::instance();
+
+    MBSETTINGS::const_iterator it;
+    MBSETTINGS::const_iterator end = settings.end();
+    bool ok;
+
+    it = settings.find(s.fileName);
+    if (it != end)
+        setFileName(it.value().toString());
+
+    it = settings.find(s.maxSize);
+    if (it != end)
+    {
+        qint64 v = it.value().toLongLong(&ok);
+        if (ok)
+            setMaxSize(v);
+    }
+
+    it = settings.find(s.rotateInterval);
+    if (it != end)
+    {
+        int v = it.value().toInt(&ok);
+        if (ok)
+            setRotateInterval(v);
+    }
+
+    it = settings.find(s.maxCount);
+    if (it != end)
+    {
+        int v = it.value().toInt(&ok);
+        if (ok)
+            setMaxCount(v);
+    }
+
+    it = settings.find(s.compress);
+    if (it != end)
+        setCompress(it.value().toBool());
+}
+
+void mbCoreLogFile::logMessage(mb::LogFlag flag, const QString &source, const QString &text)
+{
+    // Note: never wait for the sink thread, drop message if it can't keep up
+    if (m_queued.fetchAndAddRelaxed(1) >= MaxQueued)
+    {
+        m_queued.fetchAndAddRelaxed(-1);
+        m_dropped.fetchAndAddRelaxed(1);
+        return;
+    }
+    m_queue.push(flag, source, text);
+}
+
+void mbCoreLogFile::stop()
+{
+    QMutexLocker _(&m_mutex);
+    m_ctrlRun = false;
+    m_cond.wakeAll();
+}
+
+void mbCoreLogFile::run()
+{
+    m_mutex.lock();
+    m_ctrlRun = true;
+    while (m_ctrlRun)
+    {
+        m_current = effectiveConfig();
+        m_mutex.unlock();
+        process();
+        m_mutex.lock();
+        if (m_ctrlRun)
+            m_cond.wait(&m_mutex, FlushInterval);
+    }
+    m_current = effectiveConfig();
+    m_mutex.unlock();
+    // Note: write the rest of the queue before exit
+    process();
+    m_file.close();
+}
+
+mbCoreLogFile::Config mbCoreLogFile::effectiveConfig() const
+{
+    // Note: must be called with locked 'm_mutex'
+    Config c = m_config;
+    if (!m_fileNameOverride.isEmpty())
+        c.fileName = m_fileNameOverride;
+    return c;
+}
+
+void mbCoreLogFile::process()
+{
+    if (m_file.fileName() != m_current.fileName)
+    {
+        m_retryInterval = RetryMin;
+        openFile();
+    }
+    else if (!m_file.isOpen() && !m_current.fileName.isEmpty() && (QDateTime::currentMSecsSinceEpoch() >= m_tmRetry))
+        openFile();
+    int count = m_queue.drain(m_batch);
+    m_queued.fetchAndAddRelaxed(-count);
+    if (!m_file.isOpen())
+    {
+        // Note: messages are reported as dropped when the file is opened again
+        m_dropped.fetchAndAddRelaxed(count);
+        m_batch.clear();
+        return;
+    }
+    int dropped = m_dropped.fetchAndStoreRelaxed(0);
+    if (dropped)
+        m_buffer.append(QString("%1 messages were dropped (log file sink overload)\n").arg(dropped).toUtf8());
+    Q_FOREACH (const mbCoreLogMessage &m, m_batch)
+    {
+        QString s;
+        if (m_current.useTimestamp)
+        {
+            s = QString("%1 '%2' [%3]: %4\n").arg(m.datetime.toString(m_current.formatDateTime),
+                                                m.source,
+                                                mb::toString(m.flag),
+                                                m.text);
+        }
+        else
+        {
+            s = QString("'%1' [%2]: %3\n").arg(m.source,
+                                             mb::toString(m.flag),
+                                             m.text);
+        }
+        m_buffer.append(s.toUtf8());
+        if (m_buffer.size() >= WriteChunk)
+            writeBuffer();
+    }
+    m_batch.clear();
+    writeBuffer();
+    m_file.flush();
+    if ((m_current.rotateInterval > 0) && m_file.size() &&
+        ((QDateTime::currentMSecsSinceEpoch() - m_tmOpened) >= static_cast<qint64>(m_current.rotateInterval) * 1000))
+        rotate();
+}
+
+void mbCoreLogFile::openFile()
+{
+    m_file.close();
+    m_buffer.clear();
+    m_file.setFileName(m_current.fileName);
+    if (m_current.fileName.isEmpty())
+        return;
+    QFileInfo fi(m_current.fileName);
+    QDir().mkpath(fi.absolutePath());
+    m_tmOpened = QDateTime::currentMSecsSinceEpoch();
+    if (m_file.open(QFile::WriteOnly | QFile::Append))
+    {
+        m_retryInterval = RetryMin;
+        return;
+    }
+    mbCore::LogError(QStringLiteral("LogFile"), QString("Can't open log file '%1': %2. Next try in %3 ms").arg(m_current.fileName,
+                                                                                                              m_file.errorString()).arg(m_retryInterval));
+    m_tmRetry = m_tmOpened + m_retryInterval;
+    m_retryInterval = qMin(m_retryInterval * 2, static_cast<int>(RetryMax));
+}
+
+void mbCoreLogFile::writeBuffer()
+{
+    if (m_buffer.isEmpty())
+        return;
+    m_file.write(m_buffer);
+    m_buffer.clear();
+    if ((m_current.maxSize > 0) && (m_file.size() >= m_current.maxSize))
+        rotate();
+}
+
+void mbCoreLogFile::rotate()
+{
+    m_file.close();
+    if (m_current.maxCount > 0)
+    {
+        // Shift existing segments: '.1' -> '.2', '.2' -> '.3', ...
+        // Note: both kinds are processed, so segments made before 'compress' was changed are pruned too
+        for (int c = 0; c < 2; c++)
+        {
+            bool compressed = (c != 0);
+            QFile::remove(segmentName(m_current.maxCount, compressed));
+            for (int i = m_current.maxCount - 1; i > 0; i--)
+                QFile::rename(segmentName(i, compressed), segmentName(i+1, compressed));
+        }
+        if (m_current.compress && compressSegment(segmentName(1, true)))
+            QFile::remove(m_current.fileName);
+        else if (!QFile::rename(m_current.fileName, segmentName(1, false)))
+            mbCore::LogError(QStringLiteral("LogFile"), QString("Can't rename log file '%1' to '%2', log is continued in the same file").arg(m_current.fileName, segmentName(1, false)));
+    }
+    else
+        QFile::remove(m_current.fileName);
+    openFile();
+}
+
+bool mbCoreLogFile::compressSegment(const QString &dstName)
+{
+    QFile src(m_current.fileName);
+    if (!src.open(QFile::ReadOnly))
+    {
+        mbCore::LogError(QStringLiteral("LogFile"), QString("Can't open log file '%1' to compress: %2").arg(src.fileName(), src.errorString()));
+        return false;
+    }
+    QFile dst(dstName);
+    if (!dst.open(QFile::WriteOnly))
+    {
+        mbCore::LogError(QStringLiteral("LogFile"), QString("Can't create log segment '%1': %2").arg(dst.fileName(), dst.errorString()));
+        return false;
+    }
+    // Note: segment is compressed block by block to keep memory usage bounded
+    while (!src.atEnd())
+    {
+        QByteArray data = src.read(WriteChunk);
+        if (data.isEmpty() && (src.error() != QFile::NoError))
+            break;
+        QByteArray block = qCompress(data);
+        quint32 size = static_cast<quint32>(block.size());
+        char header[4] = { static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                           static_cast<char>(size >> 8) , static_cast<char>(size)       };
+        if ((dst.write(header, sizeof(header)) != sizeof(header)) || (dst.write(block) != block.size()))
+            break;
+    }
+    bool ok = src.atEnd() && (src.error() == QFile::NoError) && dst.flush();
+    dst.close();
+    if (ok && (dst.error() == QFile::NoError))
+        return true;
+    mbCore::LogError(QStringLiteral("LogFile"), QString("Can't compress log segment '%1': %2").arg(dst.fileName(),
+                                                                                                   (dst.error() != QFile::NoError) ? dst.errorString() : src.errorString()));
+    dst.remove();
+    return false;
+}
+
+QString mbCoreLogFile::segmentName(int i, bool compressed) const
+{
+    QString name = QString("%1.%2").arg(m_current.fileName).arg(i);
+    if (compressed)
+        name += QStringLiteral(".qz");
+    return name;
+}
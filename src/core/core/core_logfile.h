@@ -0,0 +1,159 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CORE_LOGFILE_H
+#define CORE_LOGFILE_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+
+#include <mbcore.h>
+
+#include "core_logqueue.h"
+
+/*
+   Asynchronous file sink for log messages (mostly for '-no-gui' mode).
+   Messages that pass 'Log.Flags' are pushed into lock-free queue by any thread,
+   formatting and buffered writing are made by the sink thread.
+   Current file is rotated when it exceeds 'maxSize' bytes or 'rotateInterval' seconds.
+   Rotated segments are named '<file>.1', '<file>.2', ... (the newest is '.1'), only 'maxCount'
+   of them are kept. If compression is enabled segments are packed by 'WriteChunk' blocks
+   with 'qCompress' ('.qz' suffix: every block is 4-byte big-endian size of the following
+   'qCompress' data), so memory used for compression doesn't depend on segment size.
+   Current file is removed only when its compressed segment is completely written, otherwise
+   it's kept as uncompressed segment. Segments of both kinds are shifted and pruned regardless
+   of the current 'compress' setting.
+   If the file can't be opened the error is logged and opening is retried with growing interval
+   (from 'RetryMin' to 'RetryMax' milliseconds), messages that come meanwhile are counted as dropped.
+   If the queue holds more than 'MaxQueued' messages new messages are dropped and counted.
+*/
+class MBTOOLS_EXPORT mbCoreLogFile : public QThread
+{
+public:
+    struct MBTOOLS_EXPORT Strings
+    {
+        const QString prefix        ;
+        const QString fileName      ;
+        const QString maxSize       ;
+        const QString rotateInterval;
+        const QString maxCount      ;
+        const QString compress      ;
+        Strings();
+        static const Strings &instance();
+    };
+
+    struct MBTOOLS_EXPORT Defaults
+    {
+        const QString fileName      ;
+        const qint64  maxSize       ;
+        const int     rotateInterval;
+        const int     maxCount      ;
+        const bool    compress      ;
+        Defaults();
+        static const Defaults &instance();
+    };
+
+    enum
+    {
+        MaxQueued     = 100000,
+        FlushInterval = 200   ,
+        WriteChunk    = 1 << 18,
+        RetryMin      = 1000  ,
+        RetryMax      = 60000
+    };
+
+public:
+    explicit mbCoreLogFile(QObject *parent = nullptr);
+    ~mbCoreLogFile();
+
+public:
+    inline bool isEnabled() const { return m_enabled.loadAcquire(); }
+    QString fileName() const;
+    void setFileName(const QString &fileName);
+    // Note: file name that replaces configured one without being saved in settings (e.g. '-log-file' argument)
+    QString fileNameOverride() const;
+    void setFileNameOverride(const QString &fileName);
+    qint64 maxSize() const;
+    void setMaxSize(qint64 maxSize);
+    int rotateInterval() const;
+    void setRotateInterval(int sec);
+    int maxCount() const;
+    void setMaxCount(int count);
+    bool compress() const;
+    void setCompress(bool compress);
+    void setFormat(bool useTimestamp, const QString &formatDateTime);
+
+    MBSETTINGS cachedSettings() const;
+    void setCachedSettings(const MBSETTINGS &settings);
+
+public:
+    void logMessage(mb::LogFlag flag, const QString &source, const QString &text);
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    struct Config
+    {
+        QString fileName      ;
+        qint64  maxSize       ;
+        int     rotateInterval;
+        int     maxCount      ;
+        bool    compress      ;
+        bool    useTimestamp  ;
+        QString formatDateTime;
+    };
+
+private:
+    Config effectiveConfig() const;
+    void process();
+    void openFile();
+    void writeBuffer();
+    void rotate();
+    bool compressSegment(const QString &dstName);
+    QString segmentName(int i, bool compressed) const;
+
+private:
+    mutable QMutex m_mutex;
+    QWaitCondition m_cond;
+    bool m_ctrlRun;
+    Config m_config;          // guarded by 'm_mutex'
+    QString m_fileNameOverride; // guarded by 'm_mutex'
+    QAtomicInt m_enabled;
+    mbCoreLogQueue m_queue;
+    QAtomicInt m_queued;
+    QAtomicInt m_dropped;
+
+private: // sink thread data
+    Config m_current;
+    QFile m_file;
+    QByteArray m_buffer;
+    QVector<mbCoreLogMessage> m_batch;
+    qint64 m_tmOpened;
+    qint64 m_tmRetry;
+    int m_retryInterval;
+};
+
+#endif // CORE_LOGFILE_H
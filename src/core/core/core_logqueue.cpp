@@ -0,0 +1,80 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "core_logqueue.h"
+
+mbCoreLogQueue::mbCoreLogQueue() :
+    m_head(nullptr)
+{
+}
+
+mbCoreLogQueue::~mbCoreLogQueue()
+{
+    Node *node = m_head.fetchAndStoreAcquire(nullptr);
+    while (node)
+    {
+        Node *next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+bool mbCoreLogQueue::push(mb::LogFlag flag, const QString &source, const QString &text)
+{
+    Node *node = new Node;
+    node->message.datetime = QDateTime::currentDateTime();
+    node->message.flag     = flag;
+    node->message.source   = source;
+    node->message.text     = text;
+    Node *head = m_head.load();
+    do
+    {
+        node->next = head;
+    }
+    while (!m_head.testAndSetOrdered(head, node, head));
+    return head == nullptr;
+}
+
+int mbCoreLogQueue::drain(QVector<mbCoreLogMessage> &messages)
+{
+    Node *node = m_head.fetchAndStoreAcquire(nullptr);
+    // Reverse LIFO list to get messages in the order they were pushed
+    Node *fifo = nullptr;
+    int count = 0;
+    while (node)
+    {
+        Node *next = node->next;
+        node->next = fifo;
+        fifo = node;
+        node = next;
+        ++count;
+    }
+    messages.reserve(messages.count() + count);
+    while (fifo)
+    {
+        Node *next = fifo->next;
+        messages.append(fifo->message);
+        delete fifo;
+        fifo = next;
+    }
+    return count;
+}
@@ -0,0 +1,68 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CORE_LOGQUEUE_H
+#define CORE_LOGQUEUE_H
+
+#include <QAtomicPointer>
+#include <QDateTime>
+#include <QVector>
+
+#include <mbcore.h>
+
+struct mbCoreLogMessage
+{
+    QDateTime   datetime;
+    mb::LogFlag flag    ;
+    QString     source  ;
+    QString     text    ;
+};
+
+/*
+   Lock-free multiple producer single consumer queue of log messages.
+   Producers push messages onto atomic list head, consumer takes the whole list
+   with single atomic exchange and restores the original (FIFO) order.
+   Because consumer never removes single nodes there is no ABA problem.
+*/
+class mbCoreLogQueue
+{
+public:
+    mbCoreLogQueue();
+    ~mbCoreLogQueue();
+
+public:
+    // Note: returns true if queue was empty, so consumer must be notified to drain it
+    bool push(mb::LogFlag flag, const QString &source, const QString &text);
+    // Note: must be called only from consumer thread. Messages are appended to 'messages'
+    int drain(QVector<mbCoreLogMessage> &messages);
+
+private:
+    struct Node
+    {
+        mbCoreLogMessage message;
+        Node *next;
+    };
+
+    QAtomicPointer<Node> m_head;
+};
+
+#endif // CORE_LOGQUEUE_H
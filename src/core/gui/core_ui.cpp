@@ -31,6 +31,7 @@
 #include <QBuffer>
 #include <QAction>
 #include <QMenu>
+#include <QProgressDialog>
 
 #include <core.h>
 
@@ -49,6 +50,7 @@
 #include "dataview/core_dataviewui.h"
 
 #include "statistics/core_statisticsmanager.h"
+#include "statistics/core_statisticshub.h"
 #include "statistics/core_statisticsui.h"
 
 #include "help/core_helpui.h"
@@ -96,6 +98,8 @@ mbCoreUi::mbCoreUi(mbCore *core, QWidget *parent) :
     m_windowManager = nullptr;
     m_dataViewManager = nullptr;
     m_statisticsManager = nullptr;
+    m_statisticsHub = new mbCoreStatisticsHub(this);
+    connect(m_statisticsHub, &mbCoreStatisticsHub::portStatisticsChanged, this, &mbCoreUi::currentPortStatisticsChanged);
     m_currentPort = nullptr;
     m_projectUi = nullptr;
     m_tray = nullptr;
@@ -369,6 +373,11 @@ void mbCoreUi::logMessage(mb::LogFlag flag, const QString &source, const QString
     m_logView->logMessage(flag, source, text);
 }
 
+void mbCoreUi::logMessages(const mbCoreLogMessage *messages, int count)
+{
+    m_logView->logMessages(messages, count);
+}
+
 void mbCoreUi::outputMessage(const QString &/*message*/)
 {
 }
@@ -1215,21 +1224,32 @@ void mbCoreUi::currentPortChanged(mbCorePort *port)
 {
     mbCorePort *old = m_currentPort;
     if (old)
+    {
         old->disconnect(this);
+        m_statisticsHub->unsubscribe(old);
+    }
     m_currentPort = port;
     refreshCurrentPortName();
     mbCorePort::CoreStatistics stat;
     if (port)
     {
-        connect(port, &mbCorePort::changed           , this, &mbCoreUi::refreshCurrentPortName);
-        connect(port, &mbCorePort::statCountTxChanged, this, &mbCoreUi::setStatTx             );
-        connect(port, &mbCorePort::statCountRxChanged, this, &mbCoreUi::setStatRx             );
+        connect(port, &mbCorePort::changed, this, &mbCoreUi::refreshCurrentPortName);
+        m_statisticsHub->subscribe(port);
         stat = port->statisticsCore();
     }
     setStatTx(stat.countTx);
     setStatRx(stat.countRx);
 }
 
+void mbCoreUi::currentPortStatisticsChanged(mbCorePort *port)
+{
+    if (port == m_currentPort)
+    {
+        setStatTx(port->statCountTx());
+        setStatRx(port->statCountRx());
+    }
+}
+
 void mbCoreUi::refreshCurrentPortName()
 {
     if (m_currentPort)
@@ -1419,7 +1439,18 @@ QMessageBox::StandardButton mbCoreUi::checkProjectModifiedAndSave(const QString
 
 void mbCoreUi::openProject(const QString &file)
 {
-    mbCoreProject* p = m_core->builderCore()->loadCore(file);
+    mbCoreBuilder *builder = m_core->builderCore();
+    QProgressDialog progress(QString("Loading '%1'").arg(file), QString(), 0, 0, this);
+    progress.setWindowTitle(QStringLiteral("Open Project"));
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+    QMetaObject::Connection c = connect(builder, &mbCoreBuilder::loadProgress, &progress, [&progress](const QString &stage, int done, int total) {
+        progress.setLabelText(QString("Loading %1 ...").arg(stage));
+        progress.setMaximum(total);
+        progress.setValue(done);
+    });
+    mbCoreProject* p = builder->loadCore(file);
+    disconnect(c);
     if (p)
     {
         m_core->setProjectCore(p);
@@ -31,10 +31,12 @@
 
 class QLabel;
 class mbCore;
+struct mbCoreLogMessage;
 class mbCoreDialogs;
 class mbCoreWindowManager;
 class mbCoreDataViewManager;
 class mbCoreStatisticsManager;
+class mbCoreStatisticsHub;
 class mbCoreBuilder;
 class mbCoreDomProject;
 class mbCoreProject;
@@ -89,6 +91,7 @@ public:
     inline mbCoreWindowManager *windowManagerCore() const { return m_windowManager; }
     inline mbCoreDataViewManager *dataViewManagerCore() const { return m_dataViewManager; }
     inline mbCoreStatisticsManager *statisticsManagerCore() const { return m_statisticsManager; }
+    inline mbCoreStatisticsHub *statisticsHub() const { return m_statisticsHub; }
     inline mbCoreProject *projectCore() const { return m_project; }
 
 public:
@@ -103,6 +106,7 @@ public: // settings
 
 public Q_SLOTS:
     void logMessage(mb::LogFlag flag, const QString &source, const QString &text);
+    void logMessages(const mbCoreLogMessage *messages, int count);
     virtual void outputMessage(const QString& message);
 
 protected Q_SLOTS:
@@ -209,6 +213,7 @@ protected Q_SLOTS:
     virtual void setProject(mbCoreProject *project);
     virtual void setProjectName(const QString &name);
     void currentPortChanged(mbCorePort *port);
+    void currentPortStatisticsChanged(mbCorePort *port);
     void refreshCurrentPortName();
     void setStatTx(quint32 count);
     void setStatRx(quint32 count);
@@ -251,6 +256,7 @@ protected:
     mbCoreWindowManager *m_windowManager;
     mbCoreDataViewManager *m_dataViewManager;
     mbCoreStatisticsManager *m_statisticsManager;
+    mbCoreStatisticsHub *m_statisticsHub;
     mbCorePort *m_currentPort;
 
 protected:
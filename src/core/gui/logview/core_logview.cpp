@@ -23,21 +23,27 @@
 #include "core_logview.h"
 
 #include <QVBoxLayout>
-#include <QHeaderView>
-#include <QTableView>
-#include <QTextEdit>
-#include <QTextCursor>
-#include <QTextCharFormat>
+#include <QListView>
+#include <QScrollBar>
 #include <QToolBar>
+#include <QToolButton>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QLabel>
+#include <QMenu>
+#include <QApplication>
+#include <QClipboard>
 #include <QCoreApplication>
 #include <QMap>
 #include <QColor>
 
+#include <algorithm>
+
 #include <core.h>
 #include <gui/core_ui.h>
 #include <gui/dialogs/core_dialogs.h>
 
-//#include "core_logviewmodel.h"
+#include "core_logviewmodel.h"
 
 mbCoreLogView::Strings::Strings() :
     prefix(QStringLiteral("Ui.LogView.")),
@@ -87,25 +93,37 @@ mbCoreLogView::mbCoreLogView(QWidget *parent)
     m_toolBar->setIconSize(QSize(16,16));
     m_toolBar->setContentsMargins(0,0,0,0);
 
-    //m_view = new QTableView(this);
-    //m_model = new mbCoreLogViewModel(m_view);
-    //m_view->setModel(m_model);
-    //QHeaderView *header;
-    //header = m_view->horizontalHeader();
-    //header->setStretchLastSection(true);
-    //header->hide();
-    //header = m_view->verticalHeader();
-    //header->setSectionResizeMode(QHeaderView::ResizeToContents);
-    //header->hide();
-
-    m_offset = 0;
-    m_maxSize = d.maxSize;
-    m_colorMap = d.colors;
-
-    m_view = new QTextEdit(this);
-    m_view->setReadOnly(true);
+    m_model = new mbCoreLogViewModel(this);
+    m_model->setMaxSize(d.maxSize);
+    m_model->setColorMap(d.colors);
+
+    // Note: all rows have the same height, so view lays out only visible rows
+    m_view = new QListView(this);
+    m_view->setUniformItemSizes(true);
+    m_view->setLayoutMode(QListView::SinglePass);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    m_view->setModel(m_model);
     setFontString(d.font);
 
+    // Keep the view scrolled to the last message unless user scrolled it up
+    m_autoScroll = true;
+    connect(m_model, &QAbstractItemModel::rowsAboutToBeInserted, this, [this]() {
+        QScrollBar *bar = m_view->verticalScrollBar();
+        m_autoScroll = (bar->value() == bar->maximum());
+    });
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, [this]() {
+        if (m_autoScroll)
+            m_view->scrollToBottom();
+    });
+
+    QAction *actionCopy = new QAction(m_view);
+    actionCopy->setShortcut(QKeySequence::Copy);
+    actionCopy->setShortcutContext(Qt::WidgetShortcut);
+    connect(actionCopy, &QAction::triggered, this, &mbCoreLogView::copy);
+    m_view->addAction(actionCopy);
+
     QAction *actionClear = new QAction(m_toolBar);
     actionClear->setIcon(QIcon(":/core/icons/clear.png"));
     actionClear->setText(QCoreApplication::translate("mbCoreLogView", "Clear", nullptr));
@@ -117,6 +135,52 @@ mbCoreLogView::mbCoreLogView(QWidget *parent)
     actionExportLog->setText(QCoreApplication::translate("mbCoreLogView", "Export", nullptr));
     connect(actionExportLog, &QAction::triggered, this, &mbCoreLogView::exportLog);
     m_toolBar->addAction(actionExportLog);
+    m_toolBar->addSeparator();
+
+    // Filter
+    struct { const char *text; mb::LogFlags flags; } flags[] = {
+        {"Error"  , mb::Log_Error  },
+        {"Warning", mb::Log_Warning},
+        {"Info"   , mb::Log_Info   },
+        {"Tx"     , mb::Log_Tx     },
+        {"Rx"     , mb::Log_Rx     },
+        {"Debug"  , mb::Log_Debug  },
+        {"Qt"     , mb::LogFlags(mb::Log_QtFatal) | mb::Log_QtCritical | mb::Log_QtWarning | mb::Log_QtDebug | mb::Log_QtInfo}
+    };
+    QMenu *menuFlags = new QMenu(this);
+    for (const auto &f : flags)
+    {
+        QAction *a = menuFlags->addAction(QCoreApplication::translate("mbCoreLogView", f.text, nullptr));
+        a->setCheckable(true);
+        a->setChecked(true);
+        a->setData(static_cast<uint>(f.flags));
+        connect(a, &QAction::toggled, this, &mbCoreLogView::applyFilter);
+        m_flagActions.append(a);
+    }
+    m_btnFlags = new QToolButton(m_toolBar);
+    m_btnFlags->setText(QCoreApplication::translate("mbCoreLogView", "Categories", nullptr));
+    m_btnFlags->setMenu(menuFlags);
+    m_btnFlags->setPopupMode(QToolButton::InstantPopup);
+    m_toolBar->addWidget(m_btnFlags);
+
+    m_cmbSource = new QComboBox(m_toolBar);
+    m_cmbSource->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    m_cmbSource->addItem(QCoreApplication::translate("mbCoreLogView", "All sources", nullptr));
+    connect(m_cmbSource, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &mbCoreLogView::applyFilter);
+    m_toolBar->addWidget(m_cmbSource);
+
+    m_lnText = new QLineEdit(m_toolBar);
+    m_lnText->setPlaceholderText(QCoreApplication::translate("mbCoreLogView", "Search", nullptr));
+    m_lnText->setClearButtonEnabled(true);
+    m_lnText->setMaximumWidth(200);
+    connect(m_lnText, &QLineEdit::textChanged, this, &mbCoreLogView::applyFilter);
+    m_toolBar->addWidget(m_lnText);
+
+    m_lbSearch = new QLabel(m_toolBar);
+    m_toolBar->addWidget(m_lbSearch);
+
+    connect(m_model, &mbCoreLogViewModel::sourcesChanged, this, &mbCoreLogView::updateSources);
+    connect(m_model, &mbCoreLogViewModel::searchFinished, this, &mbCoreLogView::updateSearchState);
 
     QVBoxLayout *layout = new QVBoxLayout(this);
     layout->setSpacing(0);
@@ -126,15 +190,16 @@ mbCoreLogView::mbCoreLogView(QWidget *parent)
 
 }
 
+int mbCoreLogView::maxSize() const
+{
+    return m_model->maxSize();
+}
+
 void mbCoreLogView::setMaxSize(int sz)
 {
     if (sz < MBLOGVIEW_MAXSIZE_MIN)
         sz = MBLOGVIEW_MAXSIZE_MIN;
-    if (m_maxSize != sz)
-    {
-        m_maxSize = sz;
-        //m_offset = m_view->document()->characterCount();
-    }
+    m_model->setMaxSize(sz);
 }
 
 QString mbCoreLogView::fontString() const
@@ -151,17 +216,19 @@ void mbCoreLogView::setFontString(const QString &font)
 
 QVariant mbCoreLogView::colorMap() const
 {
-    return mb::toVariant(m_colorMap);
+    return mb::toVariant(m_model->colorMap());
 }
 
 void mbCoreLogView::setColorMap(const QVariant &v)
 {
     auto map = mb::toColorMap(v);
-    // Unite map and m_colorMap
+    mb::IntColorMap colors = m_model->colorMap();
+    // Unite map and current colors
     for (auto it = map.constBegin(); it != map.constEnd(); ++it)
     {
-        m_colorMap[it.key()] = it.value();
+        colors[it.key()] = it.value();
     }
+    m_model->setColorMap(colors);
 }
 
 MBSETTINGS mbCoreLogView::cachedSettings() const
@@ -189,9 +256,18 @@ void mbCoreLogView::setCachedSettings(const MBSETTINGS &settings)
 
 void mbCoreLogView::clear()
 {
-    //m_model->clear();
-    m_view->clear();
-    m_offset = 0;
+    m_model->clear();
+}
+
+void mbCoreLogView::copy()
+{
+    QModelIndexList ls = m_view->selectionModel()->selectedRows();
+    std::sort(ls.begin(), ls.end());
+    QStringList lines;
+    Q_FOREACH (const QModelIndex &index, ls)
+        lines.append(m_model->line(index.row()));
+    if (lines.count())
+        QApplication::clipboard()->setText(lines.join('\n'));
 }
 
 void mbCoreLogView::exportLog()
@@ -203,74 +279,68 @@ void mbCoreLogView::exportLog()
     QFile file(fileName);
     if (!file.open(QFile::WriteOnly))
         return;
-    file.write(m_view->toPlainText().toUtf8());
+    m_model->flush();
+    file.write(m_model->toPlainText().toUtf8());
     file.close();
 }
 
-void mbCoreLogView::logMessage(mb::LogFlag flag, const QString &source, const QString &text)
+void mbCoreLogView::applyFilter()
 {
-    //m_model->logMessage(flag, source, text);
-    QString s;
-    if (m_core->useTimestamp())
-    {
-        s = QString("%1 '%2' [%3]: %4").arg(QDateTime::currentDateTime().toString(m_core->formatDateTime()),
-                                          source,
-                                          mb::toString(flag),
-                                          text);
-    }
-    else
+    mbCoreLogViewModel::Filter filter;
+    mb::LogFlags flags;
+    bool all = true;
+    Q_FOREACH (QAction *a, m_flagActions)
     {
-        s = QString("'%1' [%2]: %3").arg(source,
-                                       mb::toString(flag),
-                                       text);
-    }
-    int sz = m_view->document()->characterCount();
-    int linesz = s.size();
-    if ((sz + linesz) > m_maxSize)
-    {
-        if (m_offset && ((sz > m_offset)))
-        {
-            QTextCursor cursor = m_view->textCursor();
-            cursor.setPosition(0); // start of document
-            auto i = m_offset - 1;
-            // Pass possible new line characters
-            while (i < sz)
-            {
-                auto c = m_view->document()->characterAt(i);
-                // Unicode 0x2029 represents the Paragraph Separator (PS) character,
-                if ((c == '\n') || (c == '\r') || (c.unicode() == 0x2029))
-                {
-                    ++i; // skip the end of line character
-                    continue;
-                }
-                break;
-            }
-            cursor.setPosition(i, QTextCursor::KeepAnchor); // select until offset
-            cursor.removeSelectedText(); // remove the selection
-            m_offset = sz-m_offset;
-        }
+        if (a->isChecked())
+            flags |= mb::LogFlags(QFlag(static_cast<int>(a->data().toUInt())));
         else
-        {
-            m_view->clear();
-            m_offset = 0;
-        }
-    }
-    else if ((sz >= m_maxSize/2) && (m_offset == 0))
-    {
-        m_offset = sz; // remember the point for the future deletion
+            all = false;
     }
-    QTextCursor cursor = m_view->textCursor();
-    cursor.movePosition(QTextCursor::End);
+    // Note: flags that are not listed in menu are shown only when all categories are checked
+    if (!all)
+        filter.flags = flags;
+    if (m_cmbSource->currentIndex() > 0)
+        filter.source = m_cmbSource->currentText();
+    filter.text = m_lnText->text();
+    m_model->setFilter(filter);
+    updateSearchState();
+}
+
+void mbCoreLogView::updateSources()
+{
+    QString current = m_cmbSource->currentIndex() > 0 ? m_cmbSource->currentText() : QString();
+    QStringList sources = m_model->sources();
+    // Note: keep selected source in the list even if it was cleared from the log
+    if (!current.isEmpty() && !sources.contains(current))
+        sources.append(current);
+    m_cmbSource->blockSignals(true);
+    m_cmbSource->clear();
+    m_cmbSource->addItem(QCoreApplication::translate("mbCoreLogView", "All sources", nullptr));
+    m_cmbSource->addItems(sources);
+    int i = current.isEmpty() ? 0 : m_cmbSource->findText(current);
+    m_cmbSource->setCurrentIndex(i);
+    m_cmbSource->blockSignals(false);
+}
 
-    QTextCharFormat format;
-    format.setForeground(logColor(flag));
+void mbCoreLogView::updateSearchState()
+{
+    if (m_model->isSearching())
+        m_lbSearch->setText(QCoreApplication::translate("mbCoreLogView", "Searching...", nullptr));
+    else
+        m_lbSearch->clear();
+}
+
+void mbCoreLogView::logMessage(mb::LogFlag flag, const QString &source, const QString &text)
+{
+    m_model->logMessage(flag, source, text);
+}
 
-    cursor.insertText(s, format);
-    cursor.insertBlock();
-    m_view->setTextCursor(cursor);
+void mbCoreLogView::logMessages(const mbCoreLogMessage *messages, int count)
+{
+    m_model->logMessages(messages, count);
 }
 
 QColor mbCoreLogView::logColor(mb::LogFlag flag) const
 {
-    return m_colorMap.value(flag, palette().color(QPalette::Text));
+    return m_model->colorMap().value(flag, palette().color(QPalette::Text));
 }
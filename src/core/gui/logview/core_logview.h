@@ -28,12 +28,16 @@
 #include <QWidget>
 #include <mbcore.h>
 
-class QTableView;
-class QTextEdit;
+class QListView;
 class QToolBar;
+class QToolButton;
+class QComboBox;
+class QLineEdit;
+class QLabel;
 class QColor;
 class mbCore;
-//class mbCoreLogViewModel;
+class mbCoreLogViewModel;
+struct mbCoreLogMessage;
 
 class mbCoreLogView : public QWidget
 {
@@ -65,7 +69,7 @@ public:
     explicit mbCoreLogView(QWidget *parent = nullptr);
 
 public:
-    inline int maxSize() const { return m_maxSize; }
+    int maxSize() const;
     void setMaxSize(int sz);
 
     QString fontString() const;
@@ -79,25 +83,32 @@ public:
 
 public:
     void logMessage(mb::LogFlag flag, const QString &source, const QString &text);
+    void logMessages(const mbCoreLogMessage *messages, int count);
     QColor logColor(mb::LogFlag flag) const;
 
 public Q_SLOTS:
     void clear();
+    void copy();
     void exportLog();
 
 Q_SIGNALS:
 
-protected:
+private Q_SLOTS:
+    void applyFilter();
+    void updateSources();
+    void updateSearchState();
 
 protected:
     mbCore *m_core;
     QToolBar *m_toolBar;
-    QTextEdit *m_view;
-    int m_maxSize;
-    int m_offset;
-    mb::IntColorMap m_colorMap;
-    //QTableView *m_view;
-    //mbCoreLogViewModel *m_model;
+    QListView *m_view;
+    mbCoreLogViewModel *m_model;
+    bool m_autoScroll;
+    QToolButton *m_btnFlags;
+    QList<QAction*> m_flagActions;
+    QComboBox *m_cmbSource;
+    QLineEdit *m_lnText;
+    QLabel *m_lbSearch;
 };
 
 #endif // CORE_LOGVIEW_H
@@ -2,126 +2,501 @@
 
 #include <QColor>
 #include <QDateTime>
+#include <QTimer>
+#include <QThread>
+#include <QMutex>
+
+#include <core.h>
+
+// -----------------------------------------------------------------------------------------
+// ----------------------------------------- Search ----------------------------------------
+// -----------------------------------------------------------------------------------------
+
+class mbCoreLogViewModel::Search : public QThread
+{
+public:
+    explicit Search(QObject *parent) : QThread(parent) {}
+
+public:
+    // Note: must be called only when thread is not running
+    void begin(const QList<ChunkPtr> &chunks, int skip, const Filter &filter)
+    {
+        m_chunks = chunks;
+        m_skip = skip;
+        m_filter = filter;
+        m_cancel.store(0);
+        m_results.clear();
+        start(QThread::LowPriority);
+    }
+
+    inline void cancel() { m_cancel.store(1); }
+
+    void take(QVector<quint64> &results)
+    {
+        QMutexLocker _(&m_mutex);
+        results += m_results;
+        m_results.clear();
+    }
+
+protected:
+    void run() override
+    {
+        QVector<quint64> found;
+        for (int c = 0; (c < m_chunks.count()) && !m_cancel.load(); c++)
+        {
+            const Chunk &chunk = *m_chunks.at(c);
+            if (!chunk.mayMatch(m_filter))
+                continue;
+            for (int i = (c == 0) ? m_skip : 0; i < chunk.messages.count(); i++)
+            {
+                if (m_filter.match(chunk.messages.at(i)))
+                    found.append(chunk.firstSeq + static_cast<quint64>(i));
+            }
+            // Note: matches are passed to the model after every chunk, so view shows them as they are found
+            if (found.count())
+            {
+                QMutexLocker _(&m_mutex);
+                m_results += found;
+                found.clear();
+            }
+        }
+        m_chunks.clear();
+    }
+
+private:
+    QList<ChunkPtr> m_chunks;
+    int m_skip;
+    Filter m_filter;
+    QAtomicInt m_cancel;
+    QMutex m_mutex;
+    QVector<quint64> m_results;
+};
+
+// -----------------------------------------------------------------------------------------
+// ---------------------------------------- Filter -----------------------------------------
+// -----------------------------------------------------------------------------------------
+
+bool mbCoreLogViewModel::Filter::match(const Message &m) const
+{
+    if (!flags.testFlag(m.category))
+        return false;
+    if (!source.isEmpty() && (m.source != source))
+        return false;
+    if (text.isEmpty())
+        return true;
+    return m.text.contains(text, Qt::CaseInsensitive) || m.source.contains(text, Qt::CaseInsensitive);
+}
+
+bool mbCoreLogViewModel::Chunk::mayMatch(const Filter &filter) const
+{
+    if (!(flags & filter.flags))
+        return false;
+    if (!filter.source.isEmpty() && !sources.contains(filter.source))
+        return false;
+    return true;
+}
+
+// -----------------------------------------------------------------------------------------
+// ---------------------------------------- Model ------------------------------------------
+// -----------------------------------------------------------------------------------------
 
 mbCoreLogViewModel::mbCoreLogViewModel(QObject *parent) :
-    QAbstractTableModel(parent)
+    QAbstractListModel(parent)
 {
-    m_ptr = 0;
+    m_core = mbCore::globalCore();
+    m_frontSkip = 0;
+    m_firstSeq = 0;
+    m_nextSeq = 0;
     m_count = 0;
-    m_buff.resize(1000);
+    m_chars = 0;
+    m_pendingChars = 0;
+    m_maxSize = 1 << 20;
+    m_histHead = 0;
+    m_liveHead = 0;
+    m_searchActive = false;
+    m_search = new Search(this);
+
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(FlushInterval);
+    connect(m_timer, &QTimer::timeout, this, &mbCoreLogViewModel::flush);
 }
 
 mbCoreLogViewModel::~mbCoreLogViewModel()
 {
+    stopSearch();
+}
+
+void mbCoreLogViewModel::setMaxSize(int sz)
+{
+    if (m_maxSize != sz)
+    {
+        m_maxSize = sz;
+        removeFront(evictCount(0));
+    }
+}
+
+void mbCoreLogViewModel::setColorMap(const mb::IntColorMap &colors)
+{
+    m_colorMap = colors;
+    int c = rowCount();
+    if (c)
+        Q_EMIT dataChanged(index(0), index(c-1), {Qt::ForegroundRole});
 }
 
-QVariant mbCoreLogViewModel::headerData(int section, Qt::Orientation orientation, int role) const
+void mbCoreLogViewModel::setFilter(const Filter &filter)
 {
-    if (role == Qt::DisplayRole)
+    stopSearch();
+    beginResetModel();
+    m_filter = filter;
+    m_hist.clear();
+    m_histHead = 0;
+    m_live.clear();
+    m_liveHead = 0;
+    if (isFiltered() && m_count)
     {
-        if (orientation == Qt::Horizontal)
+        // Note: the last chunk is still growing, so it's filtered here,
+        //       all the previous (full) chunks are searched in background
+        int last = m_chunks.count() - 1;
+        const Chunk &tail = *m_chunks.last();
+        if (tail.mayMatch(m_filter))
         {
-            switch(section)
+            for (int i = (last == 0) ? m_frontSkip : 0; i < tail.messages.count(); i++)
             {
-            case Column_DateTime: return "DateTime";
-            case Column_Source  : return "Source"  ;
-            case Column_Category: return "Category";
-            case Column_Text    : return "Text"    ;
+                if (m_filter.match(tail.messages.at(i)))
+                    m_live.append(tail.firstSeq + static_cast<quint64>(i));
             }
         }
-        else
-            return section;
+        if (last > 0)
+        {
+            m_search->begin(m_chunks.mid(0, last), m_frontSkip, m_filter);
+            m_searchActive = true;
+            m_timer->start();
+        }
     }
-    return QVariant();
+    endResetModel();
+    if (!m_searchActive)
+        Q_EMIT searchFinished();
 }
 
-int mbCoreLogViewModel::rowCount(const QModelIndex &/*index*/) const
+bool mbCoreLogViewModel::isSearching() const
 {
-    return m_count;
+    return m_searchActive;
 }
 
-int mbCoreLogViewModel::columnCount(const QModelIndex &) const
+int mbCoreLogViewModel::rowCount(const QModelIndex &/*index*/) const
 {
-    return ColumnCount;
+    if (isFiltered())
+        return histCount() + liveCount();
+    return m_count;
 }
 
 QVariant mbCoreLogViewModel::data(const QModelIndex &index, int role) const
 {
-    int c = index.column();
     int r = index.row();
-    if (r < m_count)
+    if ((r >= 0) && (r < rowCount()))
     {
-        int i = getActualIndex(r);
+        const Message &m = message(rowSeq(r));
         switch (role)
         {
         case Qt::DisplayRole:
-            switch(c)
-            {
-            case Column_DateTime: return m_buff.at(i).datetime.toString("hh:mm:ss.zzz");
-            case Column_Source  : return m_buff.at(i).source;
-            case Column_Category: return mb::toString(m_buff.at(i).category);
-            case Column_Text    : return m_buff.at(i).text;
-            }
-            break;
-        case Qt::BackgroundRole:
-            switch (m_buff.at(i).category)
-            {
-            case mb::Log_Error  : return QColor(Qt::red);
-            case mb::Log_Warning: return QColor(Qt::yellow);
-            case mb::Log_Info   : return QColor(Qt::green);
-            case mb::Log_Tx     : return QColor(Qt::lightGray);
-            case mb::Log_Rx     : return QColor(Qt::lightGray);
-            default:
-                return QVariant();
-            }
+            return formatLine(m);
         case Qt::ForegroundRole:
-            switch (m_buff.at(i).category)
-            {
-            case mb::Log_Error  : return QColor(Qt::white);
-            case mb::Log_Warning: return QColor(Qt::white);
-            case mb::Log_Info   : return QColor(Qt::black);
-            case mb::Log_Tx     : return QColor(Qt::black);
-            case mb::Log_Rx     : return QColor(Qt::black);
-            default:
-                return QVariant();
-            }
+        {
+            auto it = m_colorMap.find(m.category);
+            if (it != m_colorMap.end())
+                return it.value();
+        }
+            break;
         }
     }
     return QVariant();
 }
 
+QString mbCoreLogViewModel::line(int row) const
+{
+    if ((row >= 0) && (row < rowCount()))
+        return formatLine(message(rowSeq(row)));
+    return QString();
+}
+
+QString mbCoreLogViewModel::toPlainText() const
+{
+    QString s;
+    int c = rowCount();
+    for (int r = 0; r < c; r++)
+    {
+        s += formatLine(message(rowSeq(r)));
+        s += QChar('\n');
+    }
+    return s;
+}
+
 void mbCoreLogViewModel::logMessage(mb::LogFlag flag, const QString &source, const QString &text)
 {
-    int sz = m_buff.size();
     Message message;
     message.datetime = QDateTime::currentDateTime();
     message.category = flag;
     message.source = source;
     message.text = text;
-    if (m_count < sz)
-    {
-        beginInsertRows(QModelIndex(), m_count, m_count);
-        m_buff[m_ptr] = message;
-        m_count++;
-        endInsertRows();
-    }
-    else
+    append(message);
+}
+
+void mbCoreLogViewModel::logMessages(const mbCoreLogMessage *messages, int count)
+{
+    for (int i = 0; i < count; i++)
     {
-        beginResetModel();
-        m_buff[m_ptr] = message;
-        endResetModel();
-        //beginRemoveRows(QModelIndex(), 0, 0);
-        //endRemoveRows();
-        //beginInsertRows(QModelIndex(), m_count-1, m_count-1);
-        //endInsertRows();
+        const mbCoreLogMessage &m = messages[i];
+        Message message;
+        message.datetime = m.datetime;
+        message.category = m.flag;
+        message.source = m.source;
+        message.text = m.text;
+        append(message);
     }
-    m_ptr = (m_ptr + 1) % sz;
 }
 
 void mbCoreLogViewModel::clear()
 {
+    stopSearch();
+    m_timer->stop();
+    m_pending.clear();
+    m_pendingChars = 0;
     beginResetModel();
+    m_chunks.clear();
+    m_frontSkip = 0;
+    m_firstSeq = m_nextSeq;
     m_count = 0;
+    m_chars = 0;
+    m_hist.clear();
+    m_histHead = 0;
+    m_live.clear();
+    m_liveHead = 0;
+    m_sources.clear();
+    m_sourceSet.clear();
     endResetModel();
+    Q_EMIT sourcesChanged();
 }
 
+void mbCoreLogViewModel::flush()
+{
+    bool running = m_search->isRunning();
+    takeSearchResults();
+    if (m_pending.count())
+    {
+        // Skip the oldest pending messages that will not fit anyway
+        int first = 0;
+        while ((m_pendingChars > m_maxSize) && (first < m_pending.count() - 1))
+            m_pendingChars -= messageSize(m_pending.at(first++));
+
+        // Remove the oldest rows to free the space for the new ones
+        removeFront(evictCount(m_pendingChars));
+
+        int sourceCount = m_sources.count();
+        if (isFiltered())
+        {
+            QVector<quint64> matched;
+            for (int i = first; i < m_pending.count(); i++)
+            {
+                const Message &m = m_pending.at(i);
+                if (m_filter.match(m))
+                    matched.append(m_nextSeq);
+                push(m);
+            }
+            if (matched.count())
+            {
+                int row = rowCount();
+                beginInsertRows(QModelIndex(), row, row + matched.count() - 1);
+                m_live += matched;
+                endInsertRows();
+            }
+        }
+        else
+        {
+            int k = m_pending.count() - first;
+            beginInsertRows(QModelIndex(), m_count, m_count + k - 1);
+            for (int i = first; i < m_pending.count(); i++)
+                push(m_pending.at(i));
+            endInsertRows();
+        }
+        m_pending.clear();
+        m_pendingChars = 0;
+        if (m_sources.count() != sourceCount)
+        {
+            m_sources.sort();
+            Q_EMIT sourcesChanged();
+        }
+    }
+    if (m_searchActive)
+    {
+        if (running)
+            m_timer->start();
+        else
+        {
+            m_searchActive = false;
+            Q_EMIT searchFinished();
+        }
+    }
+}
+
+quint64 mbCoreLogViewModel::rowSeq(int row) const
+{
+    if (!isFiltered())
+        return m_firstSeq + static_cast<quint64>(row);
+    int h = histCount();
+    if (row < h)
+        return m_hist.at(m_histHead + row);
+    return m_live.at(m_liveHead + row - h);
+}
+
+const mbCoreLogViewModel::Message &mbCoreLogViewModel::message(quint64 seq) const
+{
+    // Note: all chunks except the last one are full, so chunk of the message is calculated directly
+    quint64 offset = seq - m_chunks.first()->firstSeq;
+    return m_chunks.at(static_cast<int>(offset / ChunkSize))->messages.at(static_cast<int>(offset % ChunkSize));
+}
+
+QString mbCoreLogViewModel::formatLine(const Message &m) const
+{
+    if (m_core->useTimestamp())
+    {
+        return QString("%1 '%2' [%3]: %4").arg(m.datetime.toString(m_core->formatDateTime()),
+                                             m.source,
+                                             mb::toString(m.category),
+                                             m.text);
+    }
+    return QString("'%1' [%2]: %3").arg(m.source,
+                                      mb::toString(m.category),
+                                      m.text);
+}
+
+void mbCoreLogViewModel::append(const Message &message)
+{
+    m_pendingChars += messageSize(message);
+    m_pending.append(message);
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+void mbCoreLogViewModel::push(const Message &message)
+{
+    if (m_chunks.isEmpty() || (m_chunks.last()->messages.count() >= ChunkSize))
+    {
+        ChunkPtr chunk(new Chunk);
+        chunk->messages.reserve(ChunkSize);
+        chunk->firstSeq = m_nextSeq;
+        m_chunks.append(chunk);
+    }
+    Chunk &chunk = *m_chunks.last();
+    chunk.messages.append(message);
+    chunk.flags |= message.category;
+    chunk.sources.insert(message.source);
+    if (!m_sourceSet.contains(message.source))
+    {
+        m_sourceSet.insert(message.source);
+        m_sources.append(message.source);
+    }
+    ++m_nextSeq;
+    ++m_count;
+    m_chars += messageSize(message);
+}
+
+int mbCoreLogViewModel::evictCount(int freeChars) const
+{
+    int n = 0;
+    int chars = m_chars;
+    quint64 seq = m_firstSeq;
+    while ((n < m_count) && ((chars + freeChars) > m_maxSize))
+    {
+        chars -= messageSize(message(seq++));
+        ++n;
+    }
+    return n;
+}
+
+void mbCoreLogViewModel::evict(int n)
+{
+    for (; n > 0; --n)
+    {
+        const Chunk &chunk = *m_chunks.first();
+        m_chars -= messageSize(chunk.messages.at(m_frontSkip));
+        ++m_frontSkip;
+        ++m_firstSeq;
+        --m_count;
+        // Note: chunk may be still used by search thread, so it's never changed, only released
+        if (m_frontSkip >= chunk.messages.count())
+        {
+            m_chunks.removeFirst();
+            m_frontSkip = 0;
+        }
+    }
+}
+
+void mbCoreLogViewModel::removeFront(int n)
+{
+    if (n <= 0)
+        return;
+    if (!isFiltered())
+    {
+        beginRemoveRows(QModelIndex(), 0, n-1);
+        evict(n);
+        endRemoveRows();
+        return;
+    }
+    quint64 firstSeq = m_firstSeq + static_cast<quint64>(n);
+    int h = 0;
+    int l = 0;
+    while ((h < histCount()) && (m_hist.at(m_histHead + h) < firstSeq))
+        ++h;
+    if (h == histCount())
+    {
+        while ((l < liveCount()) && (m_live.at(m_liveHead + l) < firstSeq))
+            ++l;
+    }
+    int r = h + l;
+    if (r)
+        beginRemoveRows(QModelIndex(), 0, r-1);
+    m_histHead += h;
+    m_liveHead += l;
+    evict(n);
+    if (r)
+        endRemoveRows();
+    // Free the space of removed matches from time to time
+    if ((m_histHead > ChunkSize) && (m_histHead * 2 > m_hist.count()))
+    {
+        m_hist.remove(0, m_histHead);
+        m_histHead = 0;
+    }
+    if ((m_liveHead > ChunkSize) && (m_liveHead * 2 > m_live.count()))
+    {
+        m_live.remove(0, m_liveHead);
+        m_liveHead = 0;
+    }
+}
+
+void mbCoreLogViewModel::takeSearchResults()
+{
+    QVector<quint64> results;
+    m_search->take(results);
+    // Note: results are sorted, skip the messages that were already removed
+    int first = 0;
+    while ((first < results.count()) && (results.at(first) < m_firstSeq))
+        ++first;
+    int k = results.count() - first;
+    if (k <= 0)
+        return;
+    // Note: history matches are always older than live ones
+    int row = histCount();
+    beginInsertRows(QModelIndex(), row, row + k - 1);
+    m_hist.append(results.mid(first));
+    endInsertRows();
+}
+
+void mbCoreLogViewModel::stopSearch()
+{
+    m_search->cancel();
+    m_search->wait();
+    QVector<quint64> dummy;
+    m_search->take(dummy);
+    m_searchActive = false;
+}
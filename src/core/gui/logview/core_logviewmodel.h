@@ -1,23 +1,40 @@
-#ifndef XCHG_MESSAGEBUFFERMODEL_H
-#define XCHG_MESSAGEBUFFERMODEL_H
+#ifndef CORE_LOGVIEWMODEL_H
+#define CORE_LOGVIEWMODEL_H
 
 #include <QDateTime>
-#include <QAbstractTableModel>
+#include <QVector>
+#include <QSet>
+#include <QSharedPointer>
+#include <QAbstractListModel>
 
 #include <mbcore.h>
 
-class mbCoreLogViewModel : public QAbstractTableModel
+class QTimer;
+class mbCore;
+struct mbCoreLogMessage;
+
+/*
+   Log messages are stored as structured records in chunks of 'ChunkSize' messages.
+   Every chunk keeps index of flags and sources of its messages, so filter skips
+   chunks that can't contain matches without looking into messages.
+   New messages are collected into pending batch and inserted into the model once
+   per 'FlushInterval' ms. Message line is formatted only when view asks for visible row data.
+   Total size of stored messages (in characters) is limited by 'maxSize', the oldest
+   messages are removed first.
+
+   When filter is set the model contains only matching messages. New messages and
+   the last (not full) chunk are filtered in GUI thread, full chunks of the history
+   are searched in background thread and matches are inserted as they are found.
+*/
+class mbCoreLogViewModel : public QAbstractListModel
 {
     Q_OBJECT
 
 public:
-    enum Column
+    enum
     {
-        Column_DateTime,
-        Column_Source  ,
-        Column_Category,
-        Column_Text    ,
-        ColumnCount
+        FlushInterval = 40,
+        ChunkSize = 4096
     };
 
     struct Message
@@ -28,28 +45,106 @@ public:
         QString text;
     };
 
+    struct Filter
+    {
+        Filter() : flags(QFlag(-1)) {}
+
+        mb::LogFlags flags ; // categories to show
+        QString      source; // exact source name, empty means any source
+        QString      text  ; // case insensitive substring of source or text
+
+        inline bool isEmpty() const { return (static_cast<uint>(flags) == 0xFFFFFFFFu) && source.isEmpty() && text.isEmpty(); }
+        bool match(const Message &m) const;
+    };
+
 public:
-    explicit mbCoreLogViewModel(QObject *parent = 0);
+    explicit mbCoreLogViewModel(QObject *parent = nullptr);
     ~mbCoreLogViewModel();
 
 public:
-    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    inline int maxSize() const { return m_maxSize; }
+    void setMaxSize(int sz);
+    inline const mb::IntColorMap &colorMap() const { return m_colorMap; }
+    void setColorMap(const mb::IntColorMap &colors);
+    inline const Filter &filter() const { return m_filter; }
+    void setFilter(const Filter &filter);
+    inline QStringList sources() const { return m_sources; }
+    bool isSearching() const;
+
+public:
     int rowCount(const QModelIndex &index = QModelIndex()) const override;
-    int columnCount(const QModelIndex& = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
 public:
+    QString line(int row) const;
+    QString toPlainText() const;
     void logMessage(mb::LogFlag flag, const QString &source, const QString &text);
+    void logMessages(const mbCoreLogMessage *messages, int count);
+
+public Q_SLOTS:
     void clear();
+    void flush();
+
+Q_SIGNALS:
+    void sourcesChanged();
+    void searchFinished();
 
 private:
-    inline int getActualIndex(int row) const { return (m_ptr + m_buff.size() - m_count + row) % m_buff.size(); }
+    struct Chunk
+    {
+        QVector<Message> messages;
+        quint64          firstSeq;
+        mb::LogFlags     flags   ; // all flags of the chunk messages
+        QSet<QString>    sources ;
+
+        bool mayMatch(const Filter &filter) const;
+    };
+    typedef QSharedPointer<Chunk> ChunkPtr;
+
+    class Search;
+
+private:
+    inline static int messageSize(const Message &m) { return m.source.size() + m.text.size() + MessageOverhead; }
+    inline bool isFiltered() const { return !m_filter.isEmpty(); }
+    inline int histCount() const { return m_hist.count() - m_histHead; }
+    inline int liveCount() const { return m_live.count() - m_liveHead; }
+    quint64 rowSeq(int row) const;
+    const Message &message(quint64 seq) const;
+    QString formatLine(const Message &m) const;
+    void append(const Message &message);
+    void push(const Message &message);
+    int evictCount(int freeChars) const;
+    void evict(int n);
+    void removeFront(int n);
+    void takeSearchResults();
+    void stopSearch();
 
 private:
-    typedef QVector<Message> MessageBuffer;
-    MessageBuffer m_buff;
-    int m_ptr;
+    // Note: approximate size of timestamp, category and separators of the formatted line
+    enum { MessageOverhead = 40 };
+
+    mbCore *m_core;
+    QList<ChunkPtr> m_chunks;
+    int m_frontSkip; // count of removed messages at the front of the first chunk
+    quint64 m_firstSeq;
+    quint64 m_nextSeq;
     int m_count;
+    int m_chars;
+    QVector<Message> m_pending;
+    int m_pendingChars;
+    int m_maxSize;
+    mb::IntColorMap m_colorMap;
+    QTimer *m_timer;
+    QStringList m_sources;
+    QSet<QString> m_sourceSet;
+    Filter m_filter;
+    // Note: sequence numbers of matched messages, found by search thread (history) and by GUI thread (live)
+    QVector<quint64> m_hist;
+    int m_histHead;
+    QVector<quint64> m_live;
+    int m_liveHead;
+    Search *m_search;
+    bool m_searchActive;
 };
 
-#endif // XCHG_MESSAGEBUFFERMODEL_H
+#endif // CORE_LOGVIEWMODEL_H
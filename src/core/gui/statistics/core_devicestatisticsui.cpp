@@ -3,19 +3,26 @@
 #include <QLineEdit>
 #include <QPlainTextEdit>
 
+#include <core.h>
+#include <gui/core_ui.h>
 #include <project/core_device.h>
 
+#include "core_statisticshub.h"
+
 mbCoreDeviceStatisticsUi::mbCoreDeviceStatisticsUi(mbCoreDevice *device, QWidget *parent) :
     mbCoreStatisticsUi(parent),
     m_device(device)
 {
-    m_timerId = 0;
+    m_scanning = false;
+    m_hub = mbCore::globalCore()->coreUi()->statisticsHub();
+    connect(m_hub, &mbCoreStatisticsHub::deviceStatisticsChanged, this, &mbCoreDeviceStatisticsUi::statisticsChanged);
     connect(m_device, &mbCoreDevice::nameChanged, this, &mbCoreDeviceStatisticsUi::setStatWindowTitle);
     setStatWindowTitle(m_device->name());
 }
 
 mbCoreDeviceStatisticsUi::~mbCoreDeviceStatisticsUi()
 {
+    stopScanning();
 }
 
 QString mbCoreDeviceStatisticsUi::name() const
@@ -45,13 +52,15 @@ bool mbCoreDeviceStatisticsUi::event(QEvent *event)
     {
         stopScanning();
     }
-    else if (event->type() == QEvent::Timer)
-    {
-        syncStatistics();
-    }
     return QWidget::event(event);
 }
 
+void mbCoreDeviceStatisticsUi::statisticsChanged(mbCoreDevice *device)
+{
+    if (device == m_device)
+        syncStatistics();
+}
+
 void mbCoreDeviceStatisticsUi::syncStatisticsCoreInner()
 {
     auto s = m_device->statisticsCore();
@@ -73,7 +82,8 @@ void mbCoreDeviceStatisticsUi::startScanning()
 {
     if (!isScanning())
     {
-        m_timerId = startTimer(500);
+        m_hub->subscribe(m_device);
+        m_scanning = true;
     }
 }
 
@@ -81,7 +91,8 @@ void mbCoreDeviceStatisticsUi::stopScanning()
 {
     if (isScanning())
     {
-        killTimer(m_timerId);
-        m_timerId = 0;
+        if (m_hub) // Note: hub can be destroyed before window on application exit
+            m_hub->unsubscribe(m_device);
+        m_scanning = false;
     }
 }
@@ -23,11 +23,14 @@
 #ifndef CORE_DEVICESTATISTICSUI_H
 #define CORE_DEVICESTATISTICSUI_H
 
+#include <QPointer>
+
 #include "core_statisticsui.h"
 
 class QLineEdit;
 class QPlainTextEdit;
 class mbCoreDevice;
+class mbCoreStatisticsHub;
 
 class MBTOOLS_EXPORT mbCoreDeviceStatisticsUi : public mbCoreStatisticsUi
 {
@@ -46,12 +49,15 @@ public:
 public Q_SLOTS:
     virtual void resetStatistics();
 
+protected Q_SLOTS:
+    void statisticsChanged(mbCoreDevice *device);
+
 protected:
     bool event(QEvent *event) override;
 
 protected:
     void syncStatisticsCoreInner();
-    inline bool isScanning() const { return m_timerId > 0; }
+    inline bool isScanning() const { return m_scanning; }
     void startScanning();
     void stopScanning();
 
@@ -75,7 +81,8 @@ protected:
     } m_ui;
 
 protected:
-    int m_timerId;
+    QPointer<mbCoreStatisticsHub> m_hub;
+    bool m_scanning;
 };
 
 #endif // CORE_DEVICESTATISTICSUI_H
@@ -3,19 +3,26 @@
 #include <QLineEdit>
 #include <QPlainTextEdit>
 
+#include <core.h>
+#include <gui/core_ui.h>
 #include <project/core_port.h>
 
+#include "core_statisticshub.h"
+
 mbCorePortStatisticsUi::mbCorePortStatisticsUi(mbCorePort *port, QWidget *parent) :
     mbCoreStatisticsUi(parent),
     m_port(port)
 {
-    m_timerId = 0;
+    m_scanning = false;
+    m_hub = mbCore::globalCore()->coreUi()->statisticsHub();
+    connect(m_hub, &mbCoreStatisticsHub::portStatisticsChanged, this, &mbCorePortStatisticsUi::statisticsChanged);
     connect(m_port, &mbCorePort::nameChanged, this, &mbCorePortStatisticsUi::setStatWindowTitle);
     setStatWindowTitle(m_port->name());
 }
 
 mbCorePortStatisticsUi::~mbCorePortStatisticsUi()
 {
+    stopScanning();
 }
 
 QString mbCorePortStatisticsUi::name() const
@@ -45,13 +52,15 @@ bool mbCorePortStatisticsUi::event(QEvent *event)
     {
         stopScanning();
     }
-    else if (event->type() == QEvent::Timer)
-    {
-        syncStatistics();
-    }
     return QWidget::event(event);
 }
 
+void mbCorePortStatisticsUi::statisticsChanged(mbCorePort *port)
+{
+    if (port == m_port)
+        syncStatistics();
+}
+
 void mbCorePortStatisticsUi::syncStatisticsCoreInner()
 {
     auto s = m_port->statisticsCore();
@@ -81,7 +90,8 @@ void mbCorePortStatisticsUi::startScanning()
 {
     if (!isScanning())
     {
-        m_timerId = startTimer(500);
+        m_hub->subscribe(m_port);
+        m_scanning = true;
     }
 }
 
@@ -89,7 +99,8 @@ void mbCorePortStatisticsUi::stopScanning()
 {
     if (isScanning())
     {
-        killTimer(m_timerId);
-        m_timerId = 0;
+        if (m_hub) // Note: hub can be destroyed before window on application exit
+            m_hub->unsubscribe(m_port);
+        m_scanning = false;
     }
 }
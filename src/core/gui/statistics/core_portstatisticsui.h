@@ -23,11 +23,14 @@
 #ifndef CORE_PORTSTATISTICSUI_H
 #define CORE_PORTSTATISTICSUI_H
 
+#include <QPointer>
+
 #include "core_statisticsui.h"
 
 class QLineEdit;
 class QPlainTextEdit;
 class mbCorePort;
+class mbCoreStatisticsHub;
 
 class MBTOOLS_EXPORT mbCorePortStatisticsUi : public mbCoreStatisticsUi
 {
@@ -46,12 +49,15 @@ public:
 public Q_SLOTS:
     virtual void resetStatistics();
 
+protected Q_SLOTS:
+    void statisticsChanged(mbCorePort *port);
+
 protected:
     bool event(QEvent *event) override;
 
 protected:
     void syncStatisticsCoreInner();
-    inline bool isScanning() const { return m_timerId > 0; }
+    inline bool isScanning() const { return m_scanning; }
     void startScanning();
     void stopScanning();
 
@@ -83,7 +89,8 @@ protected:
     } m_ui;
 
 protected:
-    int m_timerId;
+    QPointer<mbCoreStatisticsHub> m_hub;
+    bool m_scanning;
 };
 
 #endif // CORE_PORTSTATISTICSUI_H
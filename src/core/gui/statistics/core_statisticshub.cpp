@@ -0,0 +1,139 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "core_statisticshub.h"
+
+#include <QTimerEvent>
+
+#include <project/core_port.h>
+#include <project/core_device.h>
+
+mbCoreStatisticsHub::mbCoreStatisticsHub(QObject *parent) : QObject(parent)
+{
+    m_timerId = 0;
+}
+
+void mbCoreStatisticsHub::subscribe(mbCorePort *port)
+{
+    auto it = m_ports.find(port);
+    if (it != m_ports.end())
+    {
+        it.value().refs++;
+        return;
+    }
+    Subscription s;
+    s.refs = 1;
+    s.revision = port->statRevision();
+    m_ports.insert(port, s);
+    connect(port, &QObject::destroyed, this, [this, port]() {
+        m_ports.remove(port);
+        updateTimer();
+    });
+    updateTimer();
+}
+
+void mbCoreStatisticsHub::unsubscribe(mbCorePort *port)
+{
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
+        return;
+    if (--it.value().refs > 0)
+        return;
+    m_ports.erase(it);
+    port->disconnect(this);
+    updateTimer();
+}
+
+void mbCoreStatisticsHub::subscribe(mbCoreDevice *device)
+{
+    auto it = m_devices.find(device);
+    if (it != m_devices.end())
+    {
+        it.value().refs++;
+        return;
+    }
+    Subscription s;
+    s.refs = 1;
+    s.revision = device->statRevision();
+    m_devices.insert(device, s);
+    connect(device, &QObject::destroyed, this, [this, device]() {
+        m_devices.remove(device);
+        updateTimer();
+    });
+    updateTimer();
+}
+
+void mbCoreStatisticsHub::unsubscribe(mbCoreDevice *device)
+{
+    auto it = m_devices.find(device);
+    if (it == m_devices.end())
+        return;
+    if (--it.value().refs > 0)
+        return;
+    m_devices.erase(it);
+    device->disconnect(this);
+    updateTimer();
+}
+
+void mbCoreStatisticsHub::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timerId)
+        return;
+    // Note: list of changed objects is collected before signals emitted,
+    //       because subscriptions can be changed by signal receivers
+    QList<mbCorePort*> ports;
+    for (auto it = m_ports.begin(); it != m_ports.end(); ++it)
+    {
+        int revision = it.key()->statRevision();
+        if (it.value().revision != revision)
+        {
+            it.value().revision = revision;
+            ports.append(it.key());
+        }
+    }
+    QList<mbCoreDevice*> devices;
+    for (auto it = m_devices.begin(); it != m_devices.end(); ++it)
+    {
+        int revision = it.key()->statRevision();
+        if (it.value().revision != revision)
+        {
+            it.value().revision = revision;
+            devices.append(it.key());
+        }
+    }
+    Q_FOREACH (mbCorePort *port, ports)
+        Q_EMIT portStatisticsChanged(port);
+    Q_FOREACH (mbCoreDevice *device, devices)
+        Q_EMIT deviceStatisticsChanged(device);
+}
+
+void mbCoreStatisticsHub::updateTimer()
+{
+    bool active = m_ports.count() || m_devices.count();
+    if (active && !m_timerId)
+        m_timerId = startTimer(PublishInterval);
+    else if (!active && m_timerId)
+    {
+        killTimer(m_timerId);
+        m_timerId = 0;
+    }
+}
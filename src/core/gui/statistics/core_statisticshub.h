@@ -0,0 +1,79 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CORE_STATISTICSHUB_H
+#define CORE_STATISTICSHUB_H
+
+#include <QHash>
+#include <QObject>
+
+#include <mbcore.h>
+
+class mbCorePort;
+class mbCoreDevice;
+
+/*
+   Statistics hub publishes changes of port and device statistics to the GUI.
+   Only subscribed (watched) ports and devices are checked once per 'PublishInterval' ms
+   and 'portStatisticsChanged'/'deviceStatisticsChanged' signal is emitted only when
+   statistics revision was changed since the last publication.
+   Timer of the hub runs only while there are subscriptions.
+*/
+class MBTOOLS_EXPORT mbCoreStatisticsHub : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum { PublishInterval = 250 };
+
+public:
+    explicit mbCoreStatisticsHub(QObject *parent = nullptr);
+
+public:
+    void subscribe(mbCorePort *port);
+    void unsubscribe(mbCorePort *port);
+    void subscribe(mbCoreDevice *device);
+    void unsubscribe(mbCoreDevice *device);
+
+Q_SIGNALS:
+    void portStatisticsChanged(mbCorePort *port);
+    void deviceStatisticsChanged(mbCoreDevice *device);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    void updateTimer();
+
+private:
+    struct Subscription
+    {
+        int refs;
+        int revision;
+    };
+
+    QHash<mbCorePort*, Subscription> m_ports;
+    QHash<mbCoreDevice*, Subscription> m_devices;
+    int m_timerId;
+};
+
+#endif // CORE_STATISTICSHUB_H
@@ -3,9 +3,11 @@ HEADERS += \
     $$PWD/core_portstatisticsui.h    \
     $$PWD/core_devicestatisticsui.h  \
     $$PWD/core_statisticsmanager.h   \
+    $$PWD/core_statisticshub.h       \
 
 SOURCES += \
     $$PWD/core_statisticsui.cpp      \
     $$PWD/core_portstatisticsui.cpp  \
     $$PWD/core_devicestatisticsui.cpp\
     $$PWD/core_statisticsmanager.cpp \
+    $$PWD/core_statisticshub.cpp     \
@@ -25,6 +25,9 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QSettings>
+#include <QThread>
+#include <QCoreApplication>
+#include <QElapsedTimer>
 
 #include <core.h>
 #include <task/core_taskfactoryinfo.h>
@@ -35,6 +38,7 @@
 #include "core_dataview.h"
 #include "core_dom.h"
 #include "core_taskinfo.h"
+#include "core_csv.h"
 
 class DomDataViewItems : public mbCoreDomItems<mbCoreDomDataViewItem>
 {
@@ -67,28 +71,69 @@ const mbCoreBuilder::Strings &mbCoreBuilder::Strings::instance()
     return s;
 }
 
+class mbCoreBuilderWorker : public QThread
+{
+public:
+    mbCoreBuilderWorker(const std::function<void(int)> &make, int count, QAtomicInt *next, QAtomicInt *done) :
+        m_make(make), m_count(count), m_next(next), m_done(done) {}
+
+protected:
+    void run() override
+    {
+        int i;
+        while ((i = m_next->fetchAndAddOrdered(1)) < m_count)
+        {
+            m_make(i);
+            m_done->ref();
+        }
+    }
+
+private:
+    const std::function<void(int)> &m_make;
+    const int m_count;
+    QAtomicInt *m_next;
+    QAtomicInt *m_done;
+};
+
 mbCoreBuilder::mbCoreBuilder(QObject *parent) :
     QObject (parent)
 {
     m_workingProject = nullptr;
+    m_loading = false;
+    m_binary = false;
     m_project = mbCore::globalCore()->projectCore();
     connect(mbCore::globalCore(), &mbCore::projectChanged, this, &mbCoreBuilder::setProject);
 }
 
 mbCoreProject *mbCoreBuilder::loadCore(const QString &file)
 {
+    if (m_loading)
+    {
+        setError(QStringLiteral("Another project is being loaded"));
+        return nullptr;
+    }
+    if (isBinaryProjectFile(file))
+        return loadBinary(file);
     return loadXml(file);
 }
 
 bool mbCoreBuilder::saveCore(mbCoreProject *project)
 {
+    if (m_loading)
+    {
+        setError(QStringLiteral("Can't save project while another project is being loaded"));
+        return false;
+    }
+    QString suffix = binaryProjectSuffix();
+    if (!suffix.isEmpty() && (QFileInfo(project->absoluteFilePath()).suffix().compare(suffix, Qt::CaseInsensitive) == 0))
+        return saveBinary(project);
     return saveXml(project);
 }
 
 bool mbCoreBuilder::importProject(const QString &file)
 {
     mbCoreProject *project = m_project;
-    if (!project)
+    if (!project || m_loading)
         return false;
 
     QScopedPointer<mbCoreDomProject> dom(newDomProject());
@@ -119,14 +164,11 @@ bool mbCoreBuilder::importProject(const QString &file)
 
 mbCoreProject *mbCoreBuilder::loadXml(const QString &file)
 {
+    QElapsedTimer timer;
+    timer.start();
     QScopedPointer<mbCoreDomProject> dom(newDomProject());
     if (loadXml(file, dom.data()))
-    {
-        mbCoreProject* project = toProject(dom.data());
-        project->setAbsoluteFilePath(file);
-        refreshProjectFileInfo(project);
-        return project;
-    }
+        return toLoadedProject(file, dom.data(), timer.elapsed());
     return nullptr;
 }
 
@@ -148,6 +190,30 @@ bool mbCoreBuilder::saveXml(mbCoreProject *project)
     return r;
 }
 
+mbCoreProject *mbCoreBuilder::toLoadedProject(const QString &file, const mbCoreDomProject *dom, qint64 parseTime)
+{
+    if (m_loading)
+    {
+        setError(QStringLiteral("Another project is being loaded"));
+        return nullptr;
+    }
+    QElapsedTimer timer;
+    timer.start();
+    // Note: 'materialize' keeps the event loop alive, so re-entry is refused while the project is built
+    m_loading = true;
+    mbCoreProject* project = toProject(dom);
+    m_loading = false;
+    project->setAbsoluteFilePath(file);
+    refreshProjectFileInfo(project);
+    qint64 buildTime = timer.elapsed();
+    mbCore::LogInfo(QStringLiteral("Builder"), QString("Project '%1' loaded in %2 ms (parse %3 ms, build %4 ms)")
+                                                   .arg(file)
+                                                   .arg(parseTime+buildTime)
+                                                   .arg(parseTime)
+                                                   .arg(buildTime));
+    return project;
+}
+
 void mbCoreBuilder::beginSaveProject(mbCoreProject *project)
 {
     project->resetVersion();
@@ -239,6 +305,103 @@ bool mbCoreBuilder::saveXml(QIODevice *io, const mbCoreDom *dom)
     return true;
 }
 
+QString mbCoreBuilder::binaryProjectSuffix() const
+{
+    return QString();
+}
+
+bool mbCoreBuilder::isBinaryProjectFile(const QString &file)
+{
+    QFile qf(file);
+    if (!qf.open(QIODevice::ReadOnly))
+        return false;
+    return mbCoreDomBinaryReader::isBinary(qf.read(mbCoreDomBinaryWriter::signature().size()));
+}
+
+mbCoreProject *mbCoreBuilder::loadBinary(const QString &file)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QScopedPointer<mbCoreDomProject> dom(newDomProject());
+    if (loadBinary(file, dom.data()))
+        return toLoadedProject(file, dom.data(), timer.elapsed());
+    return nullptr;
+}
+
+bool mbCoreBuilder::saveBinary(mbCoreProject *project)
+{
+    beginSaveProject(project);
+    m_binary = true;
+    QScopedPointer<mbCoreDomProject> dom(toDomProject(project));
+    m_binary = false;
+    if (!dom)
+        return false;
+    // Make sure that path is exists
+    QDir dir;
+    if (!dir.mkpath(project->absoluteDirPath()))
+    {
+        setError(QString("Can't create project directory '%1'").arg(project->absoluteDirPath()));
+        return false;
+    }
+    bool r = saveBinary(project->absoluteFilePath(), dom.data());
+    refreshProjectFileInfo(project);
+    return r;
+}
+
+bool mbCoreBuilder::loadBinary(const QString &file, mbCoreDom *dom)
+{
+    QFile qf(file);
+    if (!qf.open(QIODevice::ReadOnly))
+    {
+        setError(qf.errorString());
+        return false;
+    }
+    bool r = loadBinary(&qf, dom);
+    qf.close();
+    return r;
+}
+
+bool mbCoreBuilder::loadBinary(QIODevice *io, mbCoreDom *dom)
+{
+    mbCoreDomBinaryReader reader(io->readAll());
+    if (!reader.hasError())
+        dom->readBinary(reader);
+    if (reader.hasError())
+    {
+        setError(reader.errorString());
+        return false;
+    }
+    if (!reader.atEnd())
+        mbCore::LogWarning(QStringLiteral("Builder"), QStringLiteral("Unexpected data at the end of binary project"));
+    return true;
+}
+
+bool mbCoreBuilder::saveBinary(const QString &file, const mbCoreDom *dom)
+{
+    QFile qf(file);
+    if (!qf.open(QIODevice::WriteOnly))
+    {
+        setError(qf.errorString());
+        return false;
+    }
+    bool r = saveBinary(&qf, dom);
+    qf.close();
+    return r;
+}
+
+bool mbCoreBuilder::saveBinary(QIODevice *io, const mbCoreDom *dom)
+{
+    mbCoreDomBinaryWriter writer;
+    dom->writeBinary(writer);
+    QByteArray data = writer.data();
+    if (io->write(data) != data.size())
+    {
+        setError(io->errorString());
+        return false;
+    }
+    return true;
+}
+
 QStringList mbCoreBuilder::csvDataViewItemAttributes() const
 {
     const mbCoreDataViewItem::Strings &s = mbCoreDataViewItem::Strings::instance();
@@ -386,23 +549,40 @@ void mbCoreBuilder::fillProject(mbCoreProject *obj, const mbCoreDomProject *dom)
     obj->setEditNumber(dom->editNumber());
     obj->setWindowsData(dom->windowsData());
 
-    Q_FOREACH(mbCoreDomDevice *d, dom->devices())
-    {
-        mbCoreDevice *v = toDevice(d);
+    QThread *target = thread();
+
+    // Devices and data views don't depend on each other while being built,
+    // so they are materialized on worker threads and added in original order
+    const QList<mbCoreDomDevice*> domDevices = dom->devices();
+    QVector<mbCoreDevice*> devices(domDevices.count());
+    mbCoreDevice **pDevices = devices.data();
+    materialize(QStringLiteral("Devices"), devices.count(), [&](int i) {
+        mbCoreDevice *v = toDevice(domDevices.at(i));
+        v->moveToThread(target);
+        pDevices[i] = v;
+    });
+    Q_FOREACH(mbCoreDevice *v, devices)
         obj->deviceAdd(v);
-    }
 
+    // Ports refer to devices by name, so they are built after all devices are added
     Q_FOREACH(mbCoreDomPort *d, dom->ports())
     {
         mbCorePort *v = toPort(d);
         obj->portAdd(v);
     }
 
-    Q_FOREACH(mbCoreDomDataView *d, dom->dataViews())
-    {
-        mbCoreDataView *v = toDataView(d);
+    const QList<mbCoreDomDataView*> domDataViews = dom->dataViews();
+    QVector<mbCoreDataView*> dataViews(domDataViews.count());
+    mbCoreDataView **pDataViews = dataViews.data();
+    materialize(QStringLiteral("Data Views"), dataViews.count(), [&](int i) {
+        mbCoreDataView *v = toDataView(domDataViews.at(i));
+        Q_FOREACH (mbCoreDataViewItem *item, v->itemsCore())
+            item->moveToThread(target);
+        v->moveToThread(target);
+        pDataViews[i] = v;
+    });
+    Q_FOREACH(mbCoreDataView *v, dataViews)
         obj->dataViewAdd(v);
-    }
 
     Q_FOREACH (mbCoreDomTaskInfo* d, dom->tasks())
     {
@@ -416,6 +596,37 @@ void mbCoreBuilder::fillProject(mbCoreProject *obj, const mbCoreDomProject *dom)
     m_workingProject = nullptr;
 }
 
+void mbCoreBuilder::materialize(const QString &stage, int count, const std::function<void(int)> &make)
+{
+    int threadCount = qMin(QThread::idealThreadCount(), count);
+    if (threadCount < 2)
+    {
+        for (int i = 0; i < count; i++)
+            make(i);
+        Q_EMIT loadProgress(stage, count, count);
+        return;
+    }
+    QAtomicInt next(0);
+    QAtomicInt done(0);
+    QList<mbCoreBuilderWorker*> workers;
+    for (int i = 0; i < threadCount; i++)
+    {
+        mbCoreBuilderWorker *w = new mbCoreBuilderWorker(make, count, &next, &done);
+        w->start();
+        workers.append(w);
+    }
+    Q_FOREACH (mbCoreBuilderWorker *w, workers)
+    {
+        while (!w->wait(LoadProgressInterval))
+        {
+            Q_EMIT loadProgress(stage, done.load(), count);
+            QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+        }
+        delete w;
+    }
+    Q_EMIT loadProgress(stage, count, count);
+}
+
 void mbCoreBuilder::fillPort(mbCorePort *obj, const mbCoreDomPort *dom)
 {
     obj->setSettings(dom->settings());
@@ -423,7 +634,14 @@ void mbCoreBuilder::fillPort(mbCorePort *obj, const mbCoreDomPort *dom)
 
 void mbCoreBuilder::fillDevice(mbCoreDevice *obj, const mbCoreDomDevice *dom)
 {
-    obj->setSettings(dom->settings());
+    if (dom->record().isEmpty())
+    {
+        obj->setSettings(dom->settings());
+        return;
+    }
+    mbCoreBinaryReader reader(dom->record());
+    if (!obj->readRecord(reader))
+        mbCore::LogWarning(QStringLiteral("Builder"), QString("Device '%1' has corrupted binary record").arg(dom->name()));
 }
 
 void mbCoreBuilder::fillDataView(mbCoreDataView *obj, const mbCoreDomDataView *dom)
@@ -448,9 +666,16 @@ void mbCoreBuilder::fillDataViewItem(mbCoreDataViewItem *obj, const mbCoreDomDat
         mbCoreDevice *dev = project->deviceCore(dom->device());
         obj->setDeviceCore(dev);
     }
-    MBSETTINGS settings = dom->settings();
-    settings.remove(mbCoreDataViewItem::Strings::instance().device);
-    obj->setSettings(settings);
+    if (dom->record().isEmpty())
+    {
+        MBSETTINGS settings = dom->settings();
+        settings.remove(mbCoreDataViewItem::Strings::instance().device);
+        obj->setSettings(settings);
+        return;
+    }
+    mbCoreBinaryReader reader(dom->record());
+    if (!obj->readRecord(reader))
+        mbCore::LogWarning(QStringLiteral("Builder"), QString("Data view item of device '%1' has corrupted binary record").arg(dom->device()));
 }
 
 void mbCoreBuilder::fillDomProject(mbCoreDomProject *dom, const mbCoreProject *obj)
@@ -508,7 +733,15 @@ void mbCoreBuilder::fillDomPort(mbCoreDomPort *dom, const mbCorePort *obj)
 
 void mbCoreBuilder::fillDomDevice(mbCoreDomDevice *dom, const mbCoreDevice *obj)
 {
-    dom->setSettings(obj->settings());
+    if (m_binary)
+    {
+        mbCoreBinaryWriter writer;
+        obj->writeRecord(writer);
+        dom->setName(obj->name());
+        dom->setRecord(writer.data());
+    }
+    else
+        dom->setSettings(obj->settings());
 }
 
 void mbCoreBuilder::fillDomDataView(mbCoreDomDataView *dom, const mbCoreDataView *obj)
@@ -534,6 +767,13 @@ void mbCoreBuilder::fillDomDataViewItem(mbCoreDomDataViewItem *dom, const mbCore
     mbCoreDevice *dev = obj->deviceCore();
     if (dev)
         dom->setDevice(dev->name());
+    if (m_binary)
+    {
+        mbCoreBinaryWriter writer;
+        obj->writeRecord(writer);
+        dom->setRecord(writer.data());
+        return;
+    }
     MBSETTINGS settings = obj->settings();
     settings.remove(mbCoreDataViewItem::Strings::instance().device);
     dom->setSettings(settings);
@@ -645,15 +885,9 @@ mbCoreDataView *mbCoreBuilder::importDataViewXml(QIODevice *io)
 
 mbCoreDataView *mbCoreBuilder::importDataViewCsv(QIODevice *io)
 {
-    qint64 mempos = io->pos();
-    QByteArray headerBytes = io->readLine();
-    QString header = QString::fromUtf8(headerBytes);
+    mbCoreCsvReader reader(io, Strings::instance().csvSep.toLatin1());
     MBSETTINGS settings;
-    if (header.startsWith(Strings::instance().dataViewPrefix))
-        settings = parseCsvDataViewSettings(header);
-    else
-        io->seek(mempos);
-    QList<mbCoreDataViewItem*> items = importDataViewItemsCsv(io);
+    QList<mbCoreDataViewItem*> items = importDataViewItemsCsv(reader, &settings);
     mbCoreDataView *view = newDataView();
     if (settings.count())
         view->setSettings(settings);
@@ -671,18 +905,31 @@ QList<mbCoreDataViewItem *> mbCoreBuilder::importDataViewItemsXml(QIODevice *io)
 }
 
 QList<mbCoreDataViewItem *> mbCoreBuilder::importDataViewItemsCsv(QIODevice *io)
+{
+    mbCoreCsvReader reader(io, Strings::instance().csvSep.toLatin1());
+    return importDataViewItemsCsv(reader, nullptr);
+}
+
+QList<mbCoreDataViewItem *> mbCoreBuilder::importDataViewItemsCsv(mbCoreCsvReader &reader, MBSETTINGS *viewSettings)
 {
     QList<mbCoreDataViewItem *> items;
-    QString header = QString::fromUtf8(io->readLine());
-    if (header.startsWith(Strings::instance().dataViewPrefix))
-        header = QString::fromUtf8(io->readLine());
-    QStringList attrNames = parseCsvRow(header);
-    if (attrNames.isEmpty())
+    QStringList attrNames;
+    if (!reader.readRow(attrNames))
+        return items;
+    if (attrNames.first().startsWith(Strings::instance().dataViewPrefix))
+    {
+        if (viewSettings)
+            *viewSettings = parseCsvDataViewSettings(attrNames);
+        if (!reader.readRow(attrNames))
+            return items;
+    }
+    if (reader.isEmptyRow())
         return items;
-    while (!io->atEnd())
+    QStringList row;
+    while (reader.readRow(row))
     {
-        QByteArray line = io->readLine();
-        QString row = QString::fromUtf8(line);
+        if (reader.isEmptyRow())
+            continue;
         MBSETTINGS settings = parseCsvRowItem(attrNames, row);
         if (settings.isEmpty())
             continue;
@@ -777,7 +1024,8 @@ bool mbCoreBuilder::exportDataViewXml(QIODevice *io, mbCoreDataView *cfg)
 bool mbCoreBuilder::exportDataViewCsv(QIODevice *io, mbCoreDataView *cfg)
 {
     QString s = makeCsvDataViewSettings(Strings::instance().dataViewAttrNames, cfg->settings());
-    io->write(s.toUtf8());
+    if (io->write(s.toUtf8()) < 0)
+        return false;
     return exportDataViewItemsCsv(io, cfg->itemsCore());
 }
 
@@ -790,15 +1038,14 @@ bool mbCoreBuilder::exportDataViewItemsXml(QIODevice *io, const QList<mbCoreData
 bool mbCoreBuilder::exportDataViewItemsCsv(QIODevice *io, const QList<mbCoreDataViewItem *> &cfg)
 {
     QStringList lsHeader = csvDataViewItemAttributes();
-    QString sHeader = makeCsvRow(lsHeader);
-    io->write(sHeader.toUtf8());
+    mbCoreCsvWriter writer(io, Strings::instance().csvSep.toLatin1());
+    writer.writeRow(lsHeader);
     Q_FOREACH (const mbCoreDataViewItem *item, cfg)
     {
         MBSETTINGS settings = toSettings(item);
-        QString sLine = makeCsvRowItem(lsHeader, settings);
-        io->write(sLine.toUtf8());
+        writer.writeRow(csvRowItem(lsHeader, settings));
     }
-    return true;;
+    return writer.flush();
 }
 
 QList<mbCoreDataViewItem *> mbCoreBuilder::toDataViewItems(DomDataViewItems *dom)
@@ -837,13 +1084,12 @@ void mbCoreBuilder::setProject(mbCoreProject *project)
     m_project = project;
 }
 
-MBSETTINGS mbCoreBuilder::parseCsvDataViewSettings(const QString &row)
+MBSETTINGS mbCoreBuilder::parseCsvDataViewSettings(const QStringList &attrs)
 {
     MBSETTINGS settings;
-    QStringList attrs = parseCsvRow(row);
 
     // Note: pass attrs[0] that must be equal to "dataview"
-    for (int i = 0; i < attrs.count() /2; i++)
+    for (int i = 0; i < (attrs.count()-1) /2; i++)
     {
         QString name = attrs.at(i*2+1);
         QString value = attrs.at(i*2+2);
@@ -867,10 +1113,9 @@ QString mbCoreBuilder::makeCsvDataViewSettings(const QStringList &attrNames, con
     return v;
 }
 
-MBSETTINGS mbCoreBuilder::parseCsvRowItem(const QStringList &attrNames, const QString &row)
+MBSETTINGS mbCoreBuilder::parseCsvRowItem(const QStringList &attrNames, const QStringList &attrs)
 {
     MBSETTINGS settings;
-    QStringList attrs = parseCsvRow(row);
     QStringList::ConstIterator it = attrs.constBegin();
     QStringList::ConstIterator end = attrs.constEnd();
 
@@ -884,16 +1129,21 @@ MBSETTINGS mbCoreBuilder::parseCsvRowItem(const QStringList &attrNames, const QS
     return settings;
 }
 
-QString mbCoreBuilder::makeCsvRowItem(const QStringList &attrNames, const MBSETTINGS &settings)
+QStringList mbCoreBuilder::csvRowItem(const QStringList &attrNames, const MBSETTINGS &settings)
 {
     QStringList attrs;
+    attrs.reserve(attrNames.count());
 
-    Q_FOREACH (const QString attrName, attrNames)
+    Q_FOREACH (const QString &attrName, attrNames)
     {
         attrs.append(settings.value(attrName).toString());
     }
+    return attrs;
+}
 
-    QString v = makeCsvRow(attrs);
+QString mbCoreBuilder::makeCsvRowItem(const QStringList &attrNames, const MBSETTINGS &settings)
+{
+    QString v = makeCsvRow(csvRowItem(attrNames, settings));
     return v;
 }
 
@@ -25,6 +25,8 @@
 
 #include <QObject>
 
+#include <functional>
+
 #include <mbcore.h>
 
 class QIODevice;
@@ -35,6 +37,7 @@ class mbCoreDevice;
 class mbCoreDataView;
 class mbCoreDataViewItem;
 class mbCoreTaskInfo;
+class mbCoreCsvReader;
 
 class mbCoreDom;
 class mbCoreDomProject;
@@ -49,6 +52,12 @@ class DomDataViewItems;
 class MBTOOLS_EXPORT mbCoreBuilder : public QObject
 {
     Q_OBJECT
+public:
+    enum
+    {
+        LoadProgressInterval = 50 // ms between 'loadProgress' while materializing objects
+    };
+
 public:
     struct MBTOOLS_EXPORT Strings
     {
@@ -68,6 +77,8 @@ public:
 public:
     inline mbCoreProject *projectCore() const { if (m_workingProject) return m_workingProject; else return m_project; }
     inline void setWorkingProjectCore(mbCoreProject *project) { m_workingProject = project; }
+    // Note: true while project is being built, see 'materialize'
+    inline bool isLoading() const { return m_loading; }
 
 public: // errors
     inline bool hasError() const { return !m_errors.isEmpty(); }
@@ -92,6 +103,16 @@ public: // .xml project
     bool saveXml(const QString &file, const mbCoreDom *dom);
     bool saveXml(QIODevice *io, const mbCoreDom *dom);
 
+public: // binary project
+    virtual QString binaryProjectSuffix() const;
+    bool isBinaryProjectFile(const QString &file);
+    virtual mbCoreProject *loadBinary(const QString &file);
+    virtual bool saveBinary(mbCoreProject *project);
+    bool loadBinary(const QString &file, mbCoreDom *dom);
+    bool loadBinary(QIODevice *io, mbCoreDom *dom);
+    bool saveBinary(const QString &file, const mbCoreDom *dom);
+    bool saveBinary(QIODevice *io, const mbCoreDom *dom);
+
 public:
     virtual QStringList csvDataViewItemAttributes() const;
 
@@ -178,21 +199,45 @@ protected:
 
 protected:
     virtual void importDomProject(mbCoreDomProject *dom);
+    mbCoreProject *toLoadedProject(const QString &file, const mbCoreDomProject *dom, qint64 parseTime);
+
+Q_SIGNALS:
+    void loadProgress(const QString &stage, int done, int total);
+
+protected:
+    // Calls 'make(i)' for i in [0, count) spread over worker threads and waits for it
+    // keeping the event loop alive. Objects created by 'make' must be moved to 'thread()'.
+    // While waiting only non-input events are processed: timers, queued signals/slots (e.g. log
+    // messages from other threads), paint and expose events, so 'loadProgress' receivers can
+    // repaint (note that modal 'QProgressDialog::setValue' processes events too, user input to
+    // other windows is blocked by the modality). Workers read the project through 'projectCore()',
+    // so handlers of these events must not change the project or the builder state: 'isLoading()'
+    // is set meanwhile and 'loadCore', 'saveCore' and 'importProject' refuse to run.
+    void materialize(const QString &stage, int count, const std::function<void(int)> &make);
 
 protected Q_SLOTS:
     void setProject(mbCoreProject *project);
 
 protected:
-    MBSETTINGS parseCsvDataViewSettings(const QString &row);
+    // Reads optional data view settings row (stored into 'viewSettings' if not null), header and items row by row
+    QList<mbCoreDataViewItem*> importDataViewItemsCsv(mbCoreCsvReader &reader, MBSETTINGS *viewSettings);
+
+protected:
+    MBSETTINGS parseCsvDataViewSettings(const QStringList &attrs);
     QString makeCsvDataViewSettings(const QStringList &attrNames, const MBSETTINGS &settings);
-    MBSETTINGS parseCsvRowItem(const QStringList &attrNames, const QString &row);
+    MBSETTINGS parseCsvRowItem(const QStringList &attrNames, const QStringList &attrs);
+    QStringList csvRowItem(const QStringList &attrNames, const MBSETTINGS &settings);
     QString makeCsvRowItem(const QStringList &attrNames, const MBSETTINGS &settings);
+    // Parses the whole 'row' string as a single CSV row: line breaks inside it (quoted or not) are kept as field data
     QStringList parseCsvRow(const QString &row);
     QString makeCsvRow(const QStringList &items);
 
 protected:
     mbCoreProject *m_project;
     mbCoreProject *m_workingProject;
+    bool m_loading;
+    // Note: true while dom of binary project is made, so 'fillDom*' store typed records instead of settings
+    bool m_binary;
     QStringList m_errors;
 };
 
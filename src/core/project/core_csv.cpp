@@ -0,0 +1,234 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#include "core_csv.h"
+
+#include <string.h>
+
+#include <QIODevice>
+
+mbCoreCsvReader::mbCoreCsvReader(QIODevice *io, char sep)
+{
+    m_io = io;
+    m_sep = sep;
+    m_pos = 0;
+    m_rowNumber = 0;
+    m_buff.reserve(ChunkSize * 2);
+    m_row.reserve(1024);
+}
+
+bool mbCoreCsvReader::readRow()
+{
+    const char *eol;
+    // make sure that the whole line is in the buffer
+    for (;;)
+    {
+        eol = static_cast<const char*>(memchr(m_buff.constData() + m_pos, '\n', static_cast<size_t>(m_buff.size() - m_pos)));
+        if (eol || !fill(true))
+            break;
+    }
+    if (m_pos >= m_buff.size())
+        return false;
+    m_rowNumber++;
+    const char *begin = m_buff.constData() + m_pos;
+    const char *end = eol ? eol : m_buff.constData() + m_buff.size();
+    if (memchr(begin, '"', static_cast<size_t>(end - begin)))
+    {
+        readQuotedRow();
+        return true;
+    }
+    m_pos = static_cast<int>(end - m_buff.constData()) + (eol ? 1 : 0);
+    if ((end > begin) && (end[-1] == '\r'))
+        --end;
+    splitRow(begin, end);
+    return true;
+}
+
+bool mbCoreCsvReader::readRow(QStringList &fields)
+{
+    fields.clear();
+    if (!readRow())
+        return false;
+    fields = this->fields();
+    return true;
+}
+
+QStringList mbCoreCsvReader::fields() const
+{
+    QStringList ls;
+    ls.reserve(m_ends.count());
+    for (int i = 0; i < m_ends.count(); i++)
+        ls.append(fieldString(i));
+    return ls;
+}
+
+bool mbCoreCsvReader::fill(bool compact)
+{
+    // Note: compacting is allowed only between rows because it moves unparsed data to the front
+    if (compact && m_pos > 0)
+    {
+        m_buff.remove(0, m_pos);
+        m_pos = 0;
+    }
+    QByteArray chunk = m_io->read(ChunkSize);
+    if (chunk.isEmpty())
+        return false;
+    m_buff.append(chunk);
+    return true;
+}
+
+void mbCoreCsvReader::splitRow(const char *begin, const char *end)
+{
+    int len = static_cast<int>(end - begin);
+    m_row.resize(len);
+    memcpy(m_row.data(), begin, static_cast<size_t>(len));
+    m_begins.clear();
+    m_ends.clear();
+    const char *data = m_row.constData();
+    const char *p = data;
+    const char *e = data + len;
+    for (;;)
+    {
+        const char *s = static_cast<const char*>(memchr(p, m_sep, static_cast<size_t>(e - p)));
+        m_begins.append(static_cast<int>(p - data));
+        if (!s)
+        {
+            m_ends.append(len);
+            break;
+        }
+        m_ends.append(static_cast<int>(s - data));
+        p = s + 1;
+    }
+}
+
+void mbCoreCsvReader::readQuotedRow()
+{
+    m_row.resize(0);
+    m_begins.clear();
+    m_ends.clear();
+    m_begins.append(0);
+    bool inQuotes = false;
+    int i = m_pos;
+    for (;; i++)
+    {
+        if ((i >= m_buff.size()) && !fill(false))
+            break;
+        char c = m_buff.at(i);
+        if (c == '"')
+        {
+            if (inQuotes && ((i + 1 < m_buff.size()) || fill(false)) && (m_buff.at(i + 1) == '"'))
+            {
+                // two consecutive quotes inside quoted field -> single quote
+                m_row.append('"');
+                ++i;
+            }
+            else
+                inQuotes = !inQuotes;
+        }
+        else if (inQuotes)
+            m_row.append(c);
+        else if (c == m_sep)
+        {
+            m_ends.append(m_row.size());
+            m_begins.append(m_row.size());
+        }
+        else if (c == '\n')
+        {
+            ++i;
+            break;
+        }
+        else if ((c != '\r') || (((i + 1 < m_buff.size()) || fill(false)) && (m_buff.at(i + 1) != '\n')))
+            m_row.append(c);
+    }
+    m_ends.append(m_row.size());
+    m_pos = i;
+}
+
+mbCoreCsvWriter::mbCoreCsvWriter(QIODevice *io, char sep)
+{
+    m_io = io;
+    m_sep = sep;
+    m_rowStarted = false;
+    m_ok = true;
+    m_buff.reserve(ChunkSize + ChunkSize / 4);
+}
+
+mbCoreCsvWriter::~mbCoreCsvWriter()
+{
+    flush();
+}
+
+void mbCoreCsvWriter::writeField(const char *data, int size)
+{
+    if (m_rowStarted)
+        m_buff.append(m_sep);
+    m_rowStarted = true;
+    size_t sz = static_cast<size_t>(size);
+    bool requiresQuotes = memchr(data, m_sep, sz) || memchr(data, '"', sz) || memchr(data, '\n', sz) || memchr(data, '\r', sz);
+    if (requiresQuotes)
+    {
+        m_buff.append('"');
+        const char *e = data + size;
+        for (const char *p = data; p < e;)
+        {
+            // escape quotes by doubling them
+            const char *q = static_cast<const char*>(memchr(p, '"', static_cast<size_t>(e - p)));
+            if (!q)
+            {
+                m_buff.append(p, static_cast<int>(e - p));
+                break;
+            }
+            m_buff.append(p, static_cast<int>(q - p) + 1);
+            m_buff.append('"');
+            p = q + 1;
+        }
+        m_buff.append('"');
+    }
+    else
+        m_buff.append(data, size);
+}
+
+void mbCoreCsvWriter::endRow()
+{
+    m_buff.append('\n');
+    m_rowStarted = false;
+    if (m_buff.size() >= ChunkSize)
+        flush();
+}
+
+void mbCoreCsvWriter::writeRow(const QStringList &fields)
+{
+    Q_FOREACH (const QString &f, fields)
+        writeField(f);
+    endRow();
+}
+
+bool mbCoreCsvWriter::flush()
+{
+    if (m_buff.size())
+    {
+        if (m_io->write(m_buff) != m_buff.size())
+            m_ok = false;
+        m_buff.resize(0);
+    }
+    return m_ok;
+}
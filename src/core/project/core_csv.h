@@ -0,0 +1,104 @@
+/*
+    Modbus Tools
+
+    Created: 2026
+    Author: Serhii Marchuk, https://github.com/serhmarch
+
+    Copyright (C) 2026  Serhii Marchuk
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+*/
+#ifndef CORE_CSV_H
+#define CORE_CSV_H
+
+#include <QByteArray>
+#include <QStringList>
+#include <QVector>
+
+#include <mbcore.h>
+
+class QIODevice;
+
+// Streaming reader of UTF-8 CSV data. Input is read in large chunks and every row
+// is split in place: rows without quotes are cut with 'memchr' (vectorized by the C library),
+// rows with quotes go through a byte state machine that also handles quoted line breaks.
+// Fields of the current row stay valid until the next call of 'readRow()'.
+class MBTOOLS_EXPORT mbCoreCsvReader
+{
+public:
+    enum { ChunkSize = 64 * 1024 };
+
+public:
+    mbCoreCsvReader(QIODevice *io, char sep);
+
+public:
+    inline char separator() const { return m_sep; }
+    inline qint64 rowNumber() const { return m_rowNumber; }
+
+public:
+    bool readRow();
+    bool readRow(QStringList &fields);
+    inline bool isEmptyRow() const { return (m_ends.count() == 1) && (m_ends.at(0) == 0); }
+    inline int fieldCount() const { return m_ends.count(); }
+    inline const char *fieldData(int i) const { return m_row.constData() + m_begins.at(i); }
+    inline int fieldSize(int i) const { return m_ends.at(i) - m_begins.at(i); }
+    inline QByteArray field(int i) const { return QByteArray(fieldData(i), fieldSize(i)); }
+    inline QString fieldString(int i) const { return QString::fromUtf8(fieldData(i), fieldSize(i)); }
+    QStringList fields() const;
+
+private:
+    bool fill(bool compact);
+    void splitRow(const char *begin, const char *end);
+    void readQuotedRow();
+
+private:
+    QIODevice *m_io;
+    char m_sep;
+    QByteArray m_buff;
+    int m_pos;
+    QByteArray m_row;
+    QVector<int> m_begins;
+    QVector<int> m_ends;
+    qint64 m_rowNumber;
+};
+
+// Buffered writer of UTF-8 CSV data. Rows are accumulated in memory
+// and written to the device in blocks of 'ChunkSize' bytes.
+class MBTOOLS_EXPORT mbCoreCsvWriter
+{
+public:
+    enum { ChunkSize = 64 * 1024 };
+
+public:
+    mbCoreCsvWriter(QIODevice *io, char sep);
+    ~mbCoreCsvWriter();
+
+public:
+    void writeField(const char *data, int size);
+    inline void writeField(const QByteArray &v) { writeField(v.constData(), v.size()); }
+    inline void writeField(const QString &v) { writeField(v.toUtf8()); }
+    void endRow();
+    void writeRow(const QStringList &fields);
+    bool flush();
+
+private:
+    QIODevice *m_io;
+    char m_sep;
+    QByteArray m_buff;
+    bool m_rowStarted;
+    bool m_ok;
+};
+
+#endif // CORE_CSV_H
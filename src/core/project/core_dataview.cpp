@@ -23,10 +23,21 @@
 #include "core_dataview.h"
 
 #include <QByteArray>
+#include <QSet>
 
 #include <core.h>
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
 #include "core_project.h"
 
+// Note: value equal to the default one shares its data instead of keeping a copy per item.
+// It's lock free unlike a pool of values, since items are also made on worker threads of the builder
+template <class T>
+static inline T sharedDefault(const T &value, const T &defaultValue)
+{
+    return (value == defaultValue) ? defaultValue : value;
+}
+
 mbCoreDataViewItem::Strings::Strings() :
     device            (QStringLiteral("device")),
     address           (QStringLiteral("address")),
@@ -73,7 +84,7 @@ const mbCoreDataViewItem::Defaults &mbCoreDataViewItem::Defaults::instance()
 
 mbCoreDataViewItem::mbCoreDataViewItem(QObject *parent) : QObject(parent)
 {
-    Defaults d = Defaults::instance();
+    const Defaults &d = Defaults::instance();
 
     m_dataView = nullptr;
 
@@ -222,7 +233,7 @@ QString mbCoreDataViewItem::byteArraySeparator() const
 
 void mbCoreDataViewItem::setByteArraySeparator(const QString &byteArraySeparator)
 {
-    m_byteArraySeparator = byteArraySeparator;
+    m_byteArraySeparator = sharedDefault(byteArraySeparator, Defaults::instance().byteArraySeparator);
 }
 
 QString mbCoreDataViewItem::byteArraySeparatorStr() const
@@ -239,7 +250,7 @@ void mbCoreDataViewItem::setByteArraySeparatorStr(const QString &byteArraySepara
     else
     {
         m_isDefaultByteArraySeparator = false;
-        m_byteArraySeparator = mb::resolveEscapeSequnces(byteArraySeparatorStr);
+        setByteArraySeparator(mb::resolveEscapeSequnces(byteArraySeparatorStr));
     }
 }
 
@@ -271,7 +282,12 @@ void mbCoreDataViewItem::setStringEncodingStr(const QString &stringEncodingStr)
     bool ok;
     mb::StringEncoding k = mb::toStringEncoding(stringEncodingStr, &ok);
     if (ok)
-        m_stringEncoding = k;
+        setStringEncoding(k);
+}
+
+void mbCoreDataViewItem::setStringEncoding(const mb::StringEncoding &stringEncoding)
+{
+    m_stringEncoding = sharedDefault(stringEncoding, Defaults::instance().stringEncoding);
 }
 
 MBSETTINGS mbCoreDataViewItem::settings() const
@@ -405,6 +421,70 @@ bool mbCoreDataViewItem::setSettings(const MBSETTINGS &settings)
     return true;
 }
 
+void mbCoreDataViewItem::writeRecord(mbCoreBinaryWriter &writer) const
+{
+    int flags = (m_isDefaultByteArraySeparator ? 0x01 : 0) |
+                (m_isDefaultStringEncoding     ? 0x02 : 0);
+    writer.write(addressInt());
+    writer.write(static_cast<int>(format()));
+    writer.write(comment());
+    writer.write(variableLength());
+    writer.write(static_cast<int>(swapBytes()));
+    writer.write(static_cast<int>(registerOrder()));
+    writer.write(static_cast<int>(byteArrayFormat()));
+    writer.write(static_cast<int>(stringLengthType()));
+    writer.write(flags);
+    writer.write(m_byteArraySeparator);
+    writer.write(m_stringEncoding);
+}
+
+bool mbCoreDataViewItem::readRecord(mbCoreBinaryReader &reader)
+{
+    int address, format, variableLength, swapBytes, registerOrder, byteArrayFormat, stringLengthType, flags;
+    QString comment, byteArraySeparator;
+    QByteArray stringEncoding;
+    if (!(reader.read(address)            &&
+          reader.read(format)             &&
+          reader.read(comment)            &&
+          reader.read(variableLength)     &&
+          reader.read(swapBytes)          &&
+          reader.read(registerOrder)      &&
+          reader.read(byteArrayFormat)    &&
+          reader.read(stringLengthType)   &&
+          reader.read(flags)              &&
+          reader.read(byteArraySeparator) &&
+          reader.read(stringEncoding)))
+        return false;
+
+    bool okFormat, okSwapBytes, okRegisterOrder, okByteArrayFormat, okStringLengthType;
+    mb::Format           vFormat           = mb::enumValueInt<mb::Format          >(format          , &okFormat          );
+    mb::SwapData         vSwapBytes        = mb::enumValueInt<mb::SwapData        >(swapBytes       , &okSwapBytes       );
+    mb::RegisterOrder    vRegisterOrder    = mb::enumValueInt<mb::RegisterOrder   >(registerOrder   , &okRegisterOrder   );
+    mb::DigitalFormat    vByteArrayFormat  = mb::enumValueInt<mb::DigitalFormat   >(byteArrayFormat , &okByteArrayFormat );
+    mb::StringLengthType vStringLengthType = mb::enumValueInt<mb::StringLengthType>(stringLengthType, &okStringLengthType);
+    if (!(okFormat && okSwapBytes && okRegisterOrder && okByteArrayFormat && okStringLengthType))
+        return false;
+
+    blockSignals(true);
+    setAddressInt(address);
+    setComment(comment);
+    setVariableLength(variableLength);
+    setSwapBytes(vSwapBytes);
+    setRegisterOrder(vRegisterOrder);
+    setByteArrayFormat(vByteArrayFormat);
+    m_isDefaultByteArraySeparator = (flags & 0x01) != 0;
+    if (!m_isDefaultByteArraySeparator)
+        setByteArraySeparator(byteArraySeparator);
+    setStringLengthType(vStringLengthType);
+    m_isDefaultStringEncoding = (flags & 0x02) != 0;
+    if (!m_isDefaultStringEncoding)
+        setStringEncoding(stringEncoding);
+    setFormat(vFormat);
+    blockSignals(false);
+    Q_EMIT changed();
+    return true;
+}
+
 QByteArray mbCoreDataViewItem::toByteArray(const QVariant &value) const
 {
     return mb::toByteArray(value,
@@ -763,6 +843,7 @@ int mbCoreDataView::itemInsert(mbCoreDataViewItem *item, int index)
             index = m_items.count();
             m_items.append(item);
         }
+        m_itemIndex.inserted(m_items, index);
         Q_EMIT itemAdded(item);
         connect(item, &mbCoreDataViewItem::changed     , this, &mbCoreDataView::changed);
         connect(item, &mbCoreDataViewItem::valueChanged, this, &mbCoreDataView::changed);
@@ -773,22 +854,74 @@ int mbCoreDataView::itemInsert(mbCoreDataViewItem *item, int index)
 
 void mbCoreDataView::itemsInsert(const QList<mbCoreDataViewItem *> &items, int index)
 {
-    if (index < 0 || index >= itemCount())
+    if (index < 0 || index > itemCount())
+        index = itemCount();
+    // Note: the whole batch is put into the list first, so position index is updated once
+    QList<mbCoreDataViewItem*> added;
+    QSet<mbCoreDataViewItem*> unique;
+    added.reserve(items.count());
+    unique.reserve(items.count());
+    Q_FOREACH (mbCoreDataViewItem *item, items)
     {
-        Q_FOREACH (mbCoreDataViewItem *item, items)
-            itemAdd(item);
+        if (!hasItem(item) && !unique.contains(item))
+        {
+            unique.insert(item);
+            added.append(item);
+        }
     }
-    else
+    if (added.isEmpty())
+        return;
+    QList<mbCoreDataViewItem*> tail = m_items.mid(index);
+    m_items.erase(m_items.begin() + index, m_items.end());
+    m_items.reserve(m_items.count() + added.count() + tail.count());
+    m_items.append(added);
+    m_items.append(tail);
+    m_itemIndex.inserted(m_items, index);
+    Q_FOREACH (mbCoreDataViewItem *item, added)
     {
-        Q_FOREACH (mbCoreDataViewItem *item, items)
-            itemInsert(item, index++);
+        item->setDataViewCore(this);
+        Q_EMIT itemAdded(item);
+        connect(item, &mbCoreDataViewItem::changed     , this, &mbCoreDataView::changed);
+        connect(item, &mbCoreDataViewItem::valueChanged, this, &mbCoreDataView::changed);
     }
 }
 
 void mbCoreDataView::itemsRemove(const QList<mbCoreDataViewItem *> &items)
 {
+    // Note: the whole batch is taken from the list first, so position index is updated once
+    QList<mbCoreDataViewItem*> removed;
+    QSet<mbCoreDataViewItem*> unique;
+    removed.reserve(items.count());
+    unique.reserve(items.count());
+    int first = m_items.count();
     Q_FOREACH (mbCoreDataViewItem *item, items)
-        itemRemove(item);
+    {
+        int i = itemIndex(item);
+        if ((i < 0) || unique.contains(item))
+            continue;
+        item->disconnect(this);
+        Q_EMIT itemRemoving(item);
+        unique.insert(item);
+        removed.append(item);
+        first = qMin(first, i);
+    }
+    if (removed.isEmpty())
+        return;
+    QList<mbCoreDataViewItem*> rest;
+    rest.reserve(m_items.count() - removed.count());
+    for (int i = 0; i < m_items.count(); i++)
+    {
+        mbCoreDataViewItem *item = m_items.at(i);
+        if ((i < first) || !unique.contains(item))
+            rest.append(item);
+    }
+    m_items = rest;
+    m_itemIndex.removed(m_items, removed, first);
+    Q_FOREACH (mbCoreDataViewItem *item, removed)
+    {
+        Q_EMIT itemRemoved(item);
+        item->setDataViewCore(nullptr);
+    }
 }
 
 int mbCoreDataView::itemRemove(int index)
@@ -799,6 +932,7 @@ int mbCoreDataView::itemRemove(int index)
         item->disconnect(this);
         Q_EMIT itemRemoving(item);
         m_items.removeAt(index);
+        m_itemIndex.removed(m_items, item, index);
         Q_EMIT itemRemoved(item);
         item->setDataViewCore(nullptr);
         return index;
@@ -31,6 +31,8 @@
 
 class mbCoreProject;
 class mbCoreDataView;
+class mbCoreBinaryReader;
+class mbCoreBinaryWriter;
 
 class MBTOOLS_EXPORT mbCoreDataViewItem : public QObject
 {
@@ -143,13 +145,18 @@ public:
 
     inline bool isDefaultStringEncoding() const { return m_isDefaultStringEncoding; }
     inline mb::StringEncoding stringEncoding() const { return m_stringEncoding; }
-    inline void setStringEncoding(const mb::StringEncoding &stringEncoding) { m_stringEncoding = stringEncoding; }
+    void setStringEncoding(const mb::StringEncoding &stringEncoding);
     QString stringEncodingStr() const;
     void setStringEncodingStr(const QString& stringEncodingStr);
 
     virtual MBSETTINGS settings() const;
     virtual bool setSettings(const MBSETTINGS &settings);
 
+    // Fixed-layout typed record of the settings used by binary project.
+    // 'readRecord' returns false if record is truncated or contains invalid values
+    virtual void writeRecord(mbCoreBinaryWriter &writer) const;
+    virtual bool readRecord(mbCoreBinaryReader &reader);
+
 public:
     QByteArray toByteArray(const QVariant &v) const;
     QVariant toVariant(const QByteArray &v) const;
@@ -171,18 +178,19 @@ protected:
 protected:
     QPointer<mbCoreDevice> m_device;
     mbCoreDataView *m_dataView;
-    mb::Address m_address;
-    mb::Format m_format;
     QString m_comment;
+    QString m_byteArraySeparator;         // shares data with default value if equal
+    mb::StringEncoding m_stringEncoding;  // shares data with default value if equal
+    mb::Address m_address;
     int m_variableLength;
-    mb::SwapData m_swapBytes;
-    mb::RegisterOrder m_registerOrder;
-    mb::DigitalFormat m_byteArrayFormat;
-    QString m_byteArraySeparator;
-    bool m_isDefaultByteArraySeparator;
-    mb::StringLengthType m_stringLengthType;
-    mb::StringEncoding m_stringEncoding;
-    bool m_isDefaultStringEncoding;
+    // Note: enumerations and flags are packed because large projects contain a lot of items
+    mb::Format           m_format                      : 8;
+    mb::SwapData         m_swapBytes                   : 4;
+    mb::RegisterOrder    m_registerOrder               : 4;
+    mb::DigitalFormat    m_byteArrayFormat             : 4;
+    mb::StringLengthType m_stringLengthType            : 4;
+    bool                 m_isDefaultByteArraySeparator : 1;
+    bool                 m_isDefaultStringEncoding     : 1;
 };
 
 class MBTOOLS_EXPORT mbCoreDataView : public QObject
@@ -268,9 +276,9 @@ public:
     virtual bool setSettings(const MBSETTINGS& settings);
 
 public: // item
-    inline bool hasItem(mbCoreDataViewItem* item) const { return m_items.contains(item); }
+    inline bool hasItem(mbCoreDataViewItem* item) const { return m_itemIndex.contains(item); }
     inline QList<mbCoreDataViewItem*> itemsCore() const { return m_items; }
-    inline int itemIndex(mbCoreDataViewItem* item) const { return m_items.indexOf(item); }
+    inline int itemIndex(mbCoreDataViewItem* item) const { return m_itemIndex.indexOf(item); }
     inline mbCoreDataViewItem* itemCore(int i) const { return m_items.value(i); }
     inline mbCoreDataViewItem* itemCoreAt(int i) const { return m_items.at(i); }
     inline int itemCount() const { return m_items.count(); }
@@ -298,6 +306,7 @@ protected Q_SLOTS:
 protected:
     mbCoreProject* m_project;
     QList<mbCoreDataViewItem*> m_items;
+    mb::PositionIndex<mbCoreDataViewItem*> m_itemIndex;
 
 protected:
     int m_period;
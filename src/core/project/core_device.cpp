@@ -22,6 +22,9 @@
 */
 #include "core_device.h"
 
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
+
 #include "core_project.h"
 
 mbCoreDevice::Strings::Strings() :
@@ -310,32 +313,94 @@ bool mbCoreDevice::setSettings(const MBSETTINGS &settings)
     return true;
 }
 
+void mbCoreDevice::writeRecord(mbCoreBinaryWriter &writer) const
+{
+    writer.write(name());
+    writer.write(maxReadCoils());
+    writer.write(maxReadDiscreteInputs());
+    writer.write(maxReadHoldingRegisters());
+    writer.write(maxReadInputRegisters());
+    writer.write(maxWriteMultipleCoils());
+    writer.write(maxWriteMultipleRegisters());
+    writer.write(static_cast<int>(swapBytes()));
+    writer.write(static_cast<int>(registerOrder()));
+    writer.write(static_cast<int>(byteArrayFormat()));
+    writer.write(byteArraySeparator());
+    writer.write(static_cast<int>(stringLengthType()));
+    writer.write(stringEncoding());
+}
+
+bool mbCoreDevice::readRecord(mbCoreBinaryReader &reader)
+{
+    QString name, byteArraySeparator;
+    int maxReadCoils, maxReadDiscreteInputs, maxReadHoldingRegisters, maxReadInputRegisters, maxWriteMultipleCoils, maxWriteMultipleRegisters;
+    int swapBytes, registerOrder, byteArrayFormat, stringLengthType;
+    QByteArray stringEncoding;
+    if (!(reader.read(name)                      &&
+          reader.read(maxReadCoils)              &&
+          reader.read(maxReadDiscreteInputs)     &&
+          reader.read(maxReadHoldingRegisters)   &&
+          reader.read(maxReadInputRegisters)     &&
+          reader.read(maxWriteMultipleCoils)     &&
+          reader.read(maxWriteMultipleRegisters) &&
+          reader.read(swapBytes)                 &&
+          reader.read(registerOrder)             &&
+          reader.read(byteArrayFormat)           &&
+          reader.read(byteArraySeparator)        &&
+          reader.read(stringLengthType)          &&
+          reader.read(stringEncoding)))
+        return false;
+
+    bool okSwapBytes, okRegisterOrder, okByteArrayFormat, okStringLengthType;
+    mb::SwapData         vSwapBytes        = mb::enumValueInt<mb::SwapData        >(swapBytes       , &okSwapBytes       );
+    mb::RegisterOrder    vRegisterOrder    = mb::enumValueInt<mb::RegisterOrder   >(registerOrder   , &okRegisterOrder   );
+    mb::DigitalFormat    vByteArrayFormat  = mb::enumValueInt<mb::DigitalFormat   >(byteArrayFormat , &okByteArrayFormat );
+    mb::StringLengthType vStringLengthType = mb::enumValueInt<mb::StringLengthType>(stringLengthType, &okStringLengthType);
+    if (!(okSwapBytes && okRegisterOrder && okByteArrayFormat && okStringLengthType))
+        return false;
+
+    setName(name);
+    setMaxReadCoils(static_cast<uint16_t>(maxReadCoils));
+    setMaxReadDiscreteInputs(static_cast<uint16_t>(maxReadDiscreteInputs));
+    setMaxReadHoldingRegisters(static_cast<uint16_t>(maxReadHoldingRegisters));
+    setMaxReadInputRegisters(static_cast<uint16_t>(maxReadInputRegisters));
+    setMaxWriteMultipleCoils(static_cast<uint16_t>(maxWriteMultipleCoils));
+    setMaxWriteMultipleRegisters(static_cast<uint16_t>(maxWriteMultipleRegisters));
+    setSwapBytes(vSwapBytes);
+    setRegisterOrder(vRegisterOrder);
+    setByteArrayFormat(vByteArrayFormat);
+    setByteArraySeparator(byteArraySeparator);
+    setStringLengthType(vStringLengthType);
+    setStringEncoding(stringEncoding);
+    Q_EMIT changed();
+    return true;
+}
+
 void mbCoreDevice::incStatCountTx()
 {
-    m_statLock.lockForWrite();
-    auto v = ++m_stat->countTx;
-    m_statLock.unlock();
-    Q_EMIT statCountTxChanged(v);
+    QWriteLocker locker(&m_statLock);
+    ++m_stat->countTx;
+    m_statRevision.ref();
 }
 
 void mbCoreDevice::incStatCountRx()
 {
-    m_statLock.lockForWrite();
-    auto v = ++m_stat->countRx;
-    m_statLock.unlock();
-    Q_EMIT statCountRxChanged(v);
+    QWriteLocker locker(&m_statLock);
+    ++m_stat->countRx;
+    m_statRevision.ref();
 }
 
 void mbCoreDevice::resetStatistics()
 {
-    m_statLock.lockForWrite();
+    QWriteLocker locker(&m_statLock);
     resetStatisticsInner();
-    m_statLock.unlock();
+    m_statRevision.ref();
 }
 
 void mbCoreDevice::setStatStatus(Modbus::StatusCode status, mb::Timestamp_t timestamp, const QString &err)
 {
     QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
     m_stat->lastStatus = status;
     m_stat->lastTimestamp = timestamp;
     if (Modbus::StatusIsGood(status))
@@ -29,6 +29,8 @@
 #include <mbcore.h>
 
 class mbCoreProject;
+class mbCoreBinaryReader;
+class mbCoreBinaryWriter;
 
 class MBTOOLS_EXPORT mbCoreDevice : public QObject
 {
@@ -134,8 +136,15 @@ public: // settings
     virtual MBSETTINGS settings() const;
     virtual bool setSettings(const MBSETTINGS& settings);
 
+    // Fixed-layout typed record of the settings used by binary project.
+    // 'readRecord' returns false if record is truncated or contains invalid values
+    virtual void writeRecord(mbCoreBinaryWriter &writer) const;
+    virtual bool readRecord(mbCoreBinaryReader &reader);
+
 public: // statistics
     inline CoreStatistics statisticsCore() const { QReadLocker locker(&m_statLock); return *m_stat; }
+    // Note: revision is incremented on every change of statistics, so subscribers can check it without lock
+    inline int statRevision() const { return m_statRevision.load(); }
     inline quint32 statCountTx() const { QReadLocker locker(&m_statLock); return m_stat->countTx; }
     inline quint32 statCountRx() const { QReadLocker locker(&m_statLock); return m_stat->countRx; }
     inline quint32 statCountGood() const { QReadLocker locker(&m_statLock); return m_stat->countGood; }
@@ -166,8 +175,6 @@ protected:
 Q_SIGNALS:
     void nameChanged(const QString& newName);
     void changed();
-    void statCountTxChanged(quint32 count);
-    void statCountRxChanged(quint32 count);
 
 
 protected:
@@ -193,6 +200,7 @@ protected: // settings
 protected: // statistics
     mutable QReadWriteLock m_statLock;
     CoreStatistics *m_stat;
+    QAtomicInt m_statRevision;
 };
 
 #endif // CORE_DEVICE_H
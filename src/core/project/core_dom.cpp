@@ -39,6 +39,208 @@ void mbCoreXmlStreamReader::processUnexpectedElement(const QString &name)
     skipCurrentElement();
 }
 
+QByteArray mbCoreDomBinaryWriter::signature()
+{
+    return QByteArrayLiteral("MBTB");
+}
+
+mbCoreDomBinaryWriter::mbCoreDomBinaryWriter()
+{
+}
+
+QByteArray mbCoreDomBinaryWriter::data() const
+{
+    mbCoreBinaryWriter header;
+    header.write(static_cast<int>(FormatVersion));
+    header.write(m_strings.count());
+    Q_FOREACH (const QString &s, m_strings)
+        header.write(s);
+    return signature() + header.data() + m_body.data();
+}
+
+void mbCoreDomBinaryWriter::writeInt(int v)
+{
+    m_body.write(v);
+}
+
+void mbCoreDomBinaryWriter::writeString(const QString &v)
+{
+    auto it = m_hashStrings.find(v);
+    if (it == m_hashStrings.end())
+    {
+        it = m_hashStrings.insert(v, m_strings.count());
+        m_strings.append(v);
+    }
+    m_body.write(it.value());
+}
+
+void mbCoreDomBinaryWriter::writeStringList(const QStringList &v)
+{
+    m_body.write(v.count());
+    Q_FOREACH (const QString &s, v)
+        writeString(s);
+}
+
+void mbCoreDomBinaryWriter::writeSettings(const MBSETTINGS &v)
+{
+    // Note: values are stored as strings the same way xml does,
+    // so binary and xml projects are converted into each other without loss
+    m_body.write(v.count());
+    for (MBSETTINGS::const_iterator it = v.constBegin(); it != v.constEnd(); ++it)
+    {
+        writeString(it.key());
+        writeString(it.value().toString());
+    }
+}
+
+void mbCoreDomBinaryWriter::writeData(const QByteArray &v)
+{
+    m_body.write(v);
+}
+
+void mbCoreDomBinaryWriter::writeProperties(const MBSETTINGS &settings, const QByteArray &record)
+{
+    if (record.isEmpty())
+    {
+        writeInt(Record_Settings);
+        writeSettings(settings);
+    }
+    else
+    {
+        writeInt(Record_Typed);
+        writeData(record);
+    }
+}
+
+bool mbCoreDomBinaryReader::isBinary(const QByteArray &header)
+{
+    return header.startsWith(mbCoreDomBinaryWriter::signature());
+}
+
+mbCoreDomBinaryReader::mbCoreDomBinaryReader(const QByteArray &data)
+{
+    m_version = 0;
+    if (!isBinary(data))
+    {
+        raiseError(QStringLiteral("Binary project signature is not found"));
+        return;
+    }
+    m_body.setData(data.mid(mbCoreDomBinaryWriter::signature().size()));
+    m_version = readInt();
+    if (hasError())
+        return;
+    if ((m_version < 1) || (m_version > mbCoreDomBinaryWriter::FormatVersion))
+    {
+        raiseError(QString("Unsupported binary project format version %1").arg(m_version));
+        return;
+    }
+    // Note: every string of the table is stored as its size followed by UTF-8 data
+    int count = readCount(sizeof(int));
+    if (hasError())
+        return;
+    for (int i = 0; i < count; i++)
+    {
+        QString s;
+        if (!m_body.read(s))
+        {
+            raiseError(QStringLiteral("Corrupted string table"));
+            return;
+        }
+        m_strings.append(s);
+    }
+}
+
+void mbCoreDomBinaryReader::raiseError(const QString &text)
+{
+    if (m_error.isEmpty())
+        m_error = text;
+}
+
+int mbCoreDomBinaryReader::readInt()
+{
+    int v = 0;
+    if (!hasError() && !m_body.read(v))
+        raiseError(QStringLiteral("Unexpected end of binary project"));
+    return v;
+}
+
+int mbCoreDomBinaryReader::readCount(int minRecordSize)
+{
+    int count = readInt();
+    if (hasError())
+        return 0;
+    if ((count < 0) || (count > m_body.remaining() / minRecordSize))
+    {
+        raiseError(QString("Invalid record count %1").arg(count));
+        return 0;
+    }
+    return count;
+}
+
+QString mbCoreDomBinaryReader::readString()
+{
+    int i = readInt();
+    if (hasError())
+        return QString();
+    if ((i < 0) || (i >= m_strings.count()))
+    {
+        raiseError(QString("String index %1 is out of range").arg(i));
+        return QString();
+    }
+    return m_strings.at(i);
+}
+
+QStringList mbCoreDomBinaryReader::readStringList()
+{
+    QStringList ls;
+    int count = readCount();
+    for (int i = 0; i < count && !hasError(); i++)
+        ls.append(readString());
+    return ls;
+}
+
+MBSETTINGS mbCoreDomBinaryReader::readSettings()
+{
+    MBSETTINGS v;
+    int count = readCount(2 * sizeof(int));
+    for (int i = 0; i < count && !hasError(); i++)
+    {
+        QString key = readString();
+        QString value = readString();
+        v.insert(key, value);
+    }
+    return v;
+}
+
+QByteArray mbCoreDomBinaryReader::readData()
+{
+    QByteArray v;
+    if (!hasError() && !m_body.read(v))
+        raiseError(QStringLiteral("Unexpected end of binary project"));
+    return v;
+}
+
+void mbCoreDomBinaryReader::readProperties(MBSETTINGS &settings, QByteArray &record)
+{
+    settings.clear();
+    record.clear();
+    int kind = mbCoreDomBinaryWriter::Record_Settings;
+    if (m_version > 1)
+        kind = readInt();
+    switch (kind)
+    {
+    case mbCoreDomBinaryWriter::Record_Settings:
+        settings = readSettings();
+        break;
+    case mbCoreDomBinaryWriter::Record_Typed:
+        record = readData();
+        break;
+    default:
+        raiseError(QString("Unknown record kind %1").arg(kind));
+        break;
+    }
+}
+
 mbCoreDom::~mbCoreDom()
 {
 }
@@ -125,6 +327,20 @@ void mbCoreDomDataViewItem::write(mbCoreXmlStreamWriter &writer, const QString &
 
 }
 
+void mbCoreDomDataViewItem::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_device = reader.readString();
+    reader.readProperties(m_settings, m_record);
+    m_text = reader.readString();
+}
+
+void mbCoreDomDataViewItem::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeString(m_device);
+    writer.writeProperties(m_settings, m_record);
+    writer.writeString(m_text);
+}
+
 
 // -----------------------------------------------------------------------------------------------------------------------
 // ------------------------------------------------------ DATA VIEW ------------------------------------------------------
@@ -253,6 +469,38 @@ void mbCoreDomDataView::write(mbCoreXmlStreamWriter &writer, const QString &tagN
     writer.writeEndElement();
 }
 
+void mbCoreDomDataView::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_attr_name         = reader.readString();
+    m_attr_period       = reader.readInt();
+    m_addressNotation   = reader.readString();
+    m_useDefaultColumns = reader.readInt();
+    m_columns           = reader.readStringList();
+    m_enableProcessing  = reader.readInt();
+    int count = reader.readCount();
+    for (int i = 0; i < count && !reader.hasError(); i++)
+    {
+        mbCoreDomDataViewItem *item = newItem();
+        item->readBinary(reader);
+        m_items.append(item);
+    }
+    m_text = reader.readString();
+}
+
+void mbCoreDomDataView::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeString    (m_attr_name        );
+    writer.writeInt       (m_attr_period      );
+    writer.writeString    (m_addressNotation  );
+    writer.writeInt       (m_useDefaultColumns);
+    writer.writeStringList(m_columns          );
+    writer.writeInt       (m_enableProcessing );
+    writer.writeInt(m_items.count());
+    Q_FOREACH (mbCoreDomDataViewItem *v, m_items)
+        v->writeBinary(writer);
+    writer.writeString(m_text);
+}
+
 
 // -----------------------------------------------------------------------------------------------------------------------
 // -------------------------------------------------------- DEVICE -------------------------------------------------------
@@ -335,6 +583,27 @@ void mbCoreDomDevice::write(mbCoreXmlStreamWriter &writer, const QString &tagNam
     writer.writeEndElement();
 }
 
+void mbCoreDomDevice::readBinary(mbCoreDomBinaryReader &reader)
+{
+    if (reader.version() > 1)
+        m_name = reader.readString();
+    MBSETTINGS settings;
+    reader.readProperties(settings, m_record);
+    if (m_record.isEmpty())
+        setSettings(settings);
+    m_text = reader.readString();
+    readBinaryElements(reader);
+}
+
+void mbCoreDomDevice::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    // Note: name is stored separately because typed record is not parsed until device is built
+    writer.writeString(m_name);
+    writer.writeProperties(m_settings, m_record);
+    writer.writeString(m_text);
+    writeBinaryElements(writer);
+}
+
 void mbCoreDomDevice::setSettings(const MBSETTINGS &settings)
 {
     auto it = settings.find(mbCoreDevice::Strings::instance().name);
@@ -361,6 +630,14 @@ void mbCoreDomDevice::writeElements(mbCoreXmlStreamWriter &/*writer*/) const
 {
 }
 
+void mbCoreDomDevice::readBinaryElements(mbCoreDomBinaryReader &/*reader*/)
+{
+}
+
+void mbCoreDomDevice::writeBinaryElements(mbCoreDomBinaryWriter &/*writer*/) const
+{
+}
+
 
 // -----------------------------------------------------------------------------------------------------------------------
 // --------------------------------------------------------- PORT --------------------------------------------------------
@@ -442,6 +719,20 @@ void mbCoreDomPort::write(mbCoreXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void mbCoreDomPort::readBinary(mbCoreDomBinaryReader &reader)
+{
+    setSettings(reader.readSettings());
+    m_text = reader.readString();
+    readBinaryElements(reader);
+}
+
+void mbCoreDomPort::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeSettings(m_settings);
+    writer.writeString(m_text);
+    writeBinaryElements(writer);
+}
+
 void mbCoreDomPort::setSettings(const MBSETTINGS &settings)
 {
     auto it = settings.find(mbCorePort::Strings::instance().name);
@@ -468,6 +759,14 @@ void mbCoreDomPort::writeElements(mbCoreXmlStreamWriter &/*writer*/) const
 {
 }
 
+void mbCoreDomPort::readBinaryElements(mbCoreDomBinaryReader &/*reader*/)
+{
+}
+
+void mbCoreDomPort::writeBinaryElements(mbCoreDomBinaryWriter &/*writer*/) const
+{
+}
+
 
 // -----------------------------------------------------------------------------------------------------------------------
 // --------------------------------------------------------- TASK --------------------------------------------------------
@@ -554,6 +853,22 @@ void mbCoreDomTaskInfo::write(mbCoreXmlStreamWriter &writer, const QString &tagN
     writer.writeEndElement();
 }
 
+void mbCoreDomTaskInfo::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_attr_name = reader.readString();
+    m_attr_type = reader.readString();
+    m_settings  = reader.readSettings();
+    m_text      = reader.readString();
+}
+
+void mbCoreDomTaskInfo::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeString  (m_attr_name);
+    writer.writeString  (m_attr_type);
+    writer.writeSettings(m_settings );
+    writer.writeString  (m_text     );
+}
+
 
 // -----------------------------------------------------------------------------------------------------------------------
 // ------------------------------------------------------- PROJECT -------------------------------------------------------
@@ -714,6 +1029,38 @@ void mbCoreDomProject::write(mbCoreXmlStreamWriter &writer, const QString &tagNa
     writer.writeEndElement();
 }
 
+void mbCoreDomProject::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_version.full = static_cast<quint32>(reader.readInt());
+    m_editnum      = reader.readInt();
+    m_name         = reader.readString();
+    m_author       = reader.readString();
+    m_comment      = reader.readString();
+    m_ports    ->readBinary(reader);
+    m_devices  ->readBinary(reader);
+    m_dataViews->readBinary(reader);
+    m_tasks    ->readBinary(reader);
+    m_windowsData  = reader.readData();
+    m_text         = reader.readString();
+    readBinaryElements(reader);
+}
+
+void mbCoreDomProject::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeInt(static_cast<int>(m_version.full));
+    writer.writeInt(m_editnum);
+    writer.writeString(m_name);
+    writer.writeString(m_author);
+    writer.writeString(m_comment);
+    m_ports    ->writeBinary(writer);
+    m_devices  ->writeBinary(writer);
+    m_dataViews->writeBinary(writer);
+    m_tasks    ->writeBinary(writer);
+    writer.writeData(m_windowsData);
+    writer.writeString(m_text);
+    writeBinaryElements(writer);
+}
+
 QString mbCoreDomProject::versionStr() const
 {
     return QString("%1.%2.%3").arg(versionMajor()).arg(versionMinor()).arg(versionPatch());
@@ -764,3 +1111,11 @@ bool mbCoreDomProject::readElement(mbCoreXmlStreamReader &/*reader*/, const QStr
 void mbCoreDomProject::writeElements(mbCoreXmlStreamWriter &/*writer*/) const
 {
 }
+
+void mbCoreDomProject::readBinaryElements(mbCoreDomBinaryReader &/*reader*/)
+{
+}
+
+void mbCoreDomProject::writeBinaryElements(mbCoreDomBinaryWriter &/*writer*/) const
+{
+}
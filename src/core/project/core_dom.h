@@ -30,6 +30,8 @@
 
 #include <Modbus.h>
 #include <mbcore.h>
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
 
 // Note: tagName values are supposed to be lowercase
 
@@ -53,6 +55,84 @@ public:
     using QXmlStreamWriter::QXmlStreamWriter;
 };
 
+/*
+    Binary project layout:
+    signature := 4 bytes 'MBTB'
+    version   := int32 format version
+    strings   := int32 count + count * (int32 size + UTF-8 bytes)
+    body      := root dom record, every string is int32 index within 'strings'
+
+    Settings of devices and data view items are stored as 'properties' (since version 2):
+    properties := int32 kind + (Record_Settings: settings map | Record_Typed: int32 size + record)
+    where record is fixed-layout typed fields written by 'writeRecord' of corresponding object.
+    Version 1 has no kind and always contains settings map.
+*/
+class MBTOOLS_EXPORT mbCoreDomBinaryWriter
+{
+public:
+    enum { FormatVersion = 2 };
+    enum RecordKind
+    {
+        Record_Settings,
+        Record_Typed
+    };
+    static QByteArray signature();
+
+public:
+    mbCoreDomBinaryWriter();
+
+public:
+    QByteArray data() const;
+
+public:
+    void writeInt(int v);
+    void writeString(const QString &v);
+    void writeStringList(const QStringList &v);
+    void writeSettings(const MBSETTINGS &v);
+    void writeData(const QByteArray &v);
+    // Writes typed 'record' if it's not empty, 'settings' otherwise
+    void writeProperties(const MBSETTINGS &settings, const QByteArray &record);
+
+private:
+    mbCoreBinaryWriter m_body;
+    QHash<QString, int> m_hashStrings;
+    QStringList m_strings;
+};
+
+class MBTOOLS_EXPORT mbCoreDomBinaryReader
+{
+public:
+    static bool isBinary(const QByteArray &header);
+
+public:
+    mbCoreDomBinaryReader(const QByteArray &data);
+
+public:
+    inline bool hasError() const { return !m_error.isEmpty(); }
+    inline QString errorString() const { return m_error; }
+    void raiseError(const QString &text);
+    inline bool atEnd() const { return m_body.isEnd(); }
+    inline int version() const { return m_version; }
+
+public:
+    int readInt();
+    // Reads count of the following records, each of them takes at least 'minRecordSize' bytes.
+    // Count that can't fit into the rest of data is a parse error and 0 is returned
+    int readCount(int minRecordSize = sizeof(int));
+    QString readString();
+    QStringList readStringList();
+    MBSETTINGS readSettings();
+    QByteArray readData();
+    // Reads either 'settings' or typed 'record', the other one is cleared
+    void readProperties(MBSETTINGS &settings, QByteArray &record);
+
+private:
+    mbCoreBinaryReader m_body;
+    int m_version;
+    QVector<QString> m_strings;
+    QString m_error;
+};
+
 class MBTOOLS_EXPORT mbCoreDom
 {
 public:
@@ -62,6 +142,8 @@ public:
     virtual QString tagName() const = 0;
     virtual void read(mbCoreXmlStreamReader &reader) = 0;
     virtual void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const = 0;
+    virtual void readBinary(mbCoreDomBinaryReader &reader) = 0;
+    virtual void writeBinary(mbCoreDomBinaryWriter &writer) const = 0;
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
 
@@ -132,6 +214,24 @@ public:
 
         writer.writeEndElement();
     }
+    void readBinary(mbCoreDomBinaryReader &reader) override
+    {
+        int count = reader.readCount();
+        for (int i = 0; i < count && !reader.hasError(); i++)
+        {
+            T *item = newItem();
+            item->readBinary(reader);
+            m_items.append(item);
+        }
+        m_text = reader.readString();
+    }
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override
+    {
+        writer.writeInt(m_items.count());
+        Q_FOREACH (T *v, m_items)
+            v->writeBinary(writer);
+        writer.writeString(m_text);
+    }
 
     inline QList<T*> items() const { return m_items; };
     inline void setItems(const QList<T*> &items) { m_items = items; }
@@ -174,6 +274,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
 
@@ -185,10 +287,15 @@ public:
     inline MBSETTINGS settings() const { return m_settings; }
     inline void setSettings(const MBSETTINGS& settings) { m_settings = settings; }
 
+    // typed record of binary project, see 'mbCoreDataViewItem::writeRecord'
+    inline QByteArray record() const { return m_record; }
+    inline void setRecord(const QByteArray &record) { m_record = record; }
+
 private:
     // attributes
     QString m_device;
     MBSETTINGS m_settings;
+    QByteArray m_record;
 };
 
 class MBTOOLS_EXPORT mbCoreDomDataView : public mbCoreDom
@@ -216,6 +323,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     inline QString name() const { return m_attr_name; }
     inline void setName(const QString & v) { m_attr_name = v; }
@@ -275,22 +384,32 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // elements
     QString name() const { return m_name; }
+    inline void setName(const QString &name) { m_name = name; }
     inline MBSETTINGS settings() const { return m_settings; }
     void setSettings(const MBSETTINGS &settings);
 
+    // typed record of binary project, see 'mbCoreDevice::writeRecord'
+    inline QByteArray record() const { return m_record; }
+    inline void setRecord(const QByteArray &record) { m_record = record; }
+
 protected:
     virtual bool readAttribute(mbCoreXmlStreamReader &reader, const QXmlStreamAttribute &attribute);
     virtual void writeAttributes(mbCoreXmlStreamWriter &writer) const;
     virtual bool readElement(mbCoreXmlStreamReader &reader, const QString &tag);
     virtual void writeElements(mbCoreXmlStreamWriter &writer) const;
+    virtual void readBinaryElements(mbCoreDomBinaryReader &reader);
+    virtual void writeBinaryElements(mbCoreDomBinaryWriter &writer) const;
 
 protected:
     // elements
     QString m_name;
     MBSETTINGS m_settings;
+    QByteArray m_record;
 
 private:
     mbCoreDomDevice(const mbCoreDomDevice& other);
@@ -320,6 +439,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // settings
     QString name() const { return m_name; }
@@ -331,6 +452,8 @@ protected:
     virtual void writeAttributes(mbCoreXmlStreamWriter &writer) const;
     virtual bool readElement(mbCoreXmlStreamReader &reader, const QString &tag);
     virtual void writeElements(mbCoreXmlStreamWriter &writer) const;
+    virtual void readBinaryElements(mbCoreDomBinaryReader &reader);
+    virtual void writeBinaryElements(mbCoreDomBinaryWriter &writer) const;
 
 protected:
     // settings
@@ -367,6 +490,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // attributes
     inline QString name() const { return m_attr_name; }
@@ -445,6 +570,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // attributes
     inline quint32 version() const { return m_version.full; }
@@ -488,6 +615,8 @@ protected:
     virtual void writeAttributes(mbCoreXmlStreamWriter &writer) const;
     virtual bool readElement(mbCoreXmlStreamReader &reader, const QString &tag);
     virtual void writeElements(mbCoreXmlStreamWriter &writer) const;
+    virtual void readBinaryElements(mbCoreDomBinaryReader &reader);
+    virtual void writeBinaryElements(mbCoreDomBinaryWriter &writer) const;
 
 protected:
     // attributes
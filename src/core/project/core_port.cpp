@@ -289,40 +289,29 @@ bool mbCorePort::setSettings(const MBSETTINGS &settings)
 
 void mbCorePort::resetStatistics()
 {
-    m_statLock.lockForWrite();
-    const auto countTxOld = m_stat->countTx;
-    const auto countRxOld = m_stat->countRx;
+    QWriteLocker locker(&m_statLock);
     resetStatisticsInner();
-    const auto countTxNew = m_stat->countTx;
-    const auto countRxNew = m_stat->countRx;
-    m_statLock.unlock();
-
-    if (countTxOld != countTxNew)
-        Q_EMIT statCountTxChanged(countTxNew);
-    if (countRxOld != countRxNew)
-        Q_EMIT statCountRxChanged(countRxNew);
-
+    m_statRevision.ref();
 }
 
 void mbCorePort::incStatCountTx()
 {
-    m_statLock.lockForWrite();
-    auto v = ++m_stat->countTx;
-    m_statLock.unlock();
-    Q_EMIT statCountTxChanged(v);
+    QWriteLocker locker(&m_statLock);
+    ++m_stat->countTx;
+    m_statRevision.ref();
 }
 
 void mbCorePort::incStatCountRx()
 {
-    m_statLock.lockForWrite();
-    auto v = ++m_stat->countRx;
-    m_statLock.unlock();
-    Q_EMIT statCountRxChanged(v);
+    QWriteLocker locker(&m_statLock);
+    ++m_stat->countRx;
+    m_statRevision.ref();
 }
 
 void mbCorePort::setStatCycleTime(quint64 time)
 {
     QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
     m_stat->cycleCount++;
     m_stat->cycleSumDuration += time;
     m_stat->cycleAvgDuration = static_cast<uint32_t>(m_stat->cycleSumDuration / m_stat->cycleCount);
@@ -338,6 +327,7 @@ void mbCorePort::setStatCycleTime(quint64 time)
 void mbCorePort::setStatStatus(Modbus::StatusCode status, mb::Timestamp_t timestamp, const QString &err)
 {
     QWriteLocker locker(&m_statLock);
+    m_statRevision.ref();
     m_stat->lastStatus = status;
     m_stat->lastTimestamp = timestamp;
     if (Modbus::StatusIsGood(status))
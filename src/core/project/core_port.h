@@ -123,6 +123,8 @@ public: // settings
 
 public: // statistics
     inline CoreStatistics statisticsCore() const { QReadLocker locker(&m_statLock); return *m_stat; }
+    // Note: revision is incremented on every change of statistics, so subscribers can check it without lock
+    inline int statRevision() const { return m_statRevision.load(); }
     virtual void resetStatistics();
 
     inline quint32 statCountTx() const { QReadLocker locker(&m_statLock); return m_stat->countTx; }
@@ -147,8 +149,6 @@ protected:
 Q_SIGNALS:
     void nameChanged(const QString& newName);
     void changed();
-    void statCountTxChanged(quint32 count);
-    void statCountRxChanged(quint32 count);
 
 protected:
     mbCoreProject* m_project;
@@ -176,6 +176,7 @@ protected:
 protected: // statistics
     mutable QReadWriteLock m_statLock;
     CoreStatistics *m_stat;
+    QAtomicInt m_statRevision;
 };
 
 #endif // CORE_PORT_H
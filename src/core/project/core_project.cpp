@@ -150,6 +150,7 @@ int mbCoreProject::portInsert(mbCorePort *port, int index)
             index = m_ports.count();
             m_ports.append(port);
         }
+        m_indexPorts.inserted(m_ports, index);
         m_hashPorts.insert(port->name(), port);
         port->setProjectCore(this);
         Q_EMIT portAdded(port);
@@ -166,6 +167,7 @@ int mbCoreProject::portRemove(int index)
         Q_EMIT portRemoving(d);
         m_hashPorts.remove(d->name());
         m_ports.removeAt(index);
+        m_indexPorts.removed(m_ports, d, index);
         d->setProjectCore(nullptr);
         Q_EMIT portRemoved(d);
         return index;
@@ -218,6 +220,7 @@ int mbCoreProject::deviceInsert(mbCoreDevice *device, int index)
             index = m_devices.count();
             m_devices.append(device);
         }
+        m_indexDevices.inserted(m_devices, index);
         m_hashDevices.insert(device->name(), device);
         device->setProjectCore(this);
         Q_EMIT deviceAdded(device);
@@ -234,6 +237,7 @@ int mbCoreProject::deviceRemove(int index)
         Q_EMIT deviceRemoving(d);
         m_hashDevices.remove(d->name());
         m_devices.removeAt(index);
+        m_indexDevices.removed(m_devices, d, index);
         d->setProjectCore(nullptr);
         Q_EMIT deviceRemoved(d);
         return index;
@@ -286,6 +290,7 @@ int mbCoreProject::dataViewInsert(mbCoreDataView *dataView, int index)
             index = m_dataViews.count();
             m_dataViews.append(dataView);
         }
+        m_indexDataViews.inserted(m_dataViews, index);
         m_hashDataViews.insert(dataView->name(), dataView);
         dataView->setProjectCore(this);
         Q_EMIT dataViewAdded(dataView);
@@ -302,6 +307,7 @@ int mbCoreProject::dataViewRemove(int index)
         Q_EMIT dataViewRemoving(dataView);
         m_hashDataViews.remove(dataView->name());
         m_dataViews.removeAt(index);
+        m_indexDataViews.removed(m_dataViews, dataView, index);
         dataView->setProjectCore(nullptr);
         Q_EMIT dataViewRemoved(dataView);
         return index;
@@ -90,9 +90,9 @@ public: // settings
 public: // ports
     QString freePortName(const QString& s = QString()) const;
     inline bool hasPort(const QString& name) const { return m_hashPorts.contains(name); }
-    inline bool hasPort(mbCorePort* port) const { return m_ports.contains(port); }
+    inline bool hasPort(mbCorePort* port) const { return m_indexPorts.contains(port); }
     inline QList<mbCorePort*> portsCore() const { return m_ports; }
-    inline int portIndex(mbCorePort* port) const { return m_ports.indexOf(port); }
+    inline int portIndex(mbCorePort* port) const { return m_indexPorts.indexOf(port); }
     inline int portIndex(const QString& name) const { return portIndex(portCore(name)); }
     inline mbCorePort* portCore(int i) const { return m_ports.value(i); }
     inline mbCorePort* portCore(const QString& name) const { return m_hashPorts.value(name, nullptr); }
@@ -108,9 +108,9 @@ public: // ports
 public: // devices
     QString freeDeviceName(const QString& s = QString()) const;
     inline bool hasDevice(const QString& name) const { return m_hashDevices.contains(name); }
-    inline bool hasDevice(mbCoreDevice* device) const { return m_devices.contains(device); }
+    inline bool hasDevice(mbCoreDevice* device) const { return m_indexDevices.contains(device); }
     inline QList<mbCoreDevice*> devicesCore() const { return m_devices; }
-    inline int deviceIndex(mbCoreDevice* device) const { return m_devices.indexOf(device); }
+    inline int deviceIndex(mbCoreDevice* device) const { return m_indexDevices.indexOf(device); }
     inline int deviceIndex(const QString& name) const { return deviceIndex(deviceCore(name)); }
     inline mbCoreDevice* deviceCore(int i) const { return m_devices.value(i); }
     inline mbCoreDevice* deviceCore(const QString& name) const { return m_hashDevices.value(name, nullptr); }
@@ -126,9 +126,9 @@ public: // devices
 public: // watch lists
     QString freeDataViewName(const QString &s = QString()) const;
     inline bool hasDataView(const QString &name) const { return m_hashDataViews.contains(name); }
-    inline bool hasDataView(mbCoreDataView *dataView) const { return m_dataViews.contains(dataView); }
+    inline bool hasDataView(mbCoreDataView *dataView) const { return m_indexDataViews.contains(dataView); }
     inline QList<mbCoreDataView*> dataViewsCore() const { return m_dataViews; }
-    inline int dataViewIndex(mbCoreDataView *dataView) const { return m_dataViews.indexOf(dataView); }
+    inline int dataViewIndex(mbCoreDataView *dataView) const { return m_indexDataViews.indexOf(dataView); }
     inline int dataViewIndex(const QString &name) const { return dataViewIndex(dataViewCore(name)); }
     inline mbCoreDataView *dataViewCore(int i) const { return m_dataViews.value(i); }
     inline mbCoreDataView *dataViewCore(const QString &name) const { return m_hashDataViews.value(name, nullptr); }
@@ -215,18 +215,21 @@ protected:
     typedef QHash<QString, mbCorePort*> HashPorts_t;
     Ports_t m_ports;
     HashPorts_t m_hashPorts;
+    mb::PositionIndex<mbCorePort*> m_indexPorts;
 
 protected: // devices
     typedef QList<mbCoreDevice*> Devices_t;
     typedef QHash<QString, mbCoreDevice*> HashDevices_t;
     Devices_t m_devices;
     HashDevices_t m_hashDevices;
+    mb::PositionIndex<mbCoreDevice*> m_indexDevices;
 
 protected: // dataviews
     typedef QList<mbCoreDataView*> DataViews_t;
     typedef QHash<QString, mbCoreDataView*> HashDataViews_t;
     DataViews_t m_dataViews;
     HashDataViews_t m_hashDataViews;
+    mb::PositionIndex<mbCoreDataView*> m_indexDataViews;
 
 protected:
     typedef QVector<mbCoreTaskInfo*> Tasks_t;
@@ -6,6 +6,7 @@ HEADERS += \
     $$PWD/core_taskinfo.h   \
     $$PWD/core_dom.h        \
     $$PWD/core_builder.h    \
+    $$PWD/core_csv.h        \
 
 SOURCES += \
     $$PWD/core_project.cpp  \
@@ -15,3 +16,4 @@ SOURCES += \
     $$PWD/core_taskinfo.cpp \
     $$PWD/core_dom.cpp      \
     $$PWD/core_builder.cpp  \
+    $$PWD/core_csv.cpp      \
@@ -293,6 +293,15 @@ inline EnumType enumValue(const QVariant& value)
     return enumValue<EnumType>(value, nullptr);
 }
 
+// Convert integer value (e.g. stored in binary project) to enumeration, 'ok' is false if value doesn't exist
+template <class EnumType>
+inline EnumType enumValueInt(int value, bool *ok)
+{
+    const QMetaEnum me = metaEnum<EnumType>();
+    *ok = (me.valueToKey(value) != nullptr);
+    return static_cast<EnumType>(value);
+}
+
 #define MB_ENUM_DECL_EXPORT(type)                                           \
 MBTOOLS_EXPORT int enum##type##KeyCount();                                       \
 MBTOOLS_EXPORT QStringList enum##type##KeyList();                                \
@@ -722,6 +731,31 @@ MBTOOLS_EXPORT QString currentUser();
 
 inline void msleep(uint32_t msec) { Modbus::msleep(msec); }
 
+// Hash index of the positions of list elements, so position of element is found in constant time.
+// Index is updated by the mutators ('inserted', 'removed', 'rebuild') right after the list is changed:
+// positions of the elements starting from 'index' are rewritten, so appending and removing the last element
+// are constant time. Batch changes must be made to the list first and then reported with a single call
+// to keep the cost linear. Lookup doesn't modify the index, so concurrent lookups are as safe as for 'QList::indexOf'.
+template<class T>
+class PositionIndex
+{
+public:
+    inline int indexOf(const T &v) const { return m_hash.value(v, -1); }
+    inline bool contains(const T &v) const { return m_hash.contains(v); }
+    // Note: one or more elements were inserted into 'list' starting from 'index'
+    void inserted(const QList<T> &list, int index) { update(list, index); }
+    void removed(const QList<T> &list, const T &v, int index) { m_hash.remove(v); update(list, index); }
+    // Note: 'values' were removed from 'list', 'index' is the position of the first removed one
+    void removed(const QList<T> &list, const QList<T> &values, int index) { for (const T &v : values) m_hash.remove(v); update(list, index); }
+    void rebuild(const QList<T> &list) { m_hash.clear(); m_hash.reserve(list.count()); update(list, 0); }
+
+private:
+    inline void update(const QList<T> &list, int from) { for (int i = from; i < list.count(); i++) m_hash.insert(list.at(i), i); }
+
+private:
+    QHash<T, int> m_hash;
+};
+
 } // namespace mb
 
 #endif // MBCORE_H
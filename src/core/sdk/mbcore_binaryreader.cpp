@@ -41,7 +41,7 @@ bool mbCoreBinaryReader::read(QRect &v)
 bool mbCoreBinaryReader::read(QByteArray &v)
 {
     int sz;
-    if (read(sz) && ((sz + m_i) <= m_data.size()))
+    if (read(sz) && (sz >= 0) && (sz <= remaining()))
     {
         v = m_data.mid(m_i, sz);
         m_i += sz;
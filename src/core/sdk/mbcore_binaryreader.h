@@ -5,7 +5,9 @@
 #include <QByteArray>
 #include <QString>
 
-class mbCoreBinaryReader
+#include "mbcore.h"
+
+class MBTOOLS_EXPORT mbCoreBinaryReader
 {
 public:
     mbCoreBinaryReader();
@@ -16,6 +18,7 @@ public:
     void setData(const QByteArray &v);
     inline bool isProcessing() const { return m_i < m_data.size(); }
     inline bool isEnd() const { return m_i >= m_data.size(); }
+    inline int remaining() const { return m_data.size() - m_i; }
     inline void reset() { m_i = 0; }
 
 public:
@@ -5,7 +5,9 @@
 #include <QByteArray>
 #include <QString>
 
-class mbCoreBinaryWriter
+#include "mbcore.h"
+
+class MBTOOLS_EXPORT mbCoreBinaryWriter
 {
 public:
     mbCoreBinaryWriter();
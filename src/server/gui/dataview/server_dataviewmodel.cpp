@@ -36,9 +36,47 @@ mbServerDataViewModel::~mbServerDataViewModel()
 {
 }
 
-void mbServerDataViewModel::refreshValues()
+void mbServerDataViewModel::refreshValues(int firstRow, int lastRow)
 {
     int Column_Value = dataView()->getColumnIndexByType(mbServerDataView::Value);
-    if (Column_Value >= 0)
-        Q_EMIT dataChanged(createIndex(0, Column_Value), createIndex(rowCount()-1, Column_Value));
+    if (Column_Value < 0)
+        return;
+    if (firstRow < 0)
+        firstRow = 0;
+    if ((lastRow < 0) || (lastRow >= rowCount()))
+        lastRow = rowCount()-1;
+    // Note: only rows of the given (visible) range with changed memory are updated,
+    //       other rows read actual values from device when they become visible
+    QHash<mbServerDevice*, Counters> counters;
+    for (int r = firstRow; r <= lastRow; r++)
+    {
+        mbServerDataViewItem *item = dataView()->itemAt(r);
+        mbServerDevice *device = item->device();
+        if (!device)
+            continue;
+        int mem = mb::memoryTypeIndex(item->addressType());
+        if (mem < 0)
+            continue;
+        auto it = counters.find(device);
+        if (it == counters.end())
+        {
+            Counters c;
+            c.memory[0] = device->changeCounter(Modbus::Memory_0x);
+            c.memory[1] = device->changeCounter(Modbus::Memory_1x);
+            c.memory[2] = device->changeCounter(Modbus::Memory_3x);
+            c.memory[3] = device->changeCounter(Modbus::Memory_4x);
+            it = counters.insert(device, c);
+        }
+        auto itPrev = m_counters.find(device);
+        if (itPrev != m_counters.end())
+        {
+            uint prev = itPrev.value().memory[mem];
+            if ((prev == it.value().memory[mem]) ||
+                !device->isChangedSince(prev, item->address(), static_cast<quint16>(item->count())))
+                continue;
+        }
+        QModelIndex index = createIndex(r, Column_Value);
+        Q_EMIT dataChanged(index, index);
+    }
+    m_counters = counters;
 }
@@ -25,6 +25,7 @@
 
 #include <core/gui/dataview/core_dataviewmodel.h>
 
+class mbServerDevice;
 class mbServerDataView;
 class mbServerDataViewItem;
 
@@ -40,7 +41,15 @@ public:
     inline mbServerDataViewItem *item(const QModelIndex &index) const { return reinterpret_cast<mbServerDataViewItem*>(itemCore(index)); }
 
 public:
-    void refreshValues();
+    void refreshValues(int firstRow = 0, int lastRow = -1);
+
+private:
+    // Note: change counters of device memory blocks at the moment of the last refresh
+    struct Counters
+    {
+        uint memory[4];
+    };
+    QHash<mbServerDevice*, Counters> m_counters;
 };
 
 #endif // SERVER_DATAVIEWMODEL_H
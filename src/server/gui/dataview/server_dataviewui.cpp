@@ -23,6 +23,7 @@
 #include "server_dataviewui.h"
 
 #include <QTimerEvent>
+#include <QTableView>
 
 #include <project/server_project.h>
 #include <project/server_device.h>
@@ -69,7 +70,7 @@ bool mbServerDataViewUi::event(QEvent *event)
     }
     else if (event->type() == QEvent::Timer)
     {
-        model()->refreshValues();
+        refreshValues();
     }
     return QWidget::event(event);
 }
@@ -91,6 +92,19 @@ void mbServerDataViewUi::stopScanning()
     }
 }
 
+void mbServerDataViewUi::refreshValues()
+{
+    // Note: small margin of rows around the viewport is also refreshed for smooth scrolling
+    const int margin = 8;
+    int first = m_view->rowAt(0);
+    if (first < 0) // no visible rows
+        return;
+    int last = m_view->rowAt(m_view->viewport()->height()-1);
+    if (last >= 0)
+        last += margin;
+    model()->refreshValues(first - margin, last);
+}
+
 QList<mbServerDataViewItem *> mbServerDataViewUi::selectedItems() const
 {
     QList<mbCoreDataViewItem*> ls = selectedItemsCore();
@@ -55,6 +55,7 @@ private:
 private:
     void startScanning(int period);
     void stopScanning();
+    void refreshValues();
 
 private:
     int m_timerId;
@@ -211,13 +211,22 @@ void mbServerDeviceUi::refreshData()
 {
     QWidget *tab = ui->tabWidget->currentWidget();
     if (tab == ui->tab_0x)
-        m_model_0x->refresh();
+        refreshVisible(ui->tableView_0x, m_model_0x);
     else if (tab == ui->tab_1x)
-        m_model_1x->refresh();
+        refreshVisible(ui->tableView_1x, m_model_1x);
     else if (tab == ui->tab_3x)
-        m_model_3x->refresh();
+        refreshVisible(ui->tableView_3x, m_model_3x);
     else if (tab == ui->tab_4x)
-        m_model_4x->refresh();
+        refreshVisible(ui->tableView_4x, m_model_4x);
+}
+
+void mbServerDeviceUi::refreshVisible(QTableView *view, mbServerDeviceUiModel *model)
+{
+    int first = view->rowAt(0);
+    if (first < 0) // no visible rows
+        return;
+    int last = view->rowAt(view->viewport()->height()-1); // -1 means all rows till the end are visible
+    model->refresh(first, last);
 }
 
 
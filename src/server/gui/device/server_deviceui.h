@@ -31,7 +31,9 @@ namespace Ui {
 class mbServerDeviceUi;
 }
 
+class QTableView;
 class mbServerDevice;
+class mbServerDeviceUiModel;
 class mbServerDeviceUiModel_0x;
 class mbServerDeviceUiModel_1x;
 class mbServerDeviceUiModel_3x;
@@ -72,6 +74,7 @@ private:
     void startScanning(int period);
     void stopScanning();
     void refreshData();
+    void refreshVisible(QTableView *view, mbServerDeviceUiModel *model);
 
 private:
     Ui::mbServerDeviceUi *ui;
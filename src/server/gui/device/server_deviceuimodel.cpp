@@ -60,9 +60,34 @@ mbServerDeviceUiModel::mbServerDeviceUiModel(mbServerDevice *device, QObject *pa
     m_format = mb::DefaultDigitalFormat;
 }
 
-void mbServerDeviceUiModel::refresh()
+void mbServerDeviceUiModel::refresh(int firstRow, int lastRow)
 {
-    Q_EMIT dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
+    uint c = changeCounter();
+    if (m_changeCounter == c)
+        return;
+    if (firstRow < 0)
+        firstRow = 0;
+    if ((lastRow < 0) || (lastRow >= rowCount()))
+        lastRow = rowCount()-1;
+    // Note: only changed rows of the given (visible) range are updated,
+    //       other rows are repainted with actual values when they become visible
+    int begin = -1;
+    for (int r = firstRow; r <= lastRow; r++)
+    {
+        if (isChangedSince(m_changeCounter, r*ColumnCount, ColumnCount))
+        {
+            if (begin < 0)
+                begin = r;
+        }
+        else if (begin >= 0)
+        {
+            Q_EMIT dataChanged(index(begin, 0), index(r-1, columnCount()-1));
+            begin = -1;
+        }
+    }
+    if (begin >= 0)
+        Q_EMIT dataChanged(index(begin, 0), index(lastRow, columnCount()-1));
+    m_changeCounter = c;
 }
 
 QVariant mbServerDeviceUiModel::headerData(int section, Qt::Orientation orientation, int role) const
@@ -106,6 +131,16 @@ int mbServerDeviceUiModel::rowCount(const QModelIndex &/*parent*/) const
     return m_rowCount;
 }
 
+uint mbServerDeviceUiModel::changeCounter() const
+{
+    return m_changeCounter;
+}
+
+bool mbServerDeviceUiModel::isChangedSince(uint /*changeCounter*/, int /*offset*/, int /*count*/) const
+{
+    return true;
+}
+
 void mbServerDeviceUiModel::setRowCount(int count)
 {
     beginResetModel();
@@ -180,14 +215,14 @@ Qt::ItemFlags mbServerDeviceUiModel_0x::flags(const QModelIndex &index) const
     return QAbstractTableModel::flags(index);
 }
 
-void mbServerDeviceUiModel_0x::refresh()
+uint mbServerDeviceUiModel_0x::changeCounter() const
 {
-    uint c = m_device->changeCounter_0x();
-    if (m_changeCounter != c)
-    {
-        Q_EMIT dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
-        m_changeCounter = c;
-    }
+    return m_device->changeCounter_0x();
+}
+
+bool mbServerDeviceUiModel_0x::isChangedSince(uint changeCounter, int offset, int count) const
+{
+    return m_device->isChangedSince_0x(changeCounter, static_cast<uint>(offset), static_cast<uint>(count));
 }
 
 mbServerDeviceUiModel_1x::mbServerDeviceUiModel_1x(mbServerDevice *device, QObject *parent) :
@@ -248,14 +283,14 @@ Qt::ItemFlags mbServerDeviceUiModel_1x::flags(const QModelIndex &index) const
     return QAbstractTableModel::flags(index);
 }
 
-void mbServerDeviceUiModel_1x::refresh()
+uint mbServerDeviceUiModel_1x::changeCounter() const
 {
-    uint c = m_device->changeCounter_1x();
-    if (m_changeCounter != c)
-    {
-        Q_EMIT dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
-        m_changeCounter = c;
-    }
+    return m_device->changeCounter_1x();
+}
+
+bool mbServerDeviceUiModel_1x::isChangedSince(uint changeCounter, int offset, int count) const
+{
+    return m_device->isChangedSince_1x(changeCounter, static_cast<uint>(offset), static_cast<uint>(count));
 }
 
 mbServerDeviceUiModel_3x::mbServerDeviceUiModel_3x(mbServerDevice *device, QObject *parent) :
@@ -347,14 +382,14 @@ Qt::ItemFlags mbServerDeviceUiModel_3x::flags(const QModelIndex &index) const
     return QAbstractTableModel::flags(index);
 }
 
-void mbServerDeviceUiModel_3x::refresh()
+uint mbServerDeviceUiModel_3x::changeCounter() const
 {
-    uint c = m_device->changeCounter_3x();
-    if (m_changeCounter != c)
-    {
-        Q_EMIT dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
-        m_changeCounter = c;
-    }
+    return m_device->changeCounter_3x();
+}
+
+bool mbServerDeviceUiModel_3x::isChangedSince(uint changeCounter, int offset, int count) const
+{
+    return m_device->isChangedSince_3x(changeCounter, static_cast<uint>(offset), static_cast<uint>(count));
 }
 
 mbServerDeviceUiModel_4x::mbServerDeviceUiModel_4x(mbServerDevice *device, QObject *parent) :
@@ -446,13 +481,13 @@ Qt::ItemFlags mbServerDeviceUiModel_4x::flags(const QModelIndex &index) const
     return QAbstractTableModel::flags(index);
 }
 
-void mbServerDeviceUiModel_4x::refresh()
+uint mbServerDeviceUiModel_4x::changeCounter() const
 {
-    uint c = m_device->changeCounter_4x();
-    if (m_changeCounter != c)
-    {
-        Q_EMIT dataChanged(index(0, 0), index(rowCount()-1, columnCount()-1));
-        m_changeCounter = c;
-    }
+    return m_device->changeCounter_4x();
+}
+
+bool mbServerDeviceUiModel_4x::isChangedSince(uint changeCounter, int offset, int count) const
+{
+    return m_device->isChangedSince_4x(changeCounter, static_cast<uint>(offset), static_cast<uint>(count));
 }
 
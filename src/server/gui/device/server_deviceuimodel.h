@@ -77,7 +77,7 @@ public:
 public:
     inline mbServerDevice* device() const { return m_device; }
     inline mb::DigitalFormat format() const { return m_format; }
-    virtual void refresh();
+    void refresh(int firstRow = 0, int lastRow = -1);
 
 public: // QAbstractItemModel interface
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
@@ -88,6 +88,10 @@ protected Q_SLOTS:
     void setRowCount(int count);
     void setFormat(int format);
 
+protected:
+    virtual uint changeCounter() const;
+    virtual bool isChangedSince(uint changeCounter, int offset, int count) const;
+
 protected:
     QString m_sym;
 
@@ -104,7 +108,10 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
-    void refresh() override;
+
+protected:
+    uint changeCounter() const override;
+    bool isChangedSince(uint changeCounter, int offset, int count) const override;
 };
 
 class mbServerDeviceUiModel_1x : public mbServerDeviceUiModel
@@ -114,7 +121,10 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
-    void refresh() override;
+
+protected:
+    uint changeCounter() const override;
+    bool isChangedSince(uint changeCounter, int offset, int count) const override;
 };
 
 class mbServerDeviceUiModel_3x : public mbServerDeviceUiModel
@@ -124,7 +134,10 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
-    void refresh() override;
+
+protected:
+    uint changeCounter() const override;
+    bool isChangedSince(uint changeCounter, int offset, int count) const override;
 };
 
 class mbServerDeviceUiModel_4x : public mbServerDeviceUiModel
@@ -134,7 +147,10 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
-    void refresh() override;
+
+protected:
+    uint changeCounter() const override;
+    bool isChangedSince(uint changeCounter, int offset, int count) const override;
 };
 
 
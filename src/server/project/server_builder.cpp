@@ -22,13 +22,18 @@
 */
 #include "server_builder.h"
 
+#include <ctype.h>
+
 #include <QTextStream>
 #include <QFileInfo>
 #include <QDir>
 #include <QSettings>
+#include <QThread>
 
 #include <server.h>
 
+#include <project/core_csv.h>
+
 #include "server_dom.h"
 #include "server_project.h"
 #include "server_port.h"
@@ -72,6 +77,11 @@ QStringList mbServerBuilder::csvSimActionAttributes() const
         ;
 }
 
+QString mbServerBuilder::binaryProjectSuffix() const
+{
+    return QStringLiteral("mbsb");
+}
+
 mbCoreProject *mbServerBuilder::newProject() const
 {
     return new mbServerProject;
@@ -157,7 +167,16 @@ void mbServerBuilder::fillProject(mbCoreProject *obj, const mbCoreDomProject *do
     mbCoreBuilder::fillProject(obj, dom);
     mbServerProject *project = static_cast<mbServerProject*>(obj);
     setWorkingProjectCore(project);
-    project->simActionsAdd(toSimActions(static_cast<const mbServerDomProject*>(dom)->simActions()));
+    QThread *target = thread();
+    const QList<mbServerDomSimAction*> domSimActions = static_cast<const mbServerDomProject*>(dom)->simActions();
+    QVector<mbServerSimAction*> simActions(domSimActions.count());
+    mbServerSimAction **pSimActions = simActions.data();
+    materialize(QStringLiteral("Simulation"), simActions.count(), [&](int i) {
+        mbServerSimAction *v = toSimAction(domSimActions.at(i));
+        v->moveToThread(target);
+        pSimActions[i] = v;
+    });
+    project->simActionsAdd(simActions.toList());
     Q_FOREACH(mbServerDomScriptModule *d, static_cast<const mbServerDomProject*>(dom)->scriptModules())
         project->scriptModuleAdd(toScriptModule(d));
     setWorkingProjectCore(nullptr);
@@ -183,6 +202,11 @@ void mbServerBuilder::fillDevice(mbCoreDevice *obj, const mbCoreDomDevice *dom)
 {
     mbCoreBuilder::fillDevice(obj, dom);
     mbServerDevice *device = static_cast<mbServerDevice*>(obj);
+    if (static_cast<const mbServerDomDevice*>(dom)->data0x().hasRawData())
+    {
+        fillDeviceRawData(device, static_cast<const mbServerDomDevice*>(dom));
+        return;
+    }
     const mbServerDomDeviceData *data = &static_cast<const mbServerDomDevice*>(dom)->data0x();
     if (device->isSaveData())
         device->write_0x_bool(data->offset(), data->count(), reinterpret_cast<const bool*>(toBoolData(data->data()).constData()));
@@ -200,6 +224,39 @@ void mbServerBuilder::fillDevice(mbCoreDevice *obj, const mbCoreDomDevice *dom)
         device->write_4x(data->offset(), data->count(), reinterpret_cast<const quint16*>(toUInt16Data(data->data()).constData()));
 }
 
+void mbServerBuilder::fillDeviceRawData(mbServerDevice *device, const mbServerDomDevice *dom)
+{
+    if (!device->isSaveData())
+        return;
+    const mbServerDomDeviceData *data = &dom->data0x();
+    QByteArray raw = data->rawData();
+    if (raw.size() >= (data->count()+7)/8)
+        device->write_0x(data->offset(), data->count(), raw.constData());
+    else
+        mbServer::LogWarning(QStringLiteral("Builder"), QString("Device '%1' has corrupted 0x memory data").arg(device->name()));
+
+    data = &dom->data1x();
+    raw = data->rawData();
+    if (raw.size() >= (data->count()+7)/8)
+        device->write_1x(data->offset(), data->count(), raw.constData());
+    else
+        mbServer::LogWarning(QStringLiteral("Builder"), QString("Device '%1' has corrupted 1x memory data").arg(device->name()));
+
+    data = &dom->data3x();
+    raw = data->rawData();
+    if (raw.size() >= data->count()*MB_REGE_SZ_BYTES)
+        device->write_3x(data->offset(), data->count(), raw.constData());
+    else
+        mbServer::LogWarning(QStringLiteral("Builder"), QString("Device '%1' has corrupted 3x memory data").arg(device->name()));
+
+    data = &dom->data4x();
+    raw = data->rawData();
+    if (raw.size() >= data->count()*MB_REGE_SZ_BYTES)
+        device->write_4x(data->offset(), data->count(), raw.constData());
+    else
+        mbServer::LogWarning(QStringLiteral("Builder"), QString("Device '%1' has corrupted 4x memory data").arg(device->name()));
+}
+
 void mbServerBuilder::fillDomProject(mbCoreDomProject *dom, const mbCoreProject *obj)
 {
     mbCoreBuilder::fillDomProject(dom, obj);
@@ -241,7 +298,28 @@ void mbServerBuilder::fillDomDevice(mbCoreDomDevice *dom, const mbCoreDevice *ob
     // 4x
     mbServerDomDeviceData* data4x = &domDevice->data4x();
     data4x->setCount(static_cast<const mbServerDevice*>(obj)->count_4x());
-    if (static_cast<const mbServerDevice*>(obj)->isSaveData())
+    if (m_binary && static_cast<const mbServerDevice*>(obj)->isSaveData())
+    {
+        // Note: binary project keeps memory as is, see 'fillDeviceRawData'
+        const mbServerDevice *device = static_cast<const mbServerDevice*>(obj);
+        QByteArray v0x((device->count_0x()+7)/8, '\0');
+        device->read_0x(0, device->count_0x(), v0x.data());
+        data0x->setOffset(0);
+        data0x->setRawData(v0x);
+        QByteArray v1x((device->count_1x()+7)/8, '\0');
+        device->read_1x(0, device->count_1x(), v1x.data());
+        data1x->setOffset(0);
+        data1x->setRawData(v1x);
+        QByteArray v3x(device->count_3x()*MB_REGE_SZ_BYTES, '\0');
+        device->read_3x(0, device->count_3x(), v3x.data());
+        data3x->setOffset(0);
+        data3x->setRawData(v3x);
+        QByteArray v4x(device->count_4x()*MB_REGE_SZ_BYTES, '\0');
+        device->read_4x(0, device->count_4x(), v4x.data());
+        data4x->setOffset(0);
+        data4x->setRawData(v4x);
+    }
+    else if (static_cast<const mbServerDevice*>(obj)->isSaveData())
     {
         // 0x
         data0x->setOffset(0);
@@ -428,14 +506,15 @@ QList<mbServerSimAction *> mbServerBuilder::importSimActionsXml(QIODevice *io)
 QList<mbServerSimAction *> mbServerBuilder::importSimActionsCsv(QIODevice *io)
 {
     QList<mbServerSimAction *> items;
-    QString header = QString::fromUtf8(io->readLine());
-    QStringList attrNames = parseCsvRow(header);
-    if (attrNames.isEmpty())
+    mbCoreCsvReader reader(io, Strings::instance().csvSep.toLatin1());
+    QStringList attrNames;
+    if (!reader.readRow(attrNames) || reader.isEmptyRow())
         return items;
-    while (!io->atEnd())
+    QStringList row;
+    while (reader.readRow(row))
     {
-        QByteArray line = io->readLine();
-        QString row = QString::fromUtf8(line);
+        if (reader.isEmptyRow())
+            continue;
         MBSETTINGS settings = parseCsvRowItem(attrNames, row);
         if (settings.isEmpty())
             continue;
@@ -482,15 +561,14 @@ bool mbServerBuilder::exportSimActionsXml(QIODevice *io, const QList<mbServerSim
 bool mbServerBuilder::exportSimActionsCsv(QIODevice *io, const QList<mbServerSimAction *> &cfg)
 {
     QStringList lsHeader = csvSimActionAttributes();
-    QString sHeader = makeCsvRow(lsHeader);
-    io->write(sHeader.toUtf8());
+    mbCoreCsvWriter writer(io, Strings::instance().csvSep.toLatin1());
+    writer.writeRow(lsHeader);
     Q_FOREACH (const mbServerSimAction *item, cfg)
     {
         MBSETTINGS settings = toSettings(item);
-        QString sLine = makeCsvRowItem(lsHeader, settings);
-        io->write(sLine.toUtf8());
+        writer.writeRow(csvRowItem(lsHeader, settings));
     }
-    return true;;
+    return writer.flush();
 }
 
 mbServerScriptModule *mbServerBuilder::importScriptModule(const QString &file)
@@ -711,30 +789,47 @@ bool mbServerBuilder::importUInt16Data(const QString &file, QByteArray &data, co
     return false;
 }
 
+// Same result as 'QString::trimmed().toUShort()' but without conversion of the field to string
+static quint16 parseUInt16Field(const char *p, const char *end)
+{
+    while ((p < end) && isspace(static_cast<unsigned char>(*p)))
+        ++p;
+    while ((end > p) && isspace(static_cast<unsigned char>(end[-1])))
+        --end;
+    if (p < end && *p == '+')
+        ++p;
+    if (p == end)
+        return 0;
+    uint v = 0;
+    for (; p < end; ++p)
+    {
+        if ((*p < '0') || (*p > '9'))
+            return 0;
+        v = v * 10 + static_cast<uint>(*p - '0');
+        if (v > USHRT_MAX)
+            return 0;
+    }
+    return static_cast<quint16>(v);
+}
+
 bool mbServerBuilder::importUInt16Data(QIODevice *buff, QByteArray &data, const QChar &sep)
 {
-    QList<quint16> ls;
-    while (!buff->atEnd())
+    mbCoreCsvReader reader(buff, sep.toLatin1());
+    data.resize(0);
+    // Note: every value takes at least 2 bytes of text (digit and separator), so binary data is not larger than the file
+    if (!buff->isSequential())
+        data.reserve(static_cast<int>(qMin<qint64>(buff->size() - buff->pos(), MBTOOLS_MEMORY_MAX_COUNT * static_cast<int>(sizeof(quint16)))));
+    while (reader.readRow())
     {
-        QString line = QString::fromUtf8(buff->readLine());
-        int b = 0;
-        for (int i = 0; b < line.size();)
+        if (reader.isEmptyRow())
+            continue;
+        for (int i = 0; i < reader.fieldCount(); i++)
         {
-            for (;i < line.size() && line.at(i) != sep; i++) {}
-            QString v = line.mid(b, i-b).trimmed();
-            ls.append(v.toUShort());
-            i++;
-            b = i;
+            const char *f = reader.fieldData(i);
+            quint16 v = parseUInt16Field(f, f + reader.fieldSize(i));
+            data.append(reinterpret_cast<const char*>(&v), static_cast<int>(sizeof(v)));
         }
     }
-    data.resize(ls.size()*static_cast<int>(sizeof(quint16)));
-    quint16 *d = reinterpret_cast<quint16*>(data.data());
-    int i = 0;
-    Q_FOREACH (quint16 v, ls)
-    {
-        d[i] = v;
-        i++;
-    }
     return true;
 }
 
@@ -757,22 +852,17 @@ bool mbServerBuilder::exportUInt16Data(const QString &file, const QByteArray &da
 
 bool mbServerBuilder::exportUInt16Data(QIODevice *buff, const QByteArray &data, int columns, const QChar &sep)
 {
+    mbCoreCsvWriter writer(buff, sep.toLatin1());
     int c = data.size() / static_cast<int>(sizeof(quint16));
     const quint16* v = reinterpret_cast<const quint16*>(data.constData());
     for (int i = 0; i < c; i++)
     {
-        QByteArray line;
-        line.reserve(columns*2-1);
         for (int j = 0; (i < (c-1)) && (j < (columns-1)); i++, j++)
-        {
-            line.append(QByteArray::number(v[i]));
-            line.append(sep.toLatin1());
-        }
-        line.append(QByteArray::number(v[i]));
-        line.append('\n');
-        buff->write(line);
+            writer.writeField(QByteArray::number(v[i]));
+        writer.writeField(QByteArray::number(v[i]));
+        writer.endRow();
     }
-    return true;
+    return writer.flush();
 }
 
 void mbServerBuilder::importDomProject(mbCoreDomProject *dom)
@@ -75,6 +75,7 @@ public:
     QStringList csvSimActionAttributes() const;
 
 public: // 'mbCoreBuilder'-interface
+    QString binaryProjectSuffix() const override;
     mbCoreProject         *newProject        () const override;
     mbCorePort            *newPort           () const override;
     mbCoreDevice          *newDevice         () const override;
@@ -162,6 +163,7 @@ public:
 
 private:
     void importDomProject(mbCoreDomProject *dom) override;
+    void fillDeviceRawData(mbServerDevice *device, const mbServerDomDevice *dom);
     BoolData_t toBoolData(const QString &str, int reserve = MBTOOLS_MEMORY_MAX_COUNT);
     UInt16Data_t toUInt16Data(const QString &str, int reserve = MBTOOLS_MEMORY_MAX_COUNT);
     QString fromBoolData(const BoolData_t &data);
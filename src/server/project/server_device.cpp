@@ -30,6 +30,9 @@
 
 #include <QSet>
 
+#include <mbcore_binaryreader.h>
+#include <mbcore_binarywriter.h>
+
 #include <project/server_project.h>
 #include <project/server_port.h>
 
@@ -95,6 +98,7 @@ void mbServerDevice::MemoryBlock::resize(int bytes)
     m_data.resize(bytes);
     memset(m_data.data(), 0, m_data.size());
     m_sizeBits = m_data.size() * MB_BYTE_SZ_BITES;
+    m_pageCounters.fill(m_changeCounter, (m_data.size() + PageSizeBytes - 1) / PageSizeBytes);
 }
 
 void mbServerDevice::MemoryBlock::resizeBits(int bits)
@@ -103,6 +107,38 @@ void mbServerDevice::MemoryBlock::resizeBits(int bits)
     m_data.resize((bits+7)/8);
     memset(m_data.data(), 0, m_data.size());
     m_sizeBits = bits;
+    m_pageCounters.fill(m_changeCounter, (m_data.size() + PageSizeBytes - 1) / PageSizeBytes);
+}
+
+bool mbServerDevice::MemoryBlock::isChangedSince(uint changeCounter, uint byteOffset, uint byteCount) const
+{
+    QReadLocker _(&m_lock);
+    if (m_changeCounter == changeCounter)
+        return false;
+    uint pageCount = static_cast<uint>(m_pageCounters.count());
+    uint first = byteOffset / PageSizeBytes;
+    uint last = (byteOffset + byteCount + PageSizeBytes - 1) / PageSizeBytes;
+    if (last > pageCount)
+        last = pageCount;
+    for (uint i = first; i < last; i++)
+    {
+        // Note: difference is used instead of direct comparison to handle counter overflow
+        if (static_cast<int>(m_pageCounters.at(i) - changeCounter) > 0)
+            return true;
+    }
+    return false;
+}
+
+void mbServerDevice::MemoryBlock::setChanged(uint byteOffset, uint byteCount)
+{
+    m_changeCounter++;
+    uint pageCount = static_cast<uint>(m_pageCounters.count());
+    uint first = byteOffset / PageSizeBytes;
+    uint last = (byteOffset + byteCount + PageSizeBytes - 1) / PageSizeBytes;
+    if (last > pageCount)
+        last = pageCount;
+    for (uint i = first; i < last; i++)
+        m_pageCounters[i] = m_changeCounter;
 }
 
 void mbServerDevice::MemoryBlock::memGet(uint byteOffset, void *buff, size_t size)
@@ -122,6 +158,7 @@ void mbServerDevice::MemoryBlock::memSetMask(uint byteOffset, const void *buff,
         return;
     if ((byteOffset + size) > m_data.size())
         n = m_data.size() - byteOffset;
+    setChanged(byteOffset, static_cast<uint>(n));
 
     quint8 *membyte = reinterpret_cast<quint8*>(m_data.data())+byteOffset;
     const quint8 *bufbyte = reinterpret_cast<const quint8*>(buff);
@@ -164,14 +201,12 @@ void mbServerDevice::MemoryBlock::memSetMask(uint byteOffset, const void *buff,
         ++bufbyte;
         --n;
     }
-
-    m_changeCounter++;
 }
 
 void mbServerDevice::MemoryBlock::zerroAll()
 {
     QWriteLocker _(&m_lock);
-    m_changeCounter++;
+    setChanged(0, static_cast<uint>(m_data.size()));
     memset(m_data.data(), 0, m_data.size());
 }
 
@@ -206,7 +241,7 @@ Modbus::StatusCode mbServerDevice::MemoryBlock::write(uint offset, uint count, c
     if (c == 0)
         return Modbus::Status_BadIllegalDataAddress;
     memcpy(m_data.data()+offset, buff, c);
-    m_changeCounter++;
+    setChanged(offset, c);
     if (fact)
         *fact = c;
     return Modbus::Status_Good;
@@ -325,7 +360,7 @@ Modbus::StatusCode mbServerDevice::MemoryBlock::writeBits(uint bitOffset, uint b
             mem[byteOffset+bytes] |= (reinterpret_cast<const quint8*>(buff)[bytes] & mask);
         }
     }
-    m_changeCounter++;
+    setChanged(byteOffset, (shift + c + MB_BYTE_SZ_BITES - 1) / MB_BYTE_SZ_BITES);
     if (fact)
         *fact = c;
     return Modbus::Status_Good;
@@ -381,7 +416,7 @@ Modbus::StatusCode mbServerDevice::MemoryBlock::writeBools(uint bitOffset, uint
         }
         bit = 0;
     }
-    m_changeCounter++;
+    setChanged(byte, (bitOffset % MB_BYTE_SZ_BITES + c + MB_BYTE_SZ_BITES - 1) / MB_BYTE_SZ_BITES);
     if (fact)
         *fact = c;
     return Modbus::Status_Good;
@@ -663,6 +698,60 @@ bool mbServerDevice::setSettings(const Modbus::Settings &settings)
     return true;
 }
 
+void mbServerDevice::writeRecord(mbCoreBinaryWriter &writer) const
+{
+    mbCoreDevice::writeRecord(writer);
+    writer.write(count_0x());
+    writer.write(count_1x());
+    writer.write(count_3x());
+    writer.write(count_4x());
+    writer.write(static_cast<int>(isSaveData()));
+    writer.write(static_cast<int>(isReadOnly()));
+    writer.write(exceptionStatusAddressInt());
+    writer.write(static_cast<int>(delay()));
+    writer.write(static_cast<int>(isEnableScript()));
+    writer.write(scriptInit());
+    writer.write(scriptLoop());
+    writer.write(scriptFinal());
+}
+
+bool mbServerDevice::readRecord(mbCoreBinaryReader &reader)
+{
+    QWriteLocker _(&m_lock);
+
+    int count0x, count1x, count3x, count4x, isSaveData, isReadOnly, exceptionStatusAddress, delay, isEnableScript;
+    QString scriptInit, scriptLoop, scriptFinal;
+    if (!(mbCoreDevice::readRecord(reader)    && // Q_EMIT changed() within
+          reader.read(count0x)                &&
+          reader.read(count1x)                &&
+          reader.read(count3x)                &&
+          reader.read(count4x)                &&
+          reader.read(isSaveData)             &&
+          reader.read(isReadOnly)             &&
+          reader.read(exceptionStatusAddress) &&
+          reader.read(delay)                  &&
+          reader.read(isEnableScript)         &&
+          reader.read(scriptInit)             &&
+          reader.read(scriptLoop)             &&
+          reader.read(scriptFinal)))
+        return false;
+    if ((count0x < 0) || (count1x < 0) || (count3x < 0) || (count4x < 0))
+        return false;
+    realloc_0x(count0x);
+    realloc_1x(count1x);
+    realloc_3x(count3x);
+    realloc_4x(count4x);
+    setSaveData(isSaveData != 0);
+    setReadOnly(isReadOnly != 0);
+    setExceptionStatusAddressInt(exceptionStatusAddress);
+    setDelay(static_cast<uint>(delay));
+    setEnableScript(isEnableScript != 0);
+    setScriptInit(scriptInit);
+    setScriptLoop(scriptLoop);
+    setScriptFinal(scriptFinal);
+    return true;
+}
+
 QByteArray mbServerDevice::readData(const mb::Address &address, quint16 count)
 {
     QByteArray v;
@@ -698,6 +787,32 @@ QByteArray mbServerDevice::readData(const mb::Address &address, quint16 count)
     return v;
 }
 
+uint mbServerDevice::changeCounter(Modbus::MemoryType memoryType) const
+{
+    switch (memoryType)
+    {
+    case Modbus::Memory_0x: return changeCounter_0x();
+    case Modbus::Memory_1x: return changeCounter_1x();
+    case Modbus::Memory_3x: return changeCounter_3x();
+    case Modbus::Memory_4x: return changeCounter_4x();
+    default:
+        return 0;
+    }
+}
+
+bool mbServerDevice::isChangedSince(uint changeCounter, const mb::Address &address, quint16 count) const
+{
+    switch (address.type())
+    {
+    case Modbus::Memory_0x: return isChangedSince_0x(changeCounter, address.offset(), count);
+    case Modbus::Memory_1x: return isChangedSince_1x(changeCounter, address.offset(), count);
+    case Modbus::Memory_3x: return isChangedSince_3x(changeCounter, address.offset(), count);
+    case Modbus::Memory_4x: return isChangedSince_4x(changeCounter, address.offset(), count);
+    default:
+        return false;
+    }
+}
+
 void mbServerDevice::writeData(const mb::Address &address, quint16 count, const QByteArray &data)
 {
     switch (address.type())
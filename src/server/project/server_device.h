@@ -85,6 +85,10 @@ public: // statistics
 public: // memory block
     class MemoryBlock
     {
+    public:
+        // Note: memory is divided into pages, every page keeps value of 'changeCounter' of its last change
+        enum { PageSizeBytes = 16 };
+
     public:
         MemoryBlock();
 
@@ -102,6 +106,9 @@ public: // memory block
 
     public:
         inline uint changeCounter() const { QReadLocker _(&m_lock); return m_changeCounter; }
+        bool isChangedSince(uint changeCounter, uint byteOffset, uint byteCount) const;
+        inline bool isChangedSinceBits(uint changeCounter, uint bitOffset, uint bitCount) const { return isChangedSince(changeCounter, bitOffset / MB_BYTE_SZ_BITES, (bitOffset % MB_BYTE_SZ_BITES + bitCount + MB_BYTE_SZ_BITES - 1) / MB_BYTE_SZ_BITES); }
+        inline bool isChangedSinceRegs(uint changeCounter, uint regOffset, uint regCount) const { return isChangedSince(changeCounter, regOffset * MB_REGE_SZ_BYTES, regCount * MB_REGE_SZ_BYTES); }
         void zerroAll();
         Modbus::StatusCode read(uint offset, uint count, void *values, uint *fact = nullptr) const;
         Modbus::StatusCode write(uint offset, uint count, const void *values, uint *fact = nullptr);
@@ -116,11 +123,15 @@ public: // memory block
         Modbus::StatusCode readFrameRegs(uint regOffset, int columns, QByteArray &values, int maxColumns) const;
         Modbus::StatusCode writeFrameRegs(uint regOffset, int columns, const QByteArray &values, int maxColumns);
 
+    private:
+        void setChanged(uint byteOffset, uint byteCount);
+
     private:
         mutable QReadWriteLock m_lock;
         QByteArray m_data;
         uint m_sizeBits;
         uint m_changeCounter;
+        QVector<uint> m_pageCounters;
     };
 
     enum ScriptType
@@ -182,8 +193,13 @@ public: // settings
     Modbus::Settings settings() const;
     bool setSettings(const Modbus::Settings& settings);
 
+    void writeRecord(mbCoreBinaryWriter &writer) const override;
+    bool readRecord(mbCoreBinaryReader &reader) override;
+
 public:
     QByteArray readData(const mb::Address &address, quint16 count);
+    uint changeCounter(Modbus::MemoryType memoryType) const;
+    bool isChangedSince(uint changeCounter, const mb::Address &address, quint16 count) const;
     void writeData(const mb::Address &address, quint16 count, const QByteArray &data);
 
 public: // 'Modbus'-like Interface
@@ -231,6 +247,7 @@ private:
 
 public: // memory-0x management functions
     inline uint changeCounter_0x() const { return m_mem_0x.changeCounter(); }
+    inline bool isChangedSince_0x(uint changeCounter, uint bitOffset, uint bitCount) const { return m_mem_0x.isChangedSinceBits(changeCounter, bitOffset, bitCount); }
     inline int count_0x() const { return m_mem_0x.sizeBits(); }
     inline int count_0x_bites() const { return m_mem_0x.sizeBits(); }
     inline int count_0x_bytes() const { return m_mem_0x.sizeBytes(); }
@@ -278,6 +295,7 @@ public: // memory-0x management functions
 
 public: // memory-1x management functions
     inline uint changeCounter_1x() const { return m_mem_1x.changeCounter(); }
+    inline bool isChangedSince_1x(uint changeCounter, uint bitOffset, uint bitCount) const { return m_mem_1x.isChangedSinceBits(changeCounter, bitOffset, bitCount); }
     inline int count_1x() const { return m_mem_1x.sizeBits(); }
     inline int count_1x_bites() const { return m_mem_1x.sizeBits(); }
     inline int count_1x_bytes() const { return m_mem_1x.sizeBytes(); }
@@ -325,6 +343,7 @@ public: // memory-1x management functions
 
 public: // memory-3x management functions
     inline uint changeCounter_3x() const { return m_mem_3x.changeCounter(); }
+    inline bool isChangedSince_3x(uint changeCounter, uint regOffset, uint regCount) const { return m_mem_3x.isChangedSinceRegs(changeCounter, regOffset, regCount); }
     inline int count_3x() const { return m_mem_3x.sizeRegs(); }
     inline int count_3x_bites() const { return m_mem_3x.sizeBits(); }
     inline int count_3x_bytes() const { return m_mem_3x.sizeBytes(); }
@@ -370,6 +389,7 @@ public: // memory-3x management functions
 
 public: // memory-4x management functions
     inline uint changeCounter_4x() const { return m_mem_4x.changeCounter(); }
+    inline bool isChangedSince_4x(uint changeCounter, uint regOffset, uint regCount) const { return m_mem_4x.isChangedSinceRegs(changeCounter, regOffset, regCount); }
     inline int count_4x() const { return m_mem_4x.sizeRegs(); }
     inline int count_4x_bites() const { return m_mem_4x.sizeBits(); }
     inline int count_4x_bytes() const { return m_mem_4x.sizeBytes(); }
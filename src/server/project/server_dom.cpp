@@ -157,6 +157,34 @@ void mbServerDomSimAction::write(mbCoreXmlStreamWriter &writer, const QString &t
     writer.writeEndElement();
 }
 
+void mbServerDomSimAction::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_device         = reader.readString();
+    m_address        = reader.readString();
+    m_data_type      = reader.readString();
+    m_period         = reader.readInt   ();
+    m_comment        = reader.readString();
+    m_actionType     = reader.readString();
+    m_extended       = reader.readString();
+    m_byte_order     = reader.readString();
+    m_register_order = reader.readString();
+    m_text           = reader.readString();
+}
+
+void mbServerDomSimAction::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeString(m_device        );
+    writer.writeString(m_address       );
+    writer.writeString(m_data_type     );
+    writer.writeInt   (m_period        );
+    writer.writeString(m_comment       );
+    writer.writeString(m_actionType    );
+    writer.writeString(m_extended      );
+    writer.writeString(m_byte_order    );
+    writer.writeString(m_register_order);
+    writer.writeString(m_text          );
+}
+
 // -----------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------- SCRIPT MODULE ----------------------------------------------------
 // -----------------------------------------------------------------------------------------------------------------------
@@ -233,6 +261,18 @@ void mbServerDomScriptModule::write(mbCoreXmlStreamWriter &writer, const QString
     writer.writeEndElement();
 }
 
+void mbServerDomScriptModule::readBinary(mbCoreDomBinaryReader &reader)
+{
+    setSettings(reader.readSettings());
+    m_text = reader.readString();
+}
+
+void mbServerDomScriptModule::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeSettings(m_settings);
+    writer.writeString(m_text);
+}
+
 void mbServerDomScriptModule::setSettings(const MBSETTINGS &settings)
 {
     auto it = settings.find(mbServerScriptModule::Strings::instance().name);
@@ -277,6 +317,7 @@ mbServerDomDeviceData::mbServerDomDeviceData()
     m_has_attr_count = false;
     m_has_attr_offset = false;
     m_has_data = false;
+    m_has_raw = false;
 }
 
 mbServerDomDeviceData::~mbServerDomDeviceData()
@@ -338,6 +379,38 @@ void mbServerDomDeviceData::write(mbCoreXmlStreamWriter &writer, const QString &
     writer.writeEndElement();
 }
 
+void mbServerDomDeviceData::readBinary(mbCoreDomBinaryReader &reader)
+{
+    int flags = reader.readInt();
+    m_attr_count      = reader.readInt();
+    m_attr_offset     = static_cast<quint16>(reader.readInt());
+    m_has_attr_count  = (flags & 0x01) != 0;
+    m_has_attr_offset = (flags & 0x02) != 0;
+    m_has_data        = (flags & 0x04) != 0;
+    m_has_raw         = (flags & 0x08) != 0;
+    // Note: memory data is not a subject to deduplicate, so it's stored inline.
+    // Raw memory is stored as is, so it's not parsed on open like xml text
+    if (m_has_raw)
+        m_raw = reader.readData();
+    else
+        m_text = QString::fromUtf8(reader.readData());
+}
+
+void mbServerDomDeviceData::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    int flags = (m_has_attr_count  ? 0x01 : 0) |
+                (m_has_attr_offset ? 0x02 : 0) |
+                (m_has_data        ? 0x04 : 0) |
+                (m_has_raw         ? 0x08 : 0);
+    writer.writeInt(flags);
+    writer.writeInt(m_attr_count);
+    writer.writeInt(m_attr_offset);
+    if (m_has_raw)
+        writer.writeData(m_raw);
+    else
+        writer.writeData(m_text.toUtf8());
+}
+
 mbServerDomDevice::Strings::Strings() : mbCoreDomDevice::Strings(),
     data0x(QStringLiteral("data0x")),
     data1x(QStringLiteral("data1x")),
@@ -388,6 +461,24 @@ void mbServerDomDevice::writeElements(mbCoreXmlStreamWriter &writer) const
         m_data4x.write(writer, s.data4x);
 }
 
+void mbServerDomDevice::readBinaryElements(mbCoreDomBinaryReader &reader)
+{
+    mbCoreDomDevice::readBinaryElements(reader);
+    m_data0x.readBinary(reader);
+    m_data1x.readBinary(reader);
+    m_data3x.readBinary(reader);
+    m_data4x.readBinary(reader);
+}
+
+void mbServerDomDevice::writeBinaryElements(mbCoreDomBinaryWriter &writer) const
+{
+    mbCoreDomDevice::writeBinaryElements(writer);
+    m_data0x.writeBinary(writer);
+    m_data1x.writeBinary(writer);
+    m_data3x.writeBinary(writer);
+    m_data4x.writeBinary(writer);
+}
+
 // -----------------------------------------------------------------------------------------------------------------------
 // ------------------------------------------------------ DEVICEREF ------------------------------------------------------
 // -----------------------------------------------------------------------------------------------------------------------
@@ -462,6 +553,18 @@ void mbServerDomDeviceRef::write(mbCoreXmlStreamWriter &writer, const QString &t
     writer.writeEndElement();
 }
 
+void mbServerDomDeviceRef::readBinary(mbCoreDomBinaryReader &reader)
+{
+    m_attr_name = reader.readString();
+    m_text = reader.readString();
+}
+
+void mbServerDomDeviceRef::writeBinary(mbCoreDomBinaryWriter &writer) const
+{
+    writer.writeString(m_attr_name);
+    writer.writeString(m_text);
+}
+
 // -----------------------------------------------------------------------------------------------------------------------
 // --------------------------------------------------------- PORT --------------------------------------------------------
 // -----------------------------------------------------------------------------------------------------------------------
@@ -505,6 +608,18 @@ void mbServerDomPort::writeElements(mbCoreXmlStreamWriter &writer) const
     m_devices->write(writer, sDeviceRef.tagName);
 }
 
+void mbServerDomPort::readBinaryElements(mbCoreDomBinaryReader &reader)
+{
+    mbCoreDomPort::readBinaryElements(reader);
+    m_devices->readBinary(reader);
+}
+
+void mbServerDomPort::writeBinaryElements(mbCoreDomBinaryWriter &writer) const
+{
+    mbCoreDomPort::writeBinaryElements(writer);
+    m_devices->writeBinary(writer);
+}
+
 // -----------------------------------------------------------------------------------------------------------------------
 // ------------------------------------------------------- PROJECT -------------------------------------------------------
 // -----------------------------------------------------------------------------------------------------------------------
@@ -546,3 +661,17 @@ void mbServerDomProject::writeElements(mbCoreXmlStreamWriter &writer) const
         m_scriptModules->write(writer);
 }
 
+void mbServerDomProject::readBinaryElements(mbCoreDomBinaryReader &reader)
+{
+    mbCoreDomProject::readBinaryElements(reader);
+    m_simActions->readBinary(reader);
+    m_scriptModules->readBinary(reader);
+}
+
+void mbServerDomProject::writeBinaryElements(mbCoreDomBinaryWriter &writer) const
+{
+    mbCoreDomProject::writeBinaryElements(writer);
+    m_simActions->writeBinary(writer);
+    m_scriptModules->writeBinary(writer);
+}
+
@@ -56,6 +56,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // elements
     inline QString device() const { return m_device; }
@@ -126,6 +128,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // elements
     QString name() const { return m_name; }
@@ -187,6 +191,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // attributes
     inline int count() const { return m_attr_count; }
@@ -206,6 +212,11 @@ public:
     inline bool hasData() const { return m_has_data; }
     inline void clearData() { m_has_data = false; }
 
+    // raw memory of binary project: packed bits for 0x/1x, registers for 3x/4x
+    inline QByteArray rawData() const { return m_raw; }
+    inline void setRawData(const QByteArray &raw) { m_raw = raw; m_has_raw = true; }
+    inline bool hasRawData() const { return m_has_raw; }
+
 private:
     // attributes
     int m_attr_count;
@@ -217,6 +228,9 @@ private:
     // child element data
     bool m_has_data;
 
+    QByteArray m_raw;
+    bool m_has_raw;
+
     mbServerDomDeviceData(const mbServerDomDeviceData& other);
     void operator = (const mbServerDomDeviceData& other);
 };
@@ -261,6 +275,8 @@ public:
 protected:
     bool readElement(mbCoreXmlStreamReader &reader, const QString &tag) override;
     void writeElements(mbCoreXmlStreamWriter &writer) const override;
+    void readBinaryElements(mbCoreDomBinaryReader &reader) override;
+    void writeBinaryElements(mbCoreDomBinaryWriter &writer) const override;
 
 private:
     mbServerDomDeviceData m_data0x;
@@ -296,6 +312,8 @@ public:
     QString tagName() const override { return Strings::instance().tagName; }
     void read(mbCoreXmlStreamReader &reader) override;
     void write(mbCoreXmlStreamWriter &writer, const QString &tagName = QString()) const override;
+    void readBinary(mbCoreDomBinaryReader &reader) override;
+    void writeBinary(mbCoreDomBinaryWriter &writer) const override;
 
     // attributes
     inline QString name() const { return m_attr_name; }
@@ -339,6 +357,8 @@ public:
 protected:
     bool readElement(mbCoreXmlStreamReader &reader, const QString &tag) override;
     void writeElements(mbCoreXmlStreamWriter &writer) const override;
+    void readBinaryElements(mbCoreDomBinaryReader &reader) override;
+    void writeBinaryElements(mbCoreDomBinaryWriter &writer) const override;
 
 protected:
     mbServerDomDeviceRefs *m_devices;
@@ -390,6 +410,8 @@ public:
 protected:
     bool readElement(mbCoreXmlStreamReader &reader, const QString &tag) override;
     void writeElements(mbCoreXmlStreamWriter &writer) const override;
+    void readBinaryElements(mbCoreDomBinaryReader &reader) override;
+    void writeBinaryElements(mbCoreDomBinaryWriter &writer) const override;
 
 private:
     mbServerDomSimActions *m_simActions;